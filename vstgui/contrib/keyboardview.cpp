@@ -1071,7 +1071,7 @@ static const std::string kAttrNumKeys = "num-keys";
 static const std::string kAttrNoteNameFont = "note-name-font";
 static const std::string kAttrDrawNoteText = "draw-note-text";
 
-using UIViewCreator::stringToColor;
+using UIViewCreator::getColorAttribute;
 using UIViewCreator::stringToBitmap;
 using UIViewCreator::bitmapToString;
 using UIViewCreator::colorToString;
@@ -1254,19 +1254,17 @@ public:
 			kv->setBitmap (ViewType::BitmapID::WhiteKeyShadowRight, bitmap);
 
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (UIViewCreator::kAttrFrameColor), color,
-		                   desc))
+		if (getColorAttribute (attributes, UIViewCreator::kAttrFrameColor, color, desc))
 			kv->setFrameColor (color);
-		if (stringToColor (attributes.getAttributeValue (UIViewCreator::kAttrFontColor), color,
-		                   desc))
+		if (getColorAttribute (attributes, UIViewCreator::kAttrFontColor, color, desc))
 			kv->setFontColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrWhiteKeyColor), color, desc))
+		if (getColorAttribute (attributes, kAttrWhiteKeyColor, color, desc))
 			kv->setWhiteKeyColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrWhiteKeyPressedColor), color, desc))
+		if (getColorAttribute (attributes, kAttrWhiteKeyPressedColor, color, desc))
 			kv->setWhiteKeyPressedColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrBlackKeyColor), color, desc))
+		if (getColorAttribute (attributes, kAttrBlackKeyColor, color, desc))
 			kv->setBlackKeyColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrBlackKeyPressedColor), color, desc))
+		if (getColorAttribute (attributes, kAttrBlackKeyPressedColor, color, desc))
 			kv->setBlackKeyPressedColor (color);
 
 		CCoord c;
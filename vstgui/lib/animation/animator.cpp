@@ -11,6 +11,8 @@ The source can be found under /lib/animation/
 
 @section the_animator The Animator
 Every @link VSTGUI::CFrame::getAnimator CFrame @endlink object can have one @link VSTGUI::Animation::Animator Animator @endlink object which runs animations at 60 Hz.
+The animation time follows the frames painted by the CFrame, so that every painted frame shows the animation one frame interval further.
+The animation timer only runs while animations are active.
 
 The animator is responsible for running animations.
 You can add and remove animations.
@@ -94,9 +96,10 @@ public:
 #include "itimingfunction.h"
 #include "../cvstguitimer.h"
 #include "../cview.h"
-#include "../dispatchlist.h"
 #include "../platform/iplatformframe.h"
-#include <list>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #define DEBUG_LOG	0 // DEBUG
 
@@ -112,7 +115,14 @@ class Timer : public NonAtomicReferenceCounted
 public:
 	static void addAnimator (Animator* animator)
 	{
-		getInstance ()->animators.emplace_back (animator);
+		auto instance = getInstance ();
+		auto it = std::find (instance->toRemove.begin (), instance->toRemove.end (), animator);
+		if (it != instance->toRemove.end ())
+		{
+			instance->toRemove.erase (it);
+			return;
+		}
+		instance->animators.emplace_back (animator);
 #if DEBUG_LOG
 		DebugPrint ("Animator added: %p\n", animator);
 #endif
@@ -130,8 +140,10 @@ public:
 #if DEBUG_LOG
 				DebugPrint ("Animator removed: %p\n", animator);
 #endif
-				gInstance->animators.remove (animator);
-				if (gInstance->animators.empty ())
+				auto& animators = gInstance->animators;
+				animators.erase (std::remove (animators.begin (), animators.end (), animator),
+								 animators.end ());
+				if (animators.empty ())
 				{
 					gInstance->forget ();
 					gInstance = nullptr;
@@ -175,17 +187,23 @@ protected:
 #if DEBUG_LOG
 		DebugPrint ("Current Animators : %d\n", animators.size ());
 #endif
-		for (auto& animator : animators)
-			animator->onTimer ();
+		// animators may be added while iterating
+		for (size_t i = 0; i < animators.size (); ++i)
+		{
+			auto animator = animators[i];
+			if (std::find (toRemove.begin (), toRemove.end (), animator) == toRemove.end ())
+				animator->onTimer ();
+		}
 		inTimer = false;
-		for (auto& animator : toRemove)
-			removeAnimator (animator);
+		auto removed = std::move (toRemove);
 		toRemove.clear ();
+		for (auto& animator : removed)
+			removeAnimator (animator);
 	}
 
 	CVSTGUITimer* timer;
 	
-	using Animators = std::list<Animator*>;
+	using Animators = std::vector<Animator*>;
 	Animators animators;
 	Animators toRemove;
 	bool inTimer;
@@ -193,6 +211,49 @@ protected:
 };
 Timer* Timer::gInstance = nullptr;
 
+//-----------------------------------------------------------------------------
+/** predicts when the next frame will be presented from the frames painted before */
+class FrameClock
+{
+public:
+	void presented (uint32_t timestamp)
+	{
+		if (hasPresentation)
+		{
+			auto delta = static_cast<double> (timestamp - lastPresentation);
+			// the frame reports every dirty rect it paints, the rects of one paint pass are
+			// reported within a few milliseconds and belong to the same frame
+			if (delta < kMinFrameInterval)
+				return;
+			if (delta <= kMaxFrameInterval)
+				interval = interval * 0.75 + delta * 0.25;
+		}
+		lastPresentation = timestamp;
+		hasPresentation = true;
+	}
+
+	uint32_t nextPresentation (uint32_t now) const
+	{
+		if (!hasPresentation)
+			return now;
+		auto elapsed = static_cast<int32_t> (now - lastPresentation);
+		// without recent frames the animation runs on the timer
+		if (elapsed < 0 || elapsed > kMaxPrediction)
+			return now;
+		auto frames = std::max (1., std::ceil (elapsed / interval));
+		return lastPresentation + static_cast<uint32_t> (frames * interval + 0.5);
+	}
+
+private:
+	static constexpr double kMinFrameInterval = 4.;
+	static constexpr double kMaxFrameInterval = 100.;
+	static constexpr int32_t kMaxPrediction = 250;
+
+	double interval {1000. / 60.};
+	uint32_t lastPresentation {0};
+	bool hasPresentation {false};
+};
+
 //-----------------------------------------------------------------------------
 class Animation : public NonAtomicReferenceCounted
 {
@@ -205,8 +266,6 @@ public:
 	IAnimationTarget* animationTarget;
 	ITimingFunction* timingFunction;
 	DoneFunction notification;
-	uint32_t startTime;
-	float lastPos;
 	bool done;
 };
 
@@ -217,8 +276,6 @@ Animation::Animation (CView* view, const std::string& name, IAnimationTarget* at
 , animationTarget (at)
 , timingFunction (t)
 , notification (std::move (notification))
-, startTime (0)
-, lastPos (-1)
 , done (false)
 {
 }
@@ -243,7 +300,77 @@ Animation::~Animation () noexcept
 //-----------------------------------------------------------------------------
 struct Animator::Impl
 {
-	DispatchList<SharedPointer<Detail::Animation>> animations;
+	/** the per frame state of an animation, kept in one contiguous array so that the timing
+	 *	functions of all animations are evaluated in one pass before any target is called */
+	struct Record
+	{
+		explicit Record (SharedPointer<Detail::Animation>&& animation)
+		: animation (std::move (animation)) {}
+
+		SharedPointer<Detail::Animation> animation;
+		uint32_t startTime {0};
+		float pos {0.f};
+		float lastPos {-1.f};
+		bool started {false};
+		bool finished {false};
+		bool removed {false};
+	};
+	using Records = std::vector<Record>;
+
+	Records records;
+	Records added; // animations added while advancing
+	Detail::FrameClock clock;
+	uint32_t lastAdvanceTime {0};
+	bool advanced {false};
+	bool inAdvance {false};
+	bool registered {false};
+	bool needsCompact {false};
+
+	template<typename Proc>
+	void forEachActive (Proc proc)
+	{
+		// records may not be referenced after proc, as it may call into the target
+		for (size_t i = 0; i < records.size (); ++i)
+		{
+			if (!records[i].removed)
+				proc (records[i]);
+		}
+		for (size_t i = 0; i < added.size (); ++i)
+		{
+			if (!added[i].removed)
+				proc (added[i]);
+		}
+	}
+
+	void compact ()
+	{
+		needsCompact = false;
+		// removed animations are destroyed at the end, their notification may add animations
+		Records removed;
+		size_t count = 0;
+		for (size_t i = 0; i < records.size (); ++i)
+		{
+			if (records[i].removed)
+				removed.emplace_back (std::move (records[i]));
+			else
+			{
+				if (count != i)
+					records[count] = std::move (records[i]);
+				++count;
+			}
+		}
+		records.erase (records.begin () + static_cast<std::ptrdiff_t> (count), records.end ());
+		for (auto& record : added)
+		{
+			if (record.removed)
+				removed.emplace_back (std::move (record));
+			else
+				records.emplace_back (std::move (record));
+		}
+		added.clear ();
+	}
+
+	bool empty () const { return records.empty () && added.empty (); }
 };
 ///@endcond
 
@@ -256,16 +383,24 @@ Animator::Animator ()
 //-----------------------------------------------------------------------------
 Animator::~Animator () noexcept
 {
-	Detail::Timer::removeAnimator (this);
+	if (pImpl->registered)
+		Detail::Timer::removeAnimator (this);
 }
 
 //-----------------------------------------------------------------------------
 void Animator::addAnimation (CView* view, IdStringPtr name, IAnimationTarget* target, ITimingFunction* timingFunction, DoneFunction notification)
 {
-	if (pImpl->animations.empty ())
-		Detail::Timer::addAnimator (this);
 	removeAnimation (view, name);
-	pImpl->animations.add (makeOwned<Detail::Animation> (view, name, target, timingFunction, std::move (notification)));
+	if (!pImpl->registered)
+	{
+		Detail::Timer::addAnimator (this);
+		pImpl->registered = true;
+	}
+	Impl::Record record (makeOwned<Detail::Animation> (view, name, target, timingFunction, std::move (notification)));
+	if (pImpl->inAdvance)
+		pImpl->added.emplace_back (std::move (record));
+	else
+		pImpl->records.emplace_back (std::move (record));
 #if DEBUG_LOG
 	DebugPrint ("new animation added: %p - %s\n", view, name);
 #endif
@@ -289,74 +424,144 @@ void Animator::addAnimation (CView* view, IdStringPtr name, IAnimationTarget* ta
 //-----------------------------------------------------------------------------
 void Animator::removeAnimation (CView* view, IdStringPtr name)
 {
-	pImpl->animations.forEach ([&] (const SharedPointer<Detail::Animation>& animation) {
+	auto selfGuard = shared (this);
+	pImpl->forEachActive ([&] (Impl::Record& record) {
+		auto animation = record.animation;
 		if (animation->view == view && animation->name == name)
 		{
 #if DEBUG_LOG
 			DebugPrint ("animation removed: %p - %s\n", view, name);
 #endif
+			record.removed = true;
+			pImpl->needsCompact = true;
 			if (animation->done == false)
 			{
 				animation->done = true;
 				animation->animationTarget->animationFinished (view, name, true);
 			}
-			pImpl->animations.remove (animation);
 		}
 	});
+	if (!pImpl->inAdvance && pImpl->needsCompact)
+	{
+		pImpl->compact ();
+		if (pImpl->empty () && pImpl->registered)
+		{
+			pImpl->registered = false;
+			Detail::Timer::removeAnimator (this);
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
 void Animator::removeAnimations (CView* view)
 {
-	pImpl->animations.forEach ([&] (const SharedPointer<Detail::Animation>& animation) {
+	auto selfGuard = shared (this);
+	pImpl->forEachActive ([&] (Impl::Record& record) {
+		auto animation = record.animation;
 		if (animation->view == view)
 		{
 #if DEBUG_LOG
 			DebugPrint ("animation removed: %p - %s\n", view, animation->name.data ());
 #endif
+			record.removed = true;
+			pImpl->needsCompact = true;
 			if (animation->done == false)
 			{
 				animation->done = true;
 				animation->animationTarget->animationFinished (view, animation->name.data (), true);
 			}
-			pImpl->animations.remove (animation);
 		}
 	});
+	if (!pImpl->inAdvance && pImpl->needsCompact)
+	{
+		pImpl->compact ();
+		if (pImpl->empty () && pImpl->registered)
+		{
+			pImpl->registered = false;
+			Detail::Timer::removeAnimator (this);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void Animator::framePresented (uint32_t timestamp)
+{
+	pImpl->clock.presented (timestamp);
 }
 
 //-----------------------------------------------------------------------------
 void Animator::onTimer ()
 {
+	auto time = pImpl->clock.nextPresentation (IPlatformFrame::getTicks ());
+	// the animations were already advanced to the next frame
+	if (pImpl->advanced && static_cast<int32_t> (time - pImpl->lastAdvanceTime) <= 0)
+		return;
+	advance (time);
+}
+
+//-----------------------------------------------------------------------------
+void Animator::advance (uint32_t time)
+{
+	if (pImpl->inAdvance)
+		return;
 	auto selfGuard = shared (this);
-	uint32_t currentTicks = IPlatformFrame::getTicks ();
-	pImpl->animations.forEach ([&] (SharedPointer<Detail::Animation>& animation) {
-		if (animation->startTime == 0)
+	pImpl->lastAdvanceTime = time;
+	pImpl->advanced = true;
+	pImpl->inAdvance = true;
+
+	auto& records = pImpl->records;
+	for (auto& record : records)
+	{
+		if (record.removed)
+			continue;
+		if (!record.started)
+			record.startTime = time;
+		auto elapsed = time - record.startTime;
+		record.pos = record.animation->timingFunction->getPosition (elapsed);
+		record.finished = record.animation->timingFunction->isDone (elapsed);
+	}
+
+	// new animations are added to pImpl->added while advancing, so records stays stable here
+	for (auto& record : records)
+	{
+		if (record.removed)
+			continue;
+		auto animation = record.animation;
+		if (!record.started)
 		{
 #if DEBUG_LOG
 			DebugPrint ("animation start: %p - %s\n", animation->view.cast<CView>(), animation->name.data ());
 #endif
+			record.started = true;
 			animation->animationTarget->animationStart (animation->view, animation->name.data ());
-			animation->startTime = currentTicks;
+			if (record.removed)
+				continue;
 		}
-		uint32_t time = currentTicks - animation->startTime;
-		float pos = animation->timingFunction->getPosition (time);
-		if (pos != animation->lastPos)
+		if (record.pos != record.lastPos)
 		{
-			animation->animationTarget->animationTick (animation->view, animation->name.data (), pos);
-			animation->lastPos = pos;
+			record.lastPos = record.pos;
+			animation->animationTarget->animationTick (animation->view, animation->name.data (), record.pos);
+			if (record.removed)
+				continue;
 		}
-		if (animation->timingFunction->isDone (time))
+		if (record.finished)
 		{
+			record.removed = true;
 			animation->done = true;
 			animation->animationTarget->animationFinished (animation->view, animation->name.data (), false);
 #if DEBUG_LOG
 			DebugPrint ("animation finished: %p - %s\n", animation->view.cast<CView>(), animation->name.data ());
 #endif
-			pImpl->animations.remove (animation);
 		}
-	});
-	if (pImpl->animations.empty ())
+	}
+
+	pImpl->inAdvance = false;
+	pImpl->compact ();
+	if (pImpl->empty () && pImpl->registered)
+	{
+		pImpl->registered = false;
 		Detail::Timer::removeAnimator (this);
+	}
 }
 
 IdStringPtr kMsgAnimationFinished = "kMsgAnimationFinished";
@@ -53,6 +53,12 @@ public:
 	Animator ();	// do not use this, instead use CFrame::getAnimator()
 	void onTimer ();
 
+	/** advance all animations to time (in milliseconds, see IPlatformFrame::getTicks) */
+	void advance (uint32_t time);
+	/** called by the frame after it painted a rect, the animation time is aligned to the painted
+		frames. Reports less than a few milliseconds apart count as one frame. */
+	void framePresented (uint32_t timestamp);
+
 protected:
 	~Animator () noexcept override;
 
@@ -0,0 +1,77 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "casyncbitmapview.h"
+#include "cbitmap.h"
+#include "cdrawcontext.h"
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+void CAsyncBitmapBuffer::post (CBitmap* bitmap)
+{
+	SharedPointer<CBitmap> previous (bitmap);
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		std::swap (pending, previous);
+	}
+	// the dropped bitmap is released outside of the lock
+}
+
+//-----------------------------------------------------------------------------
+bool CAsyncBitmapBuffer::hasPending () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return pending != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool CAsyncBitmapBuffer::swap ()
+{
+	SharedPointer<CBitmap> next;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		std::swap (pending, next);
+	}
+	if (!next)
+		return false;
+	front = std::move (next);
+	++generation;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void CAsyncBitmapBuffer::clear ()
+{
+	post (nullptr);
+	front = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+CAsyncBitmapView::CAsyncBitmapView (const CRect& size)
+: CView (size)
+, buffer (makeOwned<CAsyncBitmapBuffer> ())
+{
+	setWantsIdle (true);
+}
+
+//-----------------------------------------------------------------------------
+void CAsyncBitmapView::draw (CDrawContext* context)
+{
+	if (auto bitmap = buffer->getFront ())
+		bitmap->draw (context, getViewSize ());
+	setDirty (false);
+}
+
+//-----------------------------------------------------------------------------
+void CAsyncBitmapView::onIdle ()
+{
+	if (buffer->swap ())
+	{
+		invalid ();
+		onBitmapSwapped ();
+	}
+}
+
+} // VSTGUI
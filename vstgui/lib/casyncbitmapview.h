@@ -0,0 +1,76 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include "cview.h"
+#include <mutex>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** @brief Double buffer to hand bitmaps rendered on a worker thread to the UI thread
+ *
+ *	A worker thread renders into a standalone COffscreenContext (see
+ *	COffscreenContext::create (const CPoint&, double)) and posts the resulting bitmap. The UI thread
+ *	calls swap () once per frame to make the latest posted bitmap the front bitmap. Bitmaps posted
+ *	before the UI thread swapped are dropped, so a slow UI never queues up stale content.
+ *
+ *	post () may be called from any thread, all other methods only from the UI thread.
+ */
+class CAsyncBitmapBuffer : public AtomicReferenceCounted
+{
+public:
+	/** post a finished bitmap, thread-safe */
+	void post (CBitmap* bitmap);
+	/** returns true if a bitmap was posted since the last swap, thread-safe */
+	bool hasPending () const;
+	/** make the last posted bitmap the front bitmap, returns true if the front bitmap changed */
+	bool swap ();
+
+	CBitmap* getFront () const { return front; }
+	/** number of swaps, can be used to detect a new front bitmap */
+	uint32_t getGeneration () const { return generation; }
+
+	void clear ();
+
+private:
+	mutable std::mutex mutex;
+	SharedPointer<CBitmap> pending;
+	SharedPointer<CBitmap> front;
+	uint32_t generation {0};
+};
+
+//-----------------------------------------------------------------------------
+/** @brief View which shows bitmaps rendered on worker threads
+ *
+ *	The view owns a CAsyncBitmapBuffer which can be passed to a worker thread. While the view is
+ *	attached it checks the buffer on every idle and when a new bitmap was posted it swaps it in and
+ *	invalidates itself. The front bitmap is drawn unscaled at the top left of the view, so workers
+ *	should render with the view size and the scale factor of the frame.
+ *
+ *	Keep a reference to the buffer on the worker side instead of the view, the view may be destroyed
+ *	while the worker is still rendering.
+ */
+class CAsyncBitmapView : public CView
+{
+public:
+	explicit CAsyncBitmapView (const CRect& size);
+	~CAsyncBitmapView () noexcept override = default;
+
+	CAsyncBitmapBuffer* getBuffer () const { return buffer; }
+
+	// override
+	void draw (CDrawContext* context) override;
+	void onIdle () override;
+
+protected:
+	/** called on the UI thread after a new bitmap was swapped in */
+	virtual void onBitmapSwapped () {}
+
+	SharedPointer<CAsyncBitmapBuffer> buffer;
+};
+
+} // VSTGUI
@@ -5,8 +5,7 @@
 #include "ccolor.h"
 #include "cstring.h"
 #include <cmath>
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
 
 namespace VSTGUI {
 
@@ -307,13 +306,9 @@ bool CColor::fromString (UTF8StringPtr str)
 //-----------------------------------------------------------------------------
 UTF8String CColor::toString () const
 {
-	std::stringstream str;
-	str << "#";
-	str << std::hex << std::setw (2) << std::setfill ('0') << static_cast<int32_t> (red);
-	str << std::hex << std::setw (2) << std::setfill ('0') << static_cast<int32_t> (green);
-	str << std::hex << std::setw (2) << std::setfill ('0') << static_cast<int32_t> (blue);
-	str << std::hex << std::setw (2) << std::setfill ('0') << static_cast<int32_t> (alpha);
-	return UTF8String (str.str ());
+	char str[10];
+	snprintf (str, sizeof (str), "#%02x%02x%02x%02x", red, green, blue, alpha);
+	return UTF8String (str);
 }
 
 } // namespace
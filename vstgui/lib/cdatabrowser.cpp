@@ -798,9 +798,23 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 
 	CDrawContext::LineList lines;
 
+	// only visit the rows inside the update rect
+	int32_t firstRow = 0;
+	int32_t lastRow = numRows;
+	if (rowHeight > 0.)
+	{
+		firstRow = std::max (
+			0, static_cast<int32_t> (std::floor ((updateRect.top - getViewSize ().top) / rowHeight)));
+		lastRow = std::min (
+			numRows,
+			static_cast<int32_t> (std::ceil ((updateRect.bottom - getViewSize ().top) / rowHeight)) +
+				1);
+	}
+
 	CRect r (getViewSize ());
 	r.setHeight (rowHeight - lineWidth);
-	for (int32_t row = 0; row < numRows; row++)
+	r.offset (0, firstRow * rowHeight);
+	for (int32_t row = firstRow; row < lastRow; row++)
 	{
 		CRect testRect (r);
 		testRect.bound (updateRect);
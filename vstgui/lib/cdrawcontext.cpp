@@ -291,6 +291,40 @@ void CDrawContext::drawString (UTF8StringPtr string, const CRect& rect, const CH
 	clearDrawString ();
 }
 
+//-----------------------------------------------------------------------------
+void CDrawContext::drawPolyline (const CPoint* points, size_t numPoints)
+{
+	if (numPoints < 2)
+		return;
+	auto path = owned (createGraphicsPath ());
+	if (!path)
+		return;
+	path->beginSubpath (points[0]);
+	for (size_t i = 1; i < numPoints; ++i)
+		path->addLine (points[i]);
+	drawGraphicsPath (path, kPathStroked);
+}
+
+//-----------------------------------------------------------------------------
+void CDrawContext::drawEnvelope (const CPoint* upper, const CPoint* lower, size_t numPoints, const CDrawStyle drawStyle)
+{
+	if (numPoints == 0)
+		return;
+	auto path = owned (createGraphicsPath ());
+	if (!path)
+		return;
+	path->beginSubpath (upper[0]);
+	for (size_t i = 1; i < numPoints; ++i)
+		path->addLine (upper[i]);
+	for (size_t i = numPoints; i > 0; --i)
+		path->addLine (lower[i - 1]);
+	path->closeSubpath ();
+	if (drawStyle != kDrawStroked)
+		drawGraphicsPath (path, kPathFilled);
+	if (drawStyle != kDrawFilled)
+		drawGraphicsPath (path, kPathStroked);
+}
+
 //-----------------------------------------------------------------------------
 void CDrawContext::fillRectWithBitmap (CBitmap* bitmap, const CRect& srcRect, const CRect& dstRect, float alpha)
 {
@@ -57,6 +57,11 @@ public:
 	virtual void drawLines (const LineList& lines) = 0;
 	/** draw a polygon */
 	virtual void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle = kDrawStroked) = 0;
+	/** draw connected lines through all points with one stroke */
+	virtual void drawPolyline (const CPoint* points, size_t numPoints);
+	inline void drawPolyline (const PointList& points) { drawPolyline (points.data (), points.size ()); }
+	/** draw the area between an upper and a lower line with numPoints points each, see CDrawMethods::decimateEnvelope */
+	virtual void drawEnvelope (const CPoint* upper, const CPoint* lower, size_t numPoints, const CDrawStyle drawStyle = kDrawFilled);
 	/** draw a rect */
 	virtual void drawRect (const CRect &rect, const CDrawStyle drawStyle = kDrawStroked) = 0;
 	/** draw an arc, angles are in degree */
@@ -7,9 +7,76 @@
 #include "cstring.h"
 #include "cdrawcontext.h"
 #include "platform/iplatformfont.h"
+#include <algorithm>
 
 namespace VSTGUI {
 namespace CDrawMethods {
+namespace {
+
+//------------------------------------------------------------------------
+struct SampleMapping
+{
+	SampleMapping (const CRect& rect, float minValue, float maxValue)
+	: bottom (rect.bottom)
+	, scale (maxValue != minValue ? rect.getHeight () / (maxValue - minValue) : 0.)
+	, minValue (minValue)
+	{
+		if (scale == 0.)
+			bottom -= rect.getHeight () / 2.;
+	}
+
+	CCoord y (float value) const { return bottom - (value - minValue) * scale; }
+
+private:
+	CCoord bottom;
+	CCoord scale;
+	float minValue;
+};
+
+//------------------------------------------------------------------------
+size_t numColumns (const CRect& rect, double scaleFactor)
+{
+	auto columns = static_cast<size_t> (rect.getWidth () * scaleFactor);
+	return columns ? columns : 1;
+}
+
+//------------------------------------------------------------------------
+/** calls proc (x, minIndex, maxIndex) for every device pixel column */
+template<typename Proc>
+void forEachColumn (const float* samples, size_t numSamples, const CRect& rect, size_t columns,
+					Proc proc)
+{
+	auto columnWidth = rect.getWidth () / columns;
+	size_t start = 0;
+	for (size_t column = 0; column < columns; ++column)
+	{
+		auto end = (column + 1) * numSamples / columns;
+		if (end <= start)
+			continue;
+		auto minIndex = start;
+		auto maxIndex = start;
+		for (auto i = start + 1; i < end; ++i)
+		{
+			if (samples[i] < samples[minIndex])
+				minIndex = i;
+			else if (samples[i] > samples[maxIndex])
+				maxIndex = i;
+		}
+		proc (rect.left + (column + 0.5) * columnWidth, minIndex, maxIndex);
+		start = end;
+	}
+}
+
+//------------------------------------------------------------------------
+CCoord sampleX (const CRect& rect, size_t index, size_t numSamples)
+{
+	if (numSamples < 2)
+		return rect.left;
+	return rect.left + rect.getWidth () * index / (numSamples - 1);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
 
 //------------------------------------------------------------------------
 UTF8String createTruncatedText (TextTruncateMode mode, const UTF8String& text, CFontRef font,
@@ -151,5 +218,65 @@ void drawIconAndText (CDrawContext* context, CBitmap* iconToDraw, IconPosition i
 			context->drawString (title.getPlatformString (), drawRect, textAlignment);
 	}
 }
+
+//------------------------------------------------------------------------
+void decimateMinMax (const float* samples, size_t numSamples, const CRect& rect,
+					 double scaleFactor, std::vector<CPoint>& points, float minValue, float maxValue)
+{
+	points.clear ();
+	if (numSamples == 0)
+		return;
+	SampleMapping mapping (rect, minValue, maxValue);
+	auto columns = numColumns (rect, scaleFactor);
+	if (numSamples <= columns * 2)
+	{
+		points.reserve (numSamples);
+		for (size_t i = 0; i < numSamples; ++i)
+			points.emplace_back (sampleX (rect, i, numSamples), mapping.y (samples[i]));
+		return;
+	}
+	points.reserve (columns * 2);
+	forEachColumn (samples, numSamples, rect, columns,
+				   [&] (CCoord x, size_t minIndex, size_t maxIndex) {
+					   auto first = std::min (minIndex, maxIndex);
+					   auto second = std::max (minIndex, maxIndex);
+					   points.emplace_back (x, mapping.y (samples[first]));
+					   if (first != second)
+						   points.emplace_back (x, mapping.y (samples[second]));
+				   });
+}
+
+//------------------------------------------------------------------------
+void decimateEnvelope (const float* samples, size_t numSamples, const CRect& rect,
+					   double scaleFactor, std::vector<CPoint>& upper, std::vector<CPoint>& lower,
+					   float minValue, float maxValue)
+{
+	upper.clear ();
+	lower.clear ();
+	if (numSamples == 0)
+		return;
+	SampleMapping mapping (rect, minValue, maxValue);
+	auto columns = numColumns (rect, scaleFactor);
+	if (numSamples <= columns)
+	{
+		upper.reserve (numSamples);
+		lower.reserve (numSamples);
+		for (size_t i = 0; i < numSamples; ++i)
+		{
+			CPoint p (sampleX (rect, i, numSamples), mapping.y (samples[i]));
+			upper.emplace_back (p);
+			lower.emplace_back (p);
+		}
+		return;
+	}
+	upper.reserve (columns);
+	lower.reserve (columns);
+	forEachColumn (samples, numSamples, rect, columns,
+				   [&] (CCoord x, size_t minIndex, size_t maxIndex) {
+					   upper.emplace_back (x, mapping.y (samples[maxIndex]));
+					   lower.emplace_back (x, mapping.y (samples[minIndex]));
+				   });
+}
+
 }
 } // namespaces
@@ -9,6 +9,7 @@
 #include "cdrawdefs.h"
 #include "cfont.h"
 #include "cpoint.h"
+#include <vector>
 
 namespace VSTGUI {
 
@@ -72,6 +73,38 @@ void drawIconAndText (CDrawContext* context, CBitmap* iconToDraw, IconPosition i
                       CHoriTxtAlign textAlignment, CCoord textIconMargin, CRect drawRect,
                       const UTF8String& title, CFontRef font, CColor textColor,
                       TextTruncateMode truncateMode = kTextTruncateNone);
+
+//-----------------------------------------------------------------------------
+/** reduces sample data to at most two points per device pixel for CDrawContext::drawPolyline
+ *
+ *	The samples are distributed over the width of rect and sample values from minValue to maxValue
+ *	are mapped from the bottom to the top of rect. For every device pixel column the minimum and the
+ *	maximum sample are added in the order they appear in the samples, so that a polyline through the
+ *	points keeps the shape of the signal. If there are not more samples than points, every sample
+ *	is added.
+ *
+ *	@param samples		sample data
+ *	@param numSamples	number of samples
+ *	@param rect			target rectangle
+ *	@param scaleFactor	scale factor of the draw context
+ *	@param points		result, will be cleared first
+ *	@param minValue		sample value mapped to the bottom of rect
+ *	@param maxValue		sample value mapped to the top of rect
+ */
+void decimateMinMax (const float* samples, size_t numSamples, const CRect& rect,
+                     double scaleFactor, std::vector<CPoint>& points, float minValue = -1.f,
+                     float maxValue = 1.f);
+
+//-----------------------------------------------------------------------------
+/** reduces sample data to one upper and one lower point per device pixel for
+ *	CDrawContext::drawEnvelope
+ *
+ *	Same as decimateMinMax, but the maximum of a column is added to upper and the minimum to lower.
+ */
+void decimateEnvelope (const float* samples, size_t numSamples, const CRect& rect,
+                       double scaleFactor, std::vector<CPoint>& upper, std::vector<CPoint>& lower,
+                       float minValue = -1.f, float maxValue = 1.f);
+
 }} // namespaces
 
 #endif // __cdrawmethods__
@@ -5,6 +5,9 @@
 #include "cfont.h"
 #include "cstring.h"
 #include "platform/iplatformfont.h"
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace VSTGUI {
 
@@ -97,7 +100,7 @@ void CFontDesc::beforeDelete ()
 auto CFontDesc::getPlatformFont () const -> const PlatformFontPtr
 {
 	if (platformFont == nullptr)
-		platformFont = IPlatformFont::create (name, size, style);
+		platformFont = CPlatformFontCache::get (name, size, style);
 	return platformFont;
 }
 
@@ -113,7 +116,8 @@ const IFontPainter* CFontDesc::getFontPainter () const
 //-----------------------------------------------------------------------------
 void CFontDesc::freePlatformFont ()
 {
-	platformFont = nullptr;
+	if (platformFont)
+		CPlatformFontCache::release (platformFont);
 }
 
 //-----------------------------------------------------------------------------
@@ -172,6 +176,101 @@ void CFontDesc::cleanup ()
 	gNormalFontSmaller.freePlatformFont ();
 	gNormalFontVerySmall.freePlatformFont ();
 	gSymbolFont.freePlatformFont ();
+	CPlatformFontCache::purge ();
+}
+
+//-----------------------------------------------------------------------------
+// CPlatformFontCache Implementation
+//-----------------------------------------------------------------------------
+namespace {
+
+//-----------------------------------------------------------------------------
+struct PlatformFontCacheData
+{
+	using Key = std::tuple<std::string, CCoord, int32_t>;
+
+	std::mutex mutex;
+	std::map<Key, SharedPointer<IPlatformFont>> fonts;
+	CPlatformFontCache::Statistics statistics;
+
+	/** must be called with the mutex locked */
+	void purgeUnused ()
+	{
+		for (auto it = fonts.begin (); it != fonts.end ();)
+		{
+			if (it->second->getNbReference () == 1)
+				it = fonts.erase (it);
+			else
+				++it;
+		}
+	}
+};
+
+//-----------------------------------------------------------------------------
+PlatformFontCacheData& getPlatformFontCacheData ()
+{
+	static PlatformFontCacheData data;
+	return data;
+}
+
+} // anonymous
+
+//-----------------------------------------------------------------------------
+auto CPlatformFontCache::get (const UTF8String& name, const CCoord& size, const int32_t& style) -> PlatformFontPtr
+{
+	auto& data = getPlatformFontCacheData ();
+	PlatformFontCacheData::Key key (name.getString (), size, style);
+	std::lock_guard<std::mutex> guard (data.mutex);
+	auto it = data.fonts.find (key);
+	if (it != data.fonts.end ())
+	{
+		++data.statistics.hits;
+		return it->second;
+	}
+	++data.statistics.misses;
+	// creating a platform font is far more expensive than looking for fonts a caller released
+	// without going through release ()
+	data.purgeUnused ();
+	auto font = IPlatformFont::create (name, size, style);
+	if (font)
+		data.fonts.emplace (std::move (key), font);
+	return font;
+}
+
+//-----------------------------------------------------------------------------
+void CPlatformFontCache::release (PlatformFontPtr& font)
+{
+	auto& data = getPlatformFontCacheData ();
+	std::lock_guard<std::mutex> guard (data.mutex);
+	auto pf = font.get ();
+	font = nullptr;
+	for (auto it = data.fonts.begin (); it != data.fonts.end (); ++it)
+	{
+		if (it->second == pf)
+		{
+			if (pf->getNbReference () == 1)
+				data.fonts.erase (it);
+			break;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CPlatformFontCache::purge ()
+{
+	auto& data = getPlatformFontCacheData ();
+	std::lock_guard<std::mutex> guard (data.mutex);
+	data.purgeUnused ();
+}
+
+//-----------------------------------------------------------------------------
+auto CPlatformFontCache::getStatistics () -> Statistics
+{
+	auto& data = getPlatformFontCacheData ();
+	std::lock_guard<std::mutex> guard (data.mutex);
+	auto result = data.statistics;
+	result.liveFonts = data.fonts.size ();
+	return result;
 }
 
 } // namespace
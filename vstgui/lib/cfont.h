@@ -77,6 +77,41 @@ protected:
 
 using CFontRef = CFontDesc*;
 
+//-----------------------------------------------------------------------------
+// CPlatformFontCache Declaration
+//! @brief process wide cache of the platform fonts used by CFontDesc
+//!
+//! All CFontDesc objects with the same name, size and style share one platform font. A platform
+//! font is evicted when no CFontDesc references it anymore. All methods are thread-safe.
+//-----------------------------------------------------------------------------
+class CPlatformFontCache
+{
+public:
+	using PlatformFontPtr = SharedPointer<IPlatformFont>;
+
+	struct Statistics
+	{
+		/** number of platform fonts in the cache */
+		size_t liveFonts {0};
+		uint64_t hits {0};
+		uint64_t misses {0};
+
+		double hitRate () const
+		{
+			return (hits + misses) ? static_cast<double> (hits) / (hits + misses) : 0.;
+		}
+	};
+
+	/** returns the shared platform font, creates it if it is not in the cache */
+	static PlatformFontPtr get (const UTF8String& name, const CCoord& size, const int32_t& style);
+	/** drops the reference of font and evicts it from the cache if it is no longer used */
+	static void release (PlatformFontPtr& font);
+	/** evict all fonts which are only referenced by the cache */
+	static void purge ();
+
+	static Statistics getStatistics ();
+};
+
 //-----------------------------------------------------------------------------
 // Global fonts
 //-----------------------------------------------------------------------------
@@ -1580,6 +1580,8 @@ IPlatformFrame* CFrame::getPlatformFrame () const
 bool CFrame::platformDrawRect (CDrawContext* context, const CRect& rect)
 {
 	drawRect (context, rect);
+	if (pImpl->animator)
+		pImpl->animator->framePresented (IPlatformFrame::getTicks ());
 	return true;
 }
 
@@ -5,16 +5,98 @@
 #include "clayeredviewcontainer.h"
 #include "cframe.h"
 #include "cdrawcontext.h"
+#include "coffscreencontext.h"
 #include "platform/iplatformframe.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace VSTGUI {
 
+//-----------------------------------------------------------------------------
+struct CLayeredViewContainer::SoftwareLayer
+{
+	struct DeferredLayer
+	{
+		SharedPointer<CLayeredViewContainer> view;
+		CGraphicsTransform transform;
+		CRect clip;
+		CRect updateRect;
+		float alpha;
+	};
+	using DeferredLayers = std::vector<DeferredLayer>;
+	using DirtyRects = std::vector<CRect>;
+
+	static constexpr size_t kMaxDirtyRects = 16;
+
+	SharedPointer<COffscreenContext> context;
+	CPoint size;
+	double scaleFactor {0.};
+	/** relative to the top left of the view size */
+	DirtyRects dirtyRects;
+	/** set while the cache is rendered, layered children drawing into it are deferred */
+	CDrawContext* renderContext {nullptr};
+	DeferredLayers deferredLayers;
+
+	void addDirtyRect (const CRect& rect);
+	void drawDeferredLayers ();
+};
+
+//-----------------------------------------------------------------------------
+void CLayeredViewContainer::SoftwareLayer::addDirtyRect (const CRect& rect)
+{
+	for (const auto& r : dirtyRects)
+	{
+		CRect intersection (rect);
+		if (intersection.bound (r) == rect)
+			return;
+	}
+	auto isInsideRect = [&] (const CRect& r) {
+		CRect intersection (r);
+		return intersection.bound (rect) == r;
+	};
+	dirtyRects.erase (std::remove_if (dirtyRects.begin (), dirtyRects.end (), isInsideRect),
+					  dirtyRects.end ());
+	if (dirtyRects.size () < kMaxDirtyRects)
+	{
+		dirtyRects.emplace_back (rect);
+		return;
+	}
+	// too fragmented, render the union instead
+	CRect unitedRect (rect);
+	for (const auto& r : dirtyRects)
+		unitedRect.unite (r);
+	dirtyRects.assign (1, unitedRect);
+}
+
+//-----------------------------------------------------------------------------
+void CLayeredViewContainer::SoftwareLayer::drawDeferredLayers ()
+{
+	auto lessZIndex = [] (const DeferredLayer& l1, const DeferredLayer& l2) {
+		return l1.view->getZIndex () < l2.view->getZIndex ();
+	};
+	std::stable_sort (deferredLayers.begin (), deferredLayers.end (), lessZIndex);
+	for (const auto& deferred : deferredLayers)
+	{
+		auto toDeferred = context->getCurrentTransform ().inverse () * deferred.transform;
+		CDrawContext::Transform transform (*context, toDeferred);
+		context->setClipRect (deferred.clip);
+		context->setGlobalAlpha (deferred.alpha);
+		deferred.view->drawSoftwareLayer (context, deferred.updateRect);
+	}
+	context->setGlobalAlpha (1.f);
+	deferredLayers.clear ();
+}
+
 //-----------------------------------------------------------------------------
 CLayeredViewContainer::CLayeredViewContainer (const CRect& r)
 : CViewContainer (r)
 {
 }
 
+//-----------------------------------------------------------------------------
+CLayeredViewContainer::~CLayeredViewContainer () noexcept = default;
+
 //-----------------------------------------------------------------------------
 void CLayeredViewContainer::setZIndex (uint32_t _zIndex)
 {
@@ -61,9 +143,10 @@ bool CLayeredViewContainer::removed (CView* parent)
 	if (layer)
 	{
 		layer = nullptr;
-		parentLayerView = nullptr;
 		getFrame ()->unregisterScaleFactorChangedListeneer (this);
 	}
+	softwareLayer = nullptr;
+	parentLayerView = nullptr;
 	return CViewContainer::removed (parent);
 }
 
@@ -94,6 +177,10 @@ bool CLayeredViewContainer::attached (CView* parent)
 			updateLayerSize ();
 			getFrame ()->registerScaleFactorChangedListeneer (this);
 		}
+		else
+		{
+			softwareLayer.reset (new SoftwareLayer);
+		}
 	}
 	parent = getParentView ();
 	
@@ -145,6 +232,14 @@ void CLayeredViewContainer::invalidRect (const CRect& rect)
 	}
 	else
 	{
+		if (softwareLayer)
+		{
+			CRect r (rect);
+			getTransform ().transform (r);
+			r.bound (CRect (0., 0., getViewSize ().getWidth (), getViewSize ().getHeight ()));
+			if (!r.isEmpty ())
+				softwareLayer->addDirtyRect (r);
+		}
 		CViewContainer::invalidRect (rect);
 	}
 }
@@ -186,9 +281,96 @@ void CLayeredViewContainer::setAlphaValue (float alpha)
 void CLayeredViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 {
 	if (layer)
+	{
 		layer->draw (pContext, updateRect);
+	}
+	else if (parentLayerView && parentLayerView->softwareLayer &&
+			 parentLayerView->softwareLayer->renderContext == pContext)
+	{
+		// the parent layer draws us on top of its other children
+		SoftwareLayer::DeferredLayer deferred;
+		deferred.view = this;
+		deferred.transform = pContext->getCurrentTransform ();
+		pContext->getClipRect (deferred.clip);
+		deferred.updateRect = updateRect;
+		deferred.alpha = pContext->getGlobalAlpha ();
+		parentLayerView->softwareLayer->deferredLayers.emplace_back (std::move (deferred));
+	}
 	else
-		CViewContainer::drawRect (pContext, updateRect);
+	{
+		drawSoftwareLayer (pContext, updateRect);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CLayeredViewContainer::drawSoftwareLayer (CDrawContext* pContext, const CRect& updateRect)
+{
+	if (softwareLayer && updateSoftwareLayer (pContext))
+	{
+		if (auto bitmap = softwareLayer->context->getBitmap ())
+		{
+			pContext->drawBitmap (bitmap, getViewSize ());
+			return;
+		}
+	}
+	CViewContainer::drawRect (pContext, updateRect);
+}
+
+//-----------------------------------------------------------------------------
+bool CLayeredViewContainer::updateSoftwareLayer (CDrawContext* pContext)
+{
+	auto& sl = *softwareLayer;
+	CPoint size (getViewSize ().getWidth (), getViewSize ().getHeight ());
+	// render at the resolution the bitmap is drawn with, like CShadowViewContainer
+	auto scaleFactor = pContext->getScaleFactor ();
+	CGraphicsTransform matrix = pContext->getCurrentTransform ();
+	if (matrix.m11 == matrix.m22)
+	{
+		double matrixScale = std::floor (matrix.m11 + 0.5);
+		if (matrixScale != 0.)
+			scaleFactor *= matrixScale;
+	}
+	if (!sl.context || sl.size != size || sl.scaleFactor != scaleFactor)
+	{
+		sl.context = COffscreenContext::create (getFrame (), size.x, size.y, scaleFactor);
+		if (!sl.context)
+			return false;
+		sl.size = size;
+		sl.scaleFactor = scaleFactor;
+		sl.dirtyRects.assign (1, CRect (CPoint (), size));
+	}
+	if (sl.dirtyRects.empty ())
+		return true;
+
+	// views invalidating while they draw are rendered the next time
+	auto dirtyRects = std::move (sl.dirtyRects);
+	sl.dirtyRects.clear ();
+
+	CPoint offset (getViewSize ().left, getViewSize ().top);
+	sl.context->beginDraw ();
+	sl.renderContext = sl.context;
+	for (auto dirtyRect : dirtyRects)
+	{
+		// clear whole pixels only, partially cleared edges would blend with the new content
+		dirtyRect.left = std::floor (dirtyRect.left * scaleFactor) / scaleFactor;
+		dirtyRect.top = std::floor (dirtyRect.top * scaleFactor) / scaleFactor;
+		dirtyRect.right = std::ceil (dirtyRect.right * scaleFactor) / scaleFactor;
+		dirtyRect.bottom = std::ceil (dirtyRect.bottom * scaleFactor) / scaleFactor;
+		dirtyRect.bound (CRect (CPoint (), size));
+		sl.context->setClipRect (dirtyRect);
+		sl.context->clearRect (dirtyRect);
+		{
+			CGraphicsTransform toCache;
+			toCache.translate (-offset.x, -offset.y);
+			CDrawContext::Transform transform (*sl.context, toCache);
+			dirtyRect.offset (offset.x, offset.y);
+			CViewContainer::drawRect (sl.context, dirtyRect);
+		}
+		sl.drawDeferredLayers ();
+	}
+	sl.renderContext = nullptr;
+	sl.context->endDraw ();
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 #include "iviewlistener.h"
 #include "iscalefactorchangedlistener.h"
 #include "platform/iplatformviewlayer.h"
+#include <memory>
 
 namespace VSTGUI {
 
@@ -18,7 +19,12 @@ namespace VSTGUI {
 //! @ingroup containerviews
 //! @ingroup new_in_4_2
 //! A CLayeredViewContainer creates a platform layer on top of a parent layer or the platform view of CFrame
-//! if available on that platform and draws into it, otherwise it acts exactly like a CViewContainer
+//! if available on that platform and draws into it.
+//! Otherwise it caches its content in an offscreen bitmap at the scale factor of the draw context and its
+//! current transform. Only the parts invalidated by its children are rendered again, for all other redraws
+//! the bitmap is drawn. Like a platform layer the alpha value applies to the composited content, and layered
+//! containers inside of it are drawn on top of its other children ordered by their z-index. Layered
+//! containers without a parent layered container are drawn in the order of their parents' children.
 //-----------------------------------------------------------------------------
 class CLayeredViewContainer : public CViewContainer,
                               public IPlatformViewLayerDelegate,
@@ -27,7 +33,7 @@ class CLayeredViewContainer : public CViewContainer,
 {
 public:
 	explicit CLayeredViewContainer (const CRect& r = CRect (0, 0, 0, 0));
-	~CLayeredViewContainer () noexcept override = default;
+	~CLayeredViewContainer () noexcept override;
 	
 	IPlatformViewLayer* getPlatformLayer () const { return layer; }
 
@@ -51,7 +57,13 @@ protected:
 	CGraphicsTransform getDrawTransform () const;
 	void registerListeners (bool state);
 
+	void drawSoftwareLayer (CDrawContext* pContext, const CRect& updateRect);
+	bool updateSoftwareLayer (CDrawContext* pContext);
+
+	struct SoftwareLayer;
+
 	SharedPointer<IPlatformViewLayer> layer;
+	std::unique_ptr<SoftwareLayer> softwareLayer;
 	CLayeredViewContainer* parentLayerView {nullptr};
 	uint32_t zIndex {0};
 };
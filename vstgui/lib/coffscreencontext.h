@@ -51,6 +51,35 @@ if (cachedBitmap)
 	// ...
 }
 
+@endcode
+
+@section offscreen_threads Drawing on a worker thread
+
+A context created with create (const CPoint&, double) does not need a CFrame and can be created and
+drawn into on any thread. On Windows the thread must have initialized COM with CoInitializeEx before,
+as the bitmap of the context is created via the WIC imaging factory. Only the following subset is
+supported off the UI thread:
+- CDrawContext: all drawing, state, clipping and transform methods of the context itself.
+  A context must only be used by one thread at a time.
+- CGraphicsPath: paths created by this context via createGraphicsPath () or createTextPath ().
+- CFontDesc: font objects created by the worker thread. The shared font objects like kNormalFont
+  create their platform font lazily and must not be used until the UI thread used them once.
+- CGradient: gradients created by the worker thread via CGradient::create ().
+- CBitmap: getBitmap () after endDraw (). Bitmaps loaded from resources may be drawn if the UI
+  thread does not modify them at the same time.
+
+Views, frames, timers and the other UI objects are not thread-safe. Use CAsyncBitmapBuffer or
+CAsyncBitmapView to hand the finished bitmap to the UI thread.
+
+@code
+// worker thread
+if (auto offscreen = COffscreenContext::create (size, scaleFactor))
+{
+	offscreen->beginDraw ();
+	// ...
+	offscreen->endDraw ();
+	asyncBuffer->post (offscreen->getBitmap ());
+}
 @endcode
 
  */
@@ -59,6 +88,13 @@ class COffscreenContext : public CDrawContext
 {
 public:
 	static SharedPointer<COffscreenContext> create (CFrame* frame, CCoord width, CCoord height, double scaleFactor = 1.);
+	/** create a standalone offscreen context, can be called from any thread
+	 *
+	 *	On Windows the calling thread must have initialized COM. An empty size is passed to the
+	 *	platform like with create (CFrame*, CCoord, CCoord, double), Cairo and Direct2D return an
+	 *	empty context for it.
+	 */
+	static SharedPointer<COffscreenContext> create (const CPoint& size, double scaleFactor = 1.);
 
 	//-----------------------------------------------------------------------------
 	/// @name COffscreenContext Methods
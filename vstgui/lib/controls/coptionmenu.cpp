@@ -9,6 +9,7 @@
 
 #include "../platform/iplatformoptionmenu.h"
 #include "../platform/iplatformframe.h"
+#include <unordered_map>
 
 namespace VSTGUI {
 
@@ -324,6 +325,14 @@ There are 2 styles with or without a shadowed text. When a mouse click occurs, a
  * @param bgWhenClick the background bitmap if the option menu is displayed
  * @param style the style of the display (see CParamDisplay for styles)
  */
+//------------------------------------------------------------------------
+struct COptionMenu::ProvidedItems
+{
+	SharedPointer<IOptionMenuItemProvider> provider;
+	std::unordered_map<int32_t, SharedPointer<CMenuItem>> items;
+	int32_t checkedIndex {-1};
+};
+
 //------------------------------------------------------------------------
 COptionMenu::COptionMenu (const CRect& size, IControlListener* listener, int32_t tag, CBitmap* background, CBitmap* bgWhenClick, const int32_t style)
 : CParamDisplay (size, background, style)
@@ -353,6 +362,8 @@ COptionMenu::COptionMenu (const COptionMenu& v)
 , nbItemsPerColumn (v.nbItemsPerColumn)
 , bgWhenClick (v.bgWhenClick)
 {
+	if (v.providedItems)
+		setItemProvider (v.providedItems->provider);
 	setWantsFocus (true);
 }
 
@@ -447,24 +458,21 @@ void COptionMenu::beforePopup ()
 #endif
 	if (listeners)
 		listeners->forEach ([this] (IOptionMenuListener* l) { l->onOptionMenuPrePopup (this); });
-	for (auto& menuItem : *menuItems)
-	{
-		CCommandMenuItem* commandItem = menuItem.cast<CCommandMenuItem> ();
-		if (commandItem)
+	forEachCreatedEntry ([] (int32_t, CMenuItem* menuItem) {
+		if (auto commandItem = dynamic_cast<CCommandMenuItem*> (menuItem))
 			commandItem->validate ();
 		if (menuItem->getSubmenu ())
 			menuItem->getSubmenu ()->beforePopup ();
-	}
+	});
 }
 
 //------------------------------------------------------------------------
 void COptionMenu::afterPopup ()
 {
-	for (auto& menuItem : *menuItems)
-	{
+	forEachCreatedEntry ([] (int32_t, CMenuItem* menuItem) {
 		if (menuItem->getSubmenu ())
 			menuItem->getSubmenu ()->afterPopup ();
-	}
+	});
 	if (listeners)
 		listeners->forEach ([this] (IOptionMenuListener* l) { l->onOptionMenuPostPopup (this); });
 }
@@ -491,7 +499,7 @@ bool COptionMenu::popup (const PopupCallback& callback)
 	lastResult = -1;
 	lastMenu = nullptr;
 
-	if (!menuItems->empty ())
+	if (getNbEntries () > 0)
 	{
 		getFrame ()->onStartLocalEventLoop ();
 		if (auto platformMenu = getFrame ()->getPlatformFrame ()->createPlatformOptionMenu ())
@@ -528,7 +536,7 @@ bool COptionMenu::popup (const PopupCallback& callback)
 //------------------------------------------------------------------------
 bool COptionMenu::popup (CFrame* frame, const CPoint& frameLocation, const PopupCallback& callback)
 {
-	if (frame == nullptr || menuItems->empty ())
+	if (frame == nullptr || getNbEntries () == 0)
 		return false;
 	if (isAttached ())
 		return false;
@@ -553,7 +561,7 @@ bool COptionMenu::popup (CFrame* frame, const CPoint& frameLocation, const Popup
 //------------------------------------------------------------------------
 void COptionMenu::cleanupSeparators (bool deep)
 {
-	if (getItems ()->empty ())
+	if (providedItems || getItems ()->empty ())
 		return;
 
 	std::list<int32_t>indicesToRemove;
@@ -599,6 +607,42 @@ void COptionMenu::setPrefixNumbers (int32_t preCount)
 		prefixNumbers = preCount;
 }
 
+//------------------------------------------------------------------------
+void COptionMenu::setItemProvider (IOptionMenuItemProvider* provider)
+{
+	SharedPointer<IOptionMenuItemProvider> guard (provider);
+	removeAllEntry ();
+	if (provider)
+	{
+		providedItems = std::unique_ptr<ProvidedItems> (new ProvidedItems);
+		providedItems->provider = provider;
+	}
+}
+
+//------------------------------------------------------------------------
+IOptionMenuItemProvider* COptionMenu::getItemProvider () const
+{
+	return providedItems ? providedItems->provider.get () : nullptr;
+}
+
+//------------------------------------------------------------------------
+void COptionMenu::forEachCreatedEntry (
+	const std::function<void (int32_t index, CMenuItem* item)>& proc) const
+{
+	if (providedItems)
+	{
+		for (auto& element : providedItems->items)
+		{
+			if (element.second)
+				proc (element.first, element.second);
+		}
+		return;
+	}
+	int32_t index = 0;
+	for (auto& item : *menuItems)
+		proc (index++, item);
+}
+
 /**
  * @param item menu item to add. Takes ownership of item.
  * @param index position of insertation. -1 appends the item
@@ -606,6 +650,12 @@ void COptionMenu::setPrefixNumbers (int32_t preCount)
 //-----------------------------------------------------------------------------
 CMenuItem* COptionMenu::addEntry (CMenuItem* item, int32_t index)
 {
+	if (providedItems)
+	{
+		vstgui_assert (false, "entries are created by the item provider");
+		item->forget ();
+		return nullptr;
+	}
 	if (index < 0 || index > getNbEntries ())
 		menuItems->emplace_back (owned (item));
 	else
@@ -647,6 +697,19 @@ CMenuItem* COptionMenu::getCurrent () const
 //-----------------------------------------------------------------------------
 CMenuItem* COptionMenu::getEntry (int32_t index) const
 {
+	if (providedItems)
+	{
+		if (index < 0 || index >= getNbEntries ())
+			return nullptr;
+		auto& item = providedItems->items[index];
+		if (!item)
+		{
+			item = owned (providedItems->provider->createItem (index));
+			if (item && providedItems->checkedIndex >= 0)
+				item->setChecked (index == providedItems->checkedIndex);
+		}
+		return item;
+	}
 	if (index < 0 || menuItems->empty () || index >= getNbEntries ())
 		return nullptr;
 	
@@ -656,6 +719,8 @@ CMenuItem* COptionMenu::getEntry (int32_t index) const
 //-----------------------------------------------------------------------------
 int32_t COptionMenu::getNbEntries () const
 {
+	if (providedItems)
+		return providedItems->provider->getNumItems ();
 	return static_cast<int32_t> (menuItems->size ());
 }
 
@@ -671,17 +736,18 @@ COptionMenu* COptionMenu::getSubMenu (int32_t idx) const
 //------------------------------------------------------------------------
 int32_t COptionMenu::getCurrentIndex (bool countSeparator) const
 {
-	if (countSeparator)
+	// the indices of provided entries always include separators, no entry needs to be created
+	if (countSeparator || providedItems)
 		return currentIndex;
-	int32_t i = 0;
 	int32_t numSeparators = 0;
-	for (auto& item : *menuItems)
+	auto numEntries = getNbEntries ();
+	for (int32_t i = 0; i < numEntries; ++i)
 	{
-		if (item->isSeparator ())
+		auto item = getEntry (i);
+		if (item && item->isSeparator ())
 			numSeparators++;
 		if (i == currentIndex)
 			break;
-		i++;
 	}
 	return currentIndex - numSeparators;
 }
@@ -690,7 +756,15 @@ int32_t COptionMenu::getCurrentIndex (bool countSeparator) const
 bool COptionMenu::setCurrent (int32_t index, bool countSeparator)
 {
 	CMenuItem* item = nullptr;
-	if (countSeparator)
+	if (providedItems)
+	{
+		if (index < 0 || index >= getNbEntries ())
+			return false;
+		currentIndex = index;
+		if (style & (kMultipleCheckStyle & ~kCheckStyle))
+			item = getEntry (currentIndex);
+	}
+	else if (countSeparator)
 	{
 		item = getEntry (index);
 		if (!item || item->isSeparator ())
@@ -699,14 +773,12 @@ bool COptionMenu::setCurrent (int32_t index, bool countSeparator)
 	}
 	else
 	{
-		int32_t i = 0;
-		for (auto& item : *menuItems)
+		auto numEntries = getNbEntries ();
+		for (int32_t i = 0; i < numEntries && i <= index; ++i)
 		{
-			if (i > index)
-				break;
-			if (item->isSeparator ())
+			auto entry = getEntry (i);
+			if (entry && entry->isSeparator ())
 				index++;
-			i++;
 		}
 		currentIndex = index;
 		item = getEntry (currentIndex);
@@ -723,6 +795,8 @@ bool COptionMenu::setCurrent (int32_t index, bool countSeparator)
 //------------------------------------------------------------------------
 bool COptionMenu::removeEntry (int32_t index)
 {
+	if (providedItems)
+		return false;
 	if (index < 0 || menuItems->empty () || index >= getNbEntries ())
 		return false;
 	menuItems->erase (menuItems->begin () + index);
@@ -733,6 +807,7 @@ bool COptionMenu::removeEntry (int32_t index)
 bool COptionMenu::removeAllEntry ()
 {
 	menuItems->clear ();
+	providedItems = nullptr;
 	return true;
 }
 
@@ -751,12 +826,9 @@ bool COptionMenu::checkEntry (int32_t index, bool state)
 //------------------------------------------------------------------------
 bool COptionMenu::checkEntryAlone (int32_t index)
 {
-	int32_t pos = 0;
-	for (auto& item : *menuItems)
-	{
-		item->setChecked (pos == index);
-		pos++;
-	}
+	if (providedItems)
+		providedItems->checkedIndex = index;
+	forEachCreatedEntry ([index] (int32_t pos, CMenuItem* item) { item->setChecked (pos == index); });
 	return true;
 }
 
@@ -7,12 +7,14 @@
 
 #include "cparamdisplay.h"
 #include "icommandmenuitemtarget.h"
+#include "ioptionmenuitemprovider.h"
 #include "ioptionmenulistener.h"
 #include "../cstring.h"
 #include "../dispatchlist.h"
 #include "../cbitmap.h"
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace VSTGUI {
 
@@ -324,6 +326,16 @@ public:
 	/** remove separators as first and last item and double separators */
 	void cleanupSeparators (bool deep);
 
+	/** create the entries on demand via an item provider.
+	 *
+	 *	Removes all existing entries. While a provider is set, the entries are owned by the menu
+	 *	once created and single entries can not be added or removed. Setting the provider again
+	 *	discards the created entries, e.g. after the number of items changed. The current index is
+	 *	stored as is, getCurrentIndex and setCurrent do not skip separators of provided entries.
+	 */
+	void setItemProvider (IOptionMenuItemProvider* provider);
+	IOptionMenuItemProvider* getItemProvider () const;
+
 	void registerOptionMenuListener (IOptionMenuListener* listener);
 	void unregisterOptionMenuListener (IOptionMenuListener* listener);
 	//@}
@@ -333,7 +345,7 @@ public:
 	void setMin (float val) override {}
 	float getMin () const override { return 0; }
 	void setMax (float val) override {}
-	float getMax () const override { return (float)(menuItems->size () - 1); }
+	float getMax () const override { return (float)(getNbEntries () - 1); }
 
 	void draw (CDrawContext* pContext) override;
 	CMouseEventResult onMouseDown (CPoint& where, const CButtonState& buttons) override;
@@ -349,8 +361,12 @@ protected:
 	bool doPopup ();
 	void beforePopup ();
 	void afterPopup ();
+	/** iterate the existing entries, with an item provider only the already created ones */
+	void forEachCreatedEntry (const std::function<void (int32_t index, CMenuItem* item)>& proc) const;
 
 	CMenuItemList* menuItems;
+	struct ProvidedItems;
+	std::unique_ptr<ProvidedItems> providedItems;
 
 	bool inPopup {false};
 	int32_t currentIndex {-1};
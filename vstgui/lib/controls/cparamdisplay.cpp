@@ -182,17 +182,20 @@ void CParamDisplay::draw (CDrawContext *pContext)
 	bool converted = false;
 	if (valueToStringFunction)
 		converted = valueToStringFunction (value, string, this);
-	if (!converted)
+	if (converted)
 	{
-		char tmp[255];
-		char precisionStr[10];
-		sprintf (precisionStr, "%%.%hhuf", valuePrecision);
-		sprintf (tmp, precisionStr, value);
-		string = tmp;
+		displayText = string;
+	}
+	else
+	{
+		char tmp[64];
+		formatFixed (tmp, sizeof (tmp), value, valuePrecision);
+		displayText = tmp;
 	}
 
 	drawBack (pContext);
-	drawPlatformText (pContext, UTF8String (string).getPlatformString ());
+	// an unchanged text keeps its platform string and with it the cached text shaping
+	drawPlatformText (pContext, displayText.getPlatformString ());
 	setDirty (false);
 }
 
@@ -8,6 +8,7 @@
 #include "ccontrol.h"
 #include "../cfont.h"
 #include "../ccolor.h"
+#include "../cstring.h"
 #include "../cdrawdefs.h"
 #include <functional>
 
@@ -149,6 +150,9 @@ protected:
 	CCoord		roundRectRadius;
 	CCoord		frameWidth;
 	double		textRotation;
+
+private:
+	UTF8String	displayText;
 };
 
 } // namespace
@@ -105,11 +105,8 @@ void CTextEdit::setValue (float val)
 		converted = valueToStringFunction (getValue (), string, this);
 	if (!converted)
 	{
-		char tmp[255];
-		char precisionStr[10];
-		sprintf (precisionStr, "%%.%hhuf", valuePrecision);
-		sprintf (tmp, precisionStr, getValue ());
-		string = tmp;
+		char tmp[64];
+		string.assign (tmp, formatFixed (tmp, sizeof (tmp), getValue (), valuePrecision));
 	}
 
 	if (converted)
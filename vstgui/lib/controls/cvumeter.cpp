@@ -6,7 +6,8 @@
 #include "../coffscreencontext.h"
 #include "../cbitmap.h"
 #include "../cvstguitimer.h"
-#include <list>
+#include "../cframe.h"
+#include <algorithm>
 
 namespace VSTGUI {
 
@@ -46,6 +47,7 @@ CVuMeter::CVuMeter (const CVuMeter& v)
 , nbLed (v.nbLed)
 , style (v.style)
 , decreaseValue (v.decreaseValue)
+, peakHoldTime (v.peakHoldTime)
 , rectOn (v.rectOn)
 , rectOff (v.rectOff)
 {
@@ -102,8 +104,66 @@ void CVuMeter::setDirty (bool state)
 //------------------------------------------------------------------------
 void CVuMeter::onIdle ()
 {
-	if (getOldValue () != value)
-		invalid ();
+	if (auto frame = getFrame ())
+	{
+		if (advance (frame->getTicks ()))
+			invalid ();
+	}
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::advance (uint32_t ticks)
+{
+	float queuedValue;
+	if (valueQueue.pop (queuedValue))
+	{
+		float maxValue = queuedValue;
+		while (valueQueue.pop (queuedValue))
+			maxValue = std::max (maxValue, queuedValue);
+		value = maxValue;
+	}
+	bounceValue ();
+
+	float meterValue = ticksValid ? getOldValue () : value;
+	if (ticksValid)
+	{
+		uint32_t sincePeak = ticks - peakTicks;
+		if (sincePeak > peakHoldTime)
+		{
+			uint32_t fallTime = std::min (ticks - lastTicks, sincePeak - peakHoldTime);
+			meterValue -= decreaseValue * static_cast<float> (fallTime) *
+			              static_cast<float> (getIdleRate ()) / 1000.f;
+		}
+	}
+	if (meterValue <= value)
+	{
+		meterValue = value;
+		peakTicks = ticks;
+	}
+	lastTicks = ticks;
+	ticksValid = true;
+	setOldValue (meterValue);
+
+	auto newLitLeds = calcLitLedCount ((meterValue - getMin ()) / getRange ());
+	if (newLitLeds == litLeds)
+		return false;
+	litLeds = newLitLeds;
+	return true;
+}
+
+//------------------------------------------------------------------------
+int32_t CVuMeter::calcLitLedCount (float normValue) const
+{
+	auto count = static_cast<int32_t> (nbLed * normValue + 0.5f);
+	return std::min (std::max (count, 0), nbLed);
+}
+
+//------------------------------------------------------------------------
+int32_t CVuMeter::getLitLedCount () const
+{
+	if (litLeds >= 0)
+		return litLeds;
+	return calcLitLedCount ((getOldValue () - getMin ()) / getRange ());
 }
 
 //------------------------------------------------------------------------
@@ -118,18 +178,14 @@ void CVuMeter::draw (CDrawContext *_pContext)
 	CPoint pointOff;
 	CDrawContext *pContext = _pContext;
 
-	bounceValue ();
-	
-	float newValue = getOldValue () - decreaseValue;
-	if (newValue < value)
-		newValue = value;
-	setOldValue (newValue);
+	if (nbLed <= 0)
+		return;
 
-	newValue = (newValue - getMin ()) / getRange (); // normalize
+	auto lit = getLitLedCount ();
 	
 	if (style & kHorizontal) 
 	{
-		auto tmp = (CCoord)(((int32_t)(nbLed * newValue + 0.5f) / (float)nbLed) * getOnBitmap ()->getWidth ());
+		auto tmp = (CCoord)((lit / (float)nbLed) * getOnBitmap ()->getWidth ());
 		pointOff (tmp, 0);
 
 		_rectOff.left += tmp;
@@ -137,7 +193,7 @@ void CVuMeter::draw (CDrawContext *_pContext)
 	}
 	else 
 	{
-		auto tmp = (CCoord)(((int32_t)(nbLed * (1.f - newValue) + 0.5f) / (float)nbLed) * getOnBitmap ()->getHeight ());
+		auto tmp = (CCoord)(((nbLed - lit) / (float)nbLed) * getOnBitmap ()->getHeight ());
 		pointOn (0, tmp);
 
 		_rectOff.bottom = tmp + rectOff.top;
@@ -154,4 +210,32 @@ void CVuMeter::draw (CDrawContext *_pContext)
 	setDirty (false);
 }
 
+//------------------------------------------------------------------------
+bool CVuMeter::ValueQueue::push (float value)
+{
+	auto pos = writePos.load (std::memory_order_relaxed);
+	if (pos - readPos.load (std::memory_order_acquire) >= kCapacity)
+		return false;
+	values[pos & kMask] = value;
+	writePos.store (pos + 1, std::memory_order_release);
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::ValueQueue::pop (float& value)
+{
+	auto pos = readPos.load (std::memory_order_relaxed);
+	if (pos == writePos.load (std::memory_order_acquire))
+		return false;
+	value = values[pos & kMask];
+	readPos.store (pos + 1, std::memory_order_release);
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::ValueQueue::empty () const
+{
+	return readPos.load (std::memory_order_acquire) == writePos.load (std::memory_order_acquire);
+}
+
 } // namespace
@@ -6,6 +6,8 @@
 #define __cvumeter__
 
 #include "ccontrol.h"
+#include <array>
+#include <atomic>
 
 namespace VSTGUI {
 
@@ -29,6 +31,33 @@ public:
 		kVertical = 1 << StyleVertical,
 	};
 
+	//-----------------------------------------------------------------------------
+	/** Lock-free single producer, single consumer value queue.
+	 *
+	 *	The producer (i.e. the audio thread) pushes values without allocating or locking, the meter
+	 *	drains the queue on the UI thread and uses the maximum of all values pushed since the last
+	 *	update.
+	 */
+	class ValueQueue
+	{
+	public:
+		static constexpr uint32_t kCapacity = 64;
+
+		/** push a value. Only call from the producer thread. Returns false if the queue is full */
+		bool push (float value);
+		/** pop a value. Only call from the consumer thread. Returns false if the queue is empty */
+		bool pop (float& value);
+		/** returns true if the queue is empty */
+		bool empty () const;
+
+	private:
+		static constexpr uint32_t kMask = kCapacity - 1;
+
+		std::array<float, kCapacity> values;
+		std::atomic<uint32_t> readPos {0};
+		std::atomic<uint32_t> writePos {0};
+	};
+
 	CVuMeter (const CRect& size, CBitmap* onBitmap, CBitmap* offBitmap, int32_t nbLed, int32_t style = kVertical);
 	CVuMeter (const CVuMeter& vuMeter);
   
@@ -36,16 +65,34 @@ public:
 	/// @name CVuMeter Methods
 	//-----------------------------------------------------------------------------
 	//@{
+	/** the amount the meter falls per idle interval (1 / getIdleRate () seconds) */
 	float getDecreaseStepValue () const { return decreaseValue; }
 	virtual void setDecreaseStepValue (float value) { decreaseValue = value; }
 
+	/** time in milliseconds the peak is held before it starts to fall */
+	uint32_t getPeakHoldTime () const { return peakHoldTime; }
+	void setPeakHoldTime (uint32_t milliseconds) { peakHoldTime = milliseconds; }
+
+	/** the queue to feed values from a non UI thread */
+	ValueQueue& getValueQueue () { return valueQueue; }
+
+	/** advance the meter to the time ticks (in milliseconds).
+	 *
+	 *	Drains the value queue and applies peak hold and fall off depending on the time passed
+	 *	since the last call. Returns true if the number of lit LEDs changed.
+	 *	Called from onIdle with the frame's ticks.
+	 */
+	bool advance (uint32_t ticks);
+	/** returns the number of LEDs currently lit */
+	int32_t getLitLedCount () const;
+
 	virtual CBitmap* getOnBitmap () const { return getBackground (); }
 	virtual CBitmap* getOffBitmap () const { return offBitmap; }
 	virtual void setOnBitmap (CBitmap* bitmap) { setBackground (bitmap); }
 	virtual void setOffBitmap (CBitmap* bitmap);
 	
 	int32_t getNbLed () const { return nbLed; }
-	void setNbLed (int32_t nb) { nbLed = nb; invalid (); }
+	void setNbLed (int32_t nb) { nbLed = nb; litLeds = -1; invalid (); }
 	
 	void setStyle (int32_t newStyle) { style = newStyle; invalid (); }
 	int32_t getStyle () const { return style; }
@@ -63,12 +110,21 @@ public:
 protected:
 	~CVuMeter () noexcept override;	
 
+	int32_t calcLitLedCount (float normValue) const;
+
 	CBitmap* offBitmap;
 	
 	int32_t     nbLed;
 	int32_t     style;
 	float    decreaseValue;
 
+	uint32_t peakHoldTime {0};
+	uint32_t lastTicks {0};
+	uint32_t peakTicks {0};
+	int32_t litLeds {-1};
+	bool ticksValid {false};
+	ValueQueue valueQueue;
+
 	CRect    rectOn;
 	CRect    rectOff;
 };
@@ -0,0 +1,27 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../vstguifwd.h"
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** Option menu item provider
+ *
+ *	Provides the entries of an option menu on demand. Useful for menus with thousands of entries,
+ *	as only the entries which are actually shown or accessed are created.
+ */
+class IOptionMenuItemProvider : public virtual IReference
+{
+public:
+	/** number of entries of the menu */
+	virtual int32_t getNumItems () const = 0;
+	/** create the entry at index, the option menu takes ownership of the returned item */
+	virtual CMenuItem* createItem (int32_t index) = 0;
+};
+
+//------------------------------------------------------------------------
+} // VSTGUI
@@ -4,17 +4,191 @@
 
 #include "cshadowviewcontainer.h"
 #include "coffscreencontext.h"
-#include "cbitmapfilter.h"
 #include "cframe.h"
 #include "cbitmap.h"
+#include "platform/iplatformbitmap.h"
 #include <cassert>
 #include <array>
+#include <algorithm>
+#include <future>
 
 namespace VSTGUI {
 
+//-----------------------------------------------------------------------------
+template <size_t numBoxes>
+static std::array<int32_t, numBoxes> boxesForGauss (double sigma)
+{
+	std::array<int32_t, numBoxes> boxes;
+	double ideal = std::sqrt ((12 * sigma * sigma / numBoxes) + 1);
+	uint16_t l = static_cast<uint16_t> (std::floor (ideal));
+	if (l % 2 == 0)
+		l--;
+	int32_t u = l + 2;
+	ideal = ((12. * sigma * sigma) - (numBoxes * l * l) - (4. * numBoxes * l) - (3. * numBoxes)) / ((-4. * l) - 4.);
+	int32_t m = static_cast<int32_t> (std::floor (ideal));
+	for (int32_t i = 0; i < numBoxes; ++i)
+		boxes[i] = (i < m ? l : u);
+	return boxes;
+}
+
+//-----------------------------------------------------------------------------
+CShadowMask::CShadowMask (uint32_t width, uint32_t height)
+: data (width * height, 0)
+, width (width)
+, height (height)
+{
+}
+
+//-----------------------------------------------------------------------------
+CShadowMask CShadowMask::copyRect (const CRect& rect) const
+{
+	auto left = static_cast<uint32_t> (rect.left);
+	auto top = static_cast<uint32_t> (rect.top);
+	CShadowMask result (static_cast<uint32_t> (rect.getWidth ()),
+	                    static_cast<uint32_t> (rect.getHeight ()));
+	vstgui_assert (left + result.width <= width && top + result.height <= height);
+	for (uint32_t y = 0; y < result.height; ++y)
+		std::copy_n (getRow (top + y) + left, result.width, result.getRow (y));
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t CShadowMask::blurExtent (double sigma)
+{
+	uint32_t extent = 0;
+	for (auto box : boxesForGauss<3> (sigma))
+	{
+		if (box > 1)
+			extent += static_cast<uint32_t> (box / 2);
+	}
+	return extent;
+}
+
+//-----------------------------------------------------------------------------
+void CShadowMask::blur (double sigma)
+{
+	if (data.empty ())
+		return;
+	std::vector<uint8_t> tmp (data.size ());
+	std::vector<int32_t> sums (width);
+	for (auto box : boxesForGauss<3> (sigma))
+	{
+		int32_t radius = box / 2;
+		if (radius < 1)
+			continue;
+		int32_t div = radius * 2 + 1;
+		// horizontal pass into tmp, a running sum over [x - radius, x + radius]
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			const uint8_t* src = getRow (y);
+			uint8_t* dst = tmp.data () + y * width;
+			int32_t sum = 0;
+			for (int32_t x = 0; x < radius && x < static_cast<int32_t> (width); ++x)
+				sum += src[x];
+			for (int32_t x = 0; x < static_cast<int32_t> (width); ++x)
+			{
+				if (x + radius < static_cast<int32_t> (width))
+					sum += src[x + radius];
+				dst[x] = static_cast<uint8_t> ((sum + radius) / div);
+				if (x - radius >= 0)
+					sum -= src[x - radius];
+			}
+		}
+		// vertical pass back into data, running sums of all columns at once
+		std::fill (sums.begin (), sums.end (), 0);
+		for (int32_t y = 0; y < radius && y < static_cast<int32_t> (height); ++y)
+		{
+			const uint8_t* src = tmp.data () + y * width;
+			for (uint32_t x = 0; x < width; ++x)
+				sums[x] += src[x];
+		}
+		for (int32_t y = 0; y < static_cast<int32_t> (height); ++y)
+		{
+			if (y + radius < static_cast<int32_t> (height))
+			{
+				const uint8_t* add = tmp.data () + (y + radius) * width;
+				for (uint32_t x = 0; x < width; ++x)
+					sums[x] += add[x];
+			}
+			uint8_t* dst = getRow (static_cast<uint32_t> (y));
+			for (uint32_t x = 0; x < width; ++x)
+				dst[x] = static_cast<uint8_t> ((sums[x] + radius) / div);
+			if (y - radius >= 0)
+			{
+				const uint8_t* sub = tmp.data () + (y - radius) * width;
+				for (uint32_t x = 0; x < width; ++x)
+					sums[x] -= sub[x];
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+static uint32_t alphaByteIndex (IPlatformBitmapPixelAccess::PixelFormat format)
+{
+	switch (format)
+	{
+		case IPlatformBitmapPixelAccess::kARGB:
+		case IPlatformBitmapPixelAccess::kABGR:
+			return 0;
+		case IPlatformBitmapPixelAccess::kRGBA:
+		case IPlatformBitmapPixelAccess::kBGRA:
+			break;
+	}
+	return 3;
+}
+
+//-----------------------------------------------------------------------------
+struct CShadowViewContainer::ShadowCache
+{
+	double scaleFactor;
+	/** pixels per point of the mask and the shadow bitmap */
+	double maskScale;
+	/** the unblurred alpha of the subviews */
+	CShadowMask mask;
+	SharedPointer<CBitmap> bitmap;
+};
+
+//-----------------------------------------------------------------------------
+struct CShadowViewContainer::Impl
+{
+	struct BlurJob
+	{
+		double scaleFactor;
+		uint32_t generation;
+		/** rect of the blurred mask in the shadow mask */
+		CRect inputRect;
+		/** rect of the shadow which is updated from the blurred mask */
+		CRect outputRect;
+		std::future<CShadowMask> result;
+	};
+
+	std::vector<ShadowCache> caches;
+	std::unique_ptr<BlurJob> job;
+	/** rect of changed subviews in local coordinates */
+	CRect dirtyRect;
+	uint32_t generation {0};
+
+	ShadowCache* findCache (double scaleFactor)
+	{
+		auto it = std::find_if (caches.begin (), caches.end (), [&] (const ShadowCache& cache) {
+			return cache.scaleFactor == scaleFactor;
+		});
+		return it != caches.end () ? &(*it) : nullptr;
+	}
+
+	void clear ()
+	{
+		caches.clear ();
+		dirtyRect = CRect ();
+		++generation;
+	}
+};
+
 //-----------------------------------------------------------------------------
 CShadowViewContainer::CShadowViewContainer (const CRect& size)
 : CViewContainer (size)
+, impl (new Impl)
 , dontDrawBackground (false)
 , shadowIntensity (0.3f)
 , shadowBlurSize (4)
@@ -26,6 +200,7 @@ CShadowViewContainer::CShadowViewContainer (const CRect& size)
 //-----------------------------------------------------------------------------
 CShadowViewContainer::CShadowViewContainer (const CShadowViewContainer& copy)
 : CViewContainer (copy)
+, impl (new Impl)
 , dontDrawBackground (false)
 , shadowIntensity (copy.shadowIntensity)
 , shadowBlurSize (copy.shadowBlurSize)
@@ -49,6 +224,8 @@ bool CShadowViewContainer::removed (CView* parent)
 {
 	getFrame ()->unregisterScaleFactorChangedListeneer (this);
 	setBackground (nullptr);
+	impl->clear ();
+	scaleFactorUsed = 0.;
 	return CViewContainer::removed (parent);
 }
 
@@ -67,7 +244,7 @@ bool CShadowViewContainer::attached (CView* parent)
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::onScaleFactorChanged (CFrame* frame, double newScaleFactor)
 {
-	invalidateShadow ();
+	invalid ();
 }
 
 //-----------------------------------------------------------------------------
@@ -101,35 +278,39 @@ void CShadowViewContainer::setShadowBlurSize (double size)
 }
 
 //-----------------------------------------------------------------------------
+/** The current shadow stays visible until the new one is ready. */
 void CShadowViewContainer::invalidateShadow ()
 {
+	impl->clear ();
 	scaleFactorUsed = 0.;
 	invalid ();
 }
 
 //-----------------------------------------------------------------------------
-CMessageResult CShadowViewContainer::notify (CBaseObject* sender, IdStringPtr message)
+void CShadowViewContainer::invalidRect (const CRect& rect)
 {
-	if (message == kMsgViewSizeChanged)
-		invalidateShadow ();
-	return CViewContainer::notify(sender, message);
+	// only subviews call this, the container itself invalidates via its parent
+	if (!dontDrawBackground && !impl->caches.empty ())
+	{
+		CRect r (rect);
+		getTransform ().transform (r);
+		impl->dirtyRect = impl->dirtyRect.isEmpty () ? r : impl->dirtyRect.unite (r);
+		// the cached shadows of other scale factors can not be updated incrementally
+		impl->caches.erase (std::remove_if (impl->caches.begin (), impl->caches.end (),
+		                                    [this] (const ShadowCache& cache) {
+			                                    return cache.scaleFactor != scaleFactorUsed;
+		                                    }),
+		                    impl->caches.end ());
+	}
+	CViewContainer::invalidRect (rect);
 }
 
 //-----------------------------------------------------------------------------
-template <size_t numBoxes>
-static std::array<int32_t, numBoxes> boxesForGauss (double sigma)
+CMessageResult CShadowViewContainer::notify (CBaseObject* sender, IdStringPtr message)
 {
-	std::array<int32_t, numBoxes> boxes;
-	double ideal = std::sqrt ((12 * sigma * sigma / numBoxes) + 1);
-	uint16_t l = static_cast<uint16_t> (std::floor (ideal));
-	if (l % 2 == 0)
-		l--;
-	int32_t u = l + 2;
-	ideal = ((12. * sigma * sigma) - (numBoxes * l * l) - (4. * numBoxes * l) - (3. * numBoxes)) / ((-4. * l) - 4.);
-	int32_t m = static_cast<int32_t> (std::floor (ideal));
-	for (int32_t i = 0; i < numBoxes; ++i)
-		boxes[i] = (i < m ? l : u);
-	return boxes;
+	if (message == kMsgViewSizeChanged)
+		invalidateShadow ();
+	return CViewContainer::notify(sender, message);
 }
 
 //-----------------------------------------------------------------------------
@@ -149,60 +330,207 @@ void CShadowViewContainer::drawRect (CDrawContext* pContext, const CRect& update
 		if (matrixScale != 0.)
 			scaleFactor *= matrixScale;
 	}
-	if (scaleFactor != scaleFactorUsed && getWidth () > 0. && getHeight () > 0.)
+	if (getWidth () > 0. && getHeight () > 0.)
+		updateShadow (scaleFactor);
+	CViewContainer::drawRect (pContext, updateRect);
+}
+
+//-----------------------------------------------------------------------------
+/** Generates the shadow for scaleFactor or updates the part of the subviews which changed.
+ *
+ *	The alpha of the subviews is rendered on the UI thread, the blur runs on a worker thread and
+ *	its result is copied into the shadow bitmap on idle. If no shadow is visible yet, the blur is
+ *	waited for so that the container does not appear without its shadow.
+ */
+void CShadowViewContainer::updateShadow (double scaleFactor)
+{
+	finishShadowBlur (false);
+	if (impl->job)
+		return;
+	auto cache = impl->findCache (scaleFactor);
+	if (cache == nullptr)
 	{
-		scaleFactorUsed = scaleFactor;
-		CCoord width = getWidth ();
-		CCoord height = getHeight ();
-		
-		if (auto offscreenContext = COffscreenContext::create (getFrame (), width, height, scaleFactor))
+		// a wide blur removes all details, so the shadow is generated with half the resolution
+		auto maskScale = shadowBlurSize * scaleFactor >= 8. ? scaleFactor * 0.5 : scaleFactor;
+		auto bitmap = makeOwned<CBitmap> (CPoint (getWidth (), getHeight ()), maskScale);
+		auto platformBitmap = bitmap->getPlatformBitmap ();
+		if (!platformBitmap)
+			return;
+		auto pixelSize = platformBitmap->getSize ();
+		ShadowCache newCache {scaleFactor, maskScale,
+		                      CShadowMask (static_cast<uint32_t> (pixelSize.x),
+		                                   static_cast<uint32_t> (pixelSize.y)),
+		                      bitmap};
+		impl->caches.emplace_back (std::move (newCache));
+		cache = &impl->caches.back ();
+		CRect maskRect (0, 0, pixelSize.x, pixelSize.y);
+		if (renderShadowMask (*cache, maskRect))
 		{
-			offscreenContext->beginDraw ();
-			CDrawContext::Transform transform (*offscreenContext, CGraphicsTransform ().translate (-getViewSize ().left - shadowOffset.x, -getViewSize ().top - shadowOffset.y));
-			dontDrawBackground = true;
-			CViewContainer::draw (offscreenContext);
-			dontDrawBackground = false;
-			offscreenContext->endDraw ();
-			CBitmap* bitmap = offscreenContext->getBitmap ();
-			if (bitmap)
-			{
-				setBackground (bitmap);
-				SharedPointer<BitmapFilter::IFilter> setColorFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kSetColor));
-				if (setColorFilter)
-				{
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputColor, kBlackCColor);
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kIgnoreAlphaColorValue, (int32_t)1);
-					if (setColorFilter->run (true))
-					{
-						SharedPointer<BitmapFilter::IFilter> boxBlurFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kBoxBlur));
-						if (boxBlurFilter)
-						{
-							auto boxSizes = boxesForGauss<3> (shadowBlurSize);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[0]);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kAlphaChannelOnly, 1);
-							if (boxBlurFilter->run (true))
-							{
-								boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[1]);
-								boxBlurFilter->run (true);
-								boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[2]);
-								boxBlurFilter->run (true);
-							}
-						}
-					}
-				}
-
-				CViewContainer::drawRect (pContext, updateRect);
-			}
+			startShadowBlur (*cache, maskRect);
+			if (getBackground () == nullptr)
+				finishShadowBlur (true);
 		}
+		impl->dirtyRect = CRect ();
+		return;
+	}
+	if (scaleFactor != scaleFactorUsed)
+	{
+		setBackground (cache->bitmap);
+		scaleFactorUsed = scaleFactor;
+	}
+	if (!impl->dirtyRect.isEmpty ())
+	{
+		CRect maskRect (impl->dirtyRect);
+		maskRect.offset (-shadowOffset.x, -shadowOffset.y);
+		maskRect.left = std::floor (maskRect.left * cache->maskScale);
+		maskRect.top = std::floor (maskRect.top * cache->maskScale);
+		maskRect.right = std::ceil (maskRect.right * cache->maskScale);
+		maskRect.bottom = std::ceil (maskRect.bottom * cache->maskScale);
+		maskRect.bound (CRect (0, 0, cache->mask.getWidth (), cache->mask.getHeight ()));
+		impl->dirtyRect = CRect ();
+		if (!maskRect.isEmpty () && renderShadowMask (*cache, maskRect))
+			startShadowBlur (*cache, maskRect);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/** render the alpha of the subviews for maskRect (in mask pixels) into the mask of the cache */
+bool CShadowViewContainer::renderShadowMask (ShadowCache& cache, const CRect& maskRect)
+{
+	auto maskScale = cache.maskScale;
+	// offscreen contexts are at least one point wide, only the pixels of maskRect are used
+	CPoint size (std::max (1., maskRect.getWidth () / maskScale),
+	             std::max (1., maskRect.getHeight () / maskScale));
+	auto offscreen = COffscreenContext::create (getFrame (), size.x, size.y, maskScale);
+	if (!offscreen)
+		return false;
+	CPoint origin (maskRect.left / maskScale + shadowOffset.x, maskRect.top / maskScale + shadowOffset.y);
+	CRect updateRect (origin, size);
+	updateRect.offset (getViewSize ().left, getViewSize ().top);
+	offscreen->beginDraw ();
+	{
+		CDrawContext::Transform transform (*offscreen, CGraphicsTransform ().translate (-updateRect.left, -updateRect.top));
+		dontDrawBackground = true;
+		CViewContainer::drawRect (offscreen, updateRect);
+		dontDrawBackground = false;
+	}
+	offscreen->endDraw ();
+
+	auto bitmap = offscreen->getBitmap ();
+	auto platformBitmap = bitmap ? bitmap->getPlatformBitmap () : nullptr;
+	auto pixelAccess = platformBitmap ? platformBitmap->lockPixels (true) : nullptr;
+	if (!pixelAccess)
+		return false;
+	auto alphaIndex = alphaByteIndex (pixelAccess->getPixelFormat ());
+	auto left = static_cast<uint32_t> (maskRect.left);
+	auto top = static_cast<uint32_t> (maskRect.top);
+	auto width = std::min (static_cast<uint32_t> (maskRect.getWidth ()), static_cast<uint32_t> (platformBitmap->getSize ().x));
+	auto height = std::min (static_cast<uint32_t> (maskRect.getHeight ()), static_cast<uint32_t> (platformBitmap->getSize ().y));
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		const uint8_t* src = pixelAccess->getAddress () + y * pixelAccess->getBytesPerRow () + alphaIndex;
+		uint8_t* dst = cache.mask.getRow (top + y) + left;
+		for (uint32_t x = 0; x < width; ++x, src += 4)
+			dst[x] = *src;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/** blur the part of the mask which affects the shadow around maskRect on a worker thread */
+void CShadowViewContainer::startShadowBlur (ShadowCache& cache, const CRect& maskRect)
+{
+	auto sigma = shadowBlurSize * cache.maskScale;
+	auto extent = static_cast<CCoord> (CShadowMask::blurExtent (sigma));
+	CRect bounds (0, 0, cache.mask.getWidth (), cache.mask.getHeight ());
+	CRect outputRect (maskRect);
+	outputRect.extend (extent, extent);
+	outputRect.bound (bounds);
+	// the blur of the output rect needs the mask of the extent around it
+	CRect inputRect (outputRect);
+	inputRect.extend (extent, extent);
+	inputRect.bound (bounds);
+
+	auto job = std::unique_ptr<Impl::BlurJob> (new Impl::BlurJob);
+	job->scaleFactor = cache.scaleFactor;
+	job->generation = impl->generation;
+	job->inputRect = inputRect;
+	job->outputRect = outputRect;
+	job->result = std::async (std::launch::async, [] (CShadowMask mask, double sigma) {
+		mask.blur (sigma);
+		return mask;
+	}, cache.mask.copyRect (inputRect), sigma);
+	impl->job = std::move (job);
+	setWantsIdle (true);
+}
+
+//-----------------------------------------------------------------------------
+/** copy the result of a finished blur into the shadow bitmap */
+void CShadowViewContainer::finishShadowBlur (bool wait)
+{
+	if (!impl->job)
+		return;
+	if (!wait && impl->job->result.wait_for (std::chrono::seconds (0)) != std::future_status::ready)
+		return;
+	auto job = std::move (impl->job);
+	setWantsIdle (false);
+	auto blurred = job->result.get ();
+	auto cache = impl->findCache (job->scaleFactor);
+	if (cache == nullptr || job->generation != impl->generation)
+	{
+		// the shadow was invalidated while blurring, generate the new one
+		invalid ();
+		return;
+	}
+	auto platformBitmap = cache->bitmap->getPlatformBitmap ();
+	auto pixelAccess = platformBitmap ? platformBitmap->lockPixels (true) : nullptr;
+	if (!pixelAccess)
+		return;
+	// the shadow is black, with premultiplied alpha only the alpha byte is not zero
+	auto alphaIndex = alphaByteIndex (pixelAccess->getPixelFormat ());
+	auto left = static_cast<uint32_t> (job->outputRect.left);
+	auto top = static_cast<uint32_t> (job->outputRect.top);
+	auto srcLeft = left - static_cast<uint32_t> (job->inputRect.left);
+	auto srcTop = top - static_cast<uint32_t> (job->inputRect.top);
+	auto width = static_cast<uint32_t> (job->outputRect.getWidth ());
+	auto height = static_cast<uint32_t> (job->outputRect.getHeight ());
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		const uint8_t* src = blurred.getRow (srcTop + y) + srcLeft;
+		uint8_t* dst = pixelAccess->getAddress () + (top + y) * pixelAccess->getBytesPerRow () + left * 4;
+		std::fill_n (dst, width * 4, 0);
+		for (uint32_t x = 0; x < width; ++x)
+			dst[x * 4 + alphaIndex] = src[x];
+	}
+	pixelAccess = nullptr;
+
+	if (getBackground () != cache->bitmap)
+	{
+		setBackground (cache->bitmap);
+		scaleFactorUsed = cache->scaleFactor;
+		invalid ();
 	}
 	else
 	{
-		CViewContainer::drawRect (pContext, updateRect);
+		CRect r (job->outputRect);
+		r.left /= cache->maskScale;
+		r.top /= cache->maskScale;
+		r.right /= cache->maskScale;
+		r.bottom /= cache->maskScale;
+		r.extend (1, 1);
+		// bypass the own invalidRect, this is not a change of the subviews
+		r.offset (getViewSize ().left, getViewSize ().top);
+		if (auto parent = getParentView ())
+			parent->invalidRect (r);
 	}
 }
 
+//-----------------------------------------------------------------------------
+void CShadowViewContainer::onIdle ()
+{
+	finishShadowBlur (false);
+}
+
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::drawBackgroundRect (CDrawContext* pContext, const CRect& _updateRect)
 {
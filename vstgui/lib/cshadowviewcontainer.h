@@ -8,9 +8,40 @@
 #include "cviewcontainer.h"
 #include "iviewlistener.h"
 #include "iscalefactorchangedlistener.h"
+#include <memory>
+#include <vector>
 
 namespace VSTGUI {
 
+//-----------------------------------------------------------------------------
+/** @brief 8 bit alpha mask used to generate the shadow of CShadowViewContainer
+ *
+ *	Contains no platform resources, so it can be blurred on a worker thread.
+ */
+class CShadowMask
+{
+public:
+	CShadowMask () = default;
+	CShadowMask (uint32_t width, uint32_t height);
+
+	uint32_t getWidth () const { return width; }
+	uint32_t getHeight () const { return height; }
+	uint8_t* getRow (uint32_t y) { return data.data () + y * width; }
+	const uint8_t* getRow (uint32_t y) const { return data.data () + y * width; }
+
+	/** copy of the pixels inside rect, rect must be integral and inside the mask */
+	CShadowMask copyRect (const CRect& rect) const;
+	/** approximate a gaussian blur with three box blurs, pixels outside the mask are transparent */
+	void blur (double sigma);
+	/** number of pixels in each direction a blur with sigma reaches */
+	static uint32_t blurExtent (double sigma);
+
+private:
+	std::vector<uint8_t> data;
+	uint32_t width {0};
+	uint32_t height {0};
+};
+
 //-----------------------------------------------------------------------------
 // CShadowViewContainer Declaration
 //! @brief a view container which draws a shadow for it's subviews
@@ -45,6 +76,8 @@ public:
 	// override
 	bool removed (CView* parent) override;
 	bool attached (CView* parent) override;
+	void invalidRect (const CRect& rect) override;
+	void onIdle () override;
 	void drawRect (CDrawContext* pContext, const CRect& updateRect) override;
 	void drawBackgroundRect (CDrawContext* pContext, const CRect& _updateRect) override;
 	void setViewSize (const CRect& rect, bool invalid = true) override;
@@ -60,6 +93,14 @@ protected:
 
 	void beforeDelete () override;
 
+	struct Impl;
+	struct ShadowCache;
+	void updateShadow (double scaleFactor);
+	bool renderShadowMask (ShadowCache& cache, const CRect& maskRect);
+	void startShadowBlur (ShadowCache& cache, const CRect& maskRect);
+	void finishShadowBlur (bool wait);
+
+	std::unique_ptr<Impl> impl;
 	bool dontDrawBackground;
 	CPoint shadowOffset;
 	float shadowIntensity;
@@ -4,6 +4,7 @@
 
 #include "cstring.h"
 #include <cstring>
+#include <cstdio>
 #include <algorithm>
 
 namespace VSTGUI {
@@ -44,8 +45,12 @@ UTF8String::UTF8String (const UTF8String& other)
 //-----------------------------------------------------------------------------
 UTF8String& UTF8String::operator= (const UTF8String& str)
 {
+	if (this == &str)
+		return *this;
 	string = str.string;
-	platformString = str.platformString;
+	// the platform string references the storage of str and caches its shaping, it is not shared,
+	// so that copies can be used on different threads
+	platformString = nullptr;
 	return *this;
 }
 
@@ -132,8 +137,11 @@ void UTF8String::copy (UTF8StringBuffer dst, SizeType dstSize) const noexcept
 //-----------------------------------------------------------------------------
 IPlatformString* UTF8String::getPlatformString () const noexcept
 {
+	// the platform string may reference our storage, which moves with the string
 	if (platformString == nullptr)
-		platformString = IPlatformString::createWithUTF8String (data ());
+		platformString = IPlatformString::createWithUTF8StringReference (data (), length ());
+	else
+		platformString->updateUTF8StringReference (data (), length ());
 	return platformString;
 }
 
@@ -149,6 +157,20 @@ UTF8String::CodePointIterator UTF8String::end () const noexcept
 	return UTF8String::CodePointIterator (string.end ());
 }
 
+//-----------------------------------------------------------------------------
+size_t formatFixed (char* buffer, size_t bufferSize, double value, uint32_t precision) noexcept
+{
+	if (bufferSize == 0)
+		return 0;
+	auto result = snprintf (buffer, bufferSize, "%.*f", static_cast<int> (precision), value);
+	if (result < 0)
+	{
+		buffer[0] = 0;
+		return 0;
+	}
+	return std::min (static_cast<size_t> (result), bufferSize - 1);
+}
+
 //-----------------------------------------------------------------------------
 bool isSpace (char32_t character) noexcept
 {
@@ -58,6 +58,8 @@ private:
 /**
  *  @brief holds an UTF8 encoded string and a platform representation of it
  *
+ *  The platform representation is created on demand and not shared between copies. One
+ *  UTF8String must not be drawn or measured on different threads at the same time, copies can.
  */
 //-----------------------------------------------------------------------------
 class UTF8String
@@ -124,6 +126,17 @@ inline UTF8String toString (const T& value)
 	return UTF8String (std::to_string (value));
 }
 
+//-----------------------------------------------------------------------------
+/** format a floating point value with a fixed number of fraction digits into a preallocated
+ *	buffer, no heap allocation takes place
+ *	@param buffer destination, always zero terminated if bufferSize is not zero
+ *	@param bufferSize size of buffer in bytes
+ *	@param value value to format
+ *	@param precision number of fraction digits
+ *	@return number of characters written, excluding the terminating zero
+ */
+size_t formatFixed (char* buffer, size_t bufferSize, double value, uint32_t precision) noexcept;
+
 //-----------------------------------------------------------------------------
 /** white-character test
  *	@param character UTF-32 character
@@ -15,8 +15,10 @@
 #include "animation/animator.h"
 #include "../uidescription/icontroller.h"
 #include "platform/iplatformframe.h"
+#include <algorithm>
 #include <cassert>
 #include <unordered_map>
+#include <vector>
 #if DEBUG
 #include <list>
 #include <typeinfo>
@@ -93,6 +95,11 @@ protected:
 };
 
 //-----------------------------------------------------------------------------
+/** calls onIdle on all attached views which want idle and are effectively visible
+ *
+ *	The views are kept in a vector, an index map allows to remove them in constant time. Views
+ *	removed while the views are iterated are only cleared and the vector is compacted afterwards.
+ */
 class IdleViewUpdater
 {
 public:
@@ -100,45 +107,145 @@ public:
 	{
 		if (gInstance == nullptr)
 			gInstance = std::unique_ptr<IdleViewUpdater> (new IdleViewUpdater ());
-		gInstance->views.emplace_back (view);
+		gInstance->addView (view);
 	}
 	
 	static void remove (CView* view)
 	{
 		if (gInstance)
 		{
-			gInstance->views.remove (view);
-			if (!gInstance->inTimer && gInstance->views.empty ())
+			gInstance->removeView (view);
+			if (!gInstance->inTimer && gInstance->indices.empty ())
 			{
 				gInstance = nullptr;
 			}
 		}
 	}
+
+	static void idleRateChanged (CView* view)
+	{
+		if (gInstance)
+			gInstance->updateView (view);
+	}
 	
 protected:
-	using ViewContainer = std::list<CView*>;
-	
+	struct Entry
+	{
+		CView* view;
+		uint32_t period;
+		uint32_t nextTime;
+	};
+	using Entries = std::vector<Entry>;
+	using Indices = std::unordered_map<CView*, size_t>;
+
+	static uint32_t periodForView (CView* view)
+	{
+		return 1000 / std::max<uint32_t> (view->getIdleRate (), 1);
+	}
+
 	IdleViewUpdater ()
 	{
 		timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { onTimer (); }, 1000/CView::idleRate);
 	}
-	
+
+	void addView (CView* view)
+	{
+		if (indices.find (view) != indices.end ())
+			return;
+		auto period = periodForView (view);
+		indices.emplace (view, entries.size ());
+		entries.push_back ({view, period, IPlatformFrame::getTicks () + period});
+		if (period < timer->getFireTime ())
+			timer->setFireTime (period);
+	}
+
+	void removeView (CView* view)
+	{
+		auto it = indices.find (view);
+		if (it == indices.end ())
+			return;
+		auto index = it->second;
+		indices.erase (it);
+		if (inTimer)
+		{
+			entries[index].view = nullptr;
+			needsCompaction = true;
+			return;
+		}
+		if (index != entries.size () - 1)
+		{
+			entries[index] = entries.back ();
+			indices[entries[index].view] = index;
+		}
+		entries.pop_back ();
+	}
+
+	void updateView (CView* view)
+	{
+		auto it = indices.find (view);
+		if (it == indices.end ())
+			return;
+		auto& entry = entries[it->second];
+		entry.period = periodForView (view);
+		entry.nextTime = IPlatformFrame::getTicks () + entry.period;
+		updateTimer ();
+	}
+
+	void compact ()
+	{
+		entries.erase (std::remove_if (entries.begin (), entries.end (),
+		                               [] (const Entry& entry) { return entry.view == nullptr; }),
+		               entries.end ());
+		for (auto index = 0u; index < entries.size (); ++index)
+			indices[entries[index].view] = index;
+		needsCompaction = false;
+	}
+
+	void updateTimer ()
+	{
+		uint32_t period = 1000 / CView::idleRate;
+		for (const auto& entry : entries)
+		{
+			if (entry.view)
+				period = std::min (period, entry.period);
+		}
+		if (period != timer->getFireTime ())
+			timer->setFireTime (period);
+	}
+
 	void onTimer ()
 	{
 		inTimer = true;
-		for (ViewContainer::const_iterator it = views.begin (); it != views.end ();)
+		auto now = IPlatformFrame::getTicks ();
+		// a view is due when the next timer would fire later than half a timer period after it
+		auto tolerance = static_cast<int32_t> (timer->getFireTime () / 2);
+		// views added from onIdle are called on the next timer
+		auto numEntries = entries.size ();
+		for (auto index = 0u; index < numEntries; ++index)
 		{
-			CView* view = (*it);
-			++it;
-			view->onIdle ();
+			auto& entry = entries[index];
+			if (entry.view == nullptr || static_cast<int32_t> (now - entry.nextTime) < -tolerance)
+				continue;
+			entry.nextTime += entry.period;
+			if (static_cast<int32_t> (now - entry.nextTime) >= 0)
+				entry.nextTime = now + entry.period;
+			auto view = entry.view;
+			if (view->isEffectivelyVisible ())
+				view->onIdle ();
 		}
 		inTimer = false;
-		if (views.empty ())
+		if (needsCompaction)
+			compact ();
+		if (indices.empty ())
 			gInstance = nullptr;
+		else
+			updateTimer ();
 	}
 	SharedPointer<CVSTGUITimer> timer;
-	ViewContainer views;
+	Entries entries;
+	Indices indices;
 	bool inTimer {false};
+	bool needsCompaction {false};
 	
 	static std::unique_ptr<IdleViewUpdater> gInstance;
 };
@@ -188,6 +295,7 @@ struct CView::Impl
 	int32_t viewFlags {0};
 	int32_t autosizeFlags {kAutosizeNone};
 	float alphaValue {1.f};
+	uint32_t idleRate {0};
 	CFrame* parentFrame {nullptr};
 	CView* parentView {nullptr};
 	
@@ -369,6 +477,22 @@ void CView::setWantsIdle (bool state)
 		state ? CViewInternal::IdleViewUpdater::add (this) : CViewInternal::IdleViewUpdater::remove (this);
 }
 
+//-----------------------------------------------------------------------------
+void CView::setIdleRate (uint32_t rate)
+{
+	if (pImpl->idleRate == rate)
+		return;
+	pImpl->idleRate = rate;
+	if (wantsIdle () && isAttached ())
+		CViewInternal::IdleViewUpdater::idleRateChanged (this);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t CView::getIdleRate () const
+{
+	return pImpl->idleRate ? pImpl->idleRate : idleRate;
+}
+
 //-----------------------------------------------------------------------------
 void CView::setDirty (bool state)
 {
@@ -739,6 +863,19 @@ CRect CView::getVisibleViewSize () const
 	return CRect (0, 0, 0, 0);
 }
 
+//------------------------------------------------------------------------------
+bool CView::isEffectivelyVisible () const
+{
+	if (!isAttached () || getFrame () == nullptr)
+		return false;
+	for (const CView* view = this; view; view = view->getParentView ())
+	{
+		if (!view->isVisible ())
+			return false;
+	}
+	return !getVisibleViewSize ().isEmpty ();
+}
+
 //-----------------------------------------------------------------------------
 void CView::setVisible (bool state)
 {
@@ -81,6 +81,9 @@ public:
 	virtual void setVisible (bool state);
 	/** get visibility state */
 	bool isVisible () const { return hasViewFlag (kVisible) && getAlphaValue () > 0.f; }
+	/** returns true if the view is attached, it and all its parents are visible and it is not
+	 *	clipped away by its parents */
+	bool isEffectivelyVisible () const;
 	//@}
 
 	//-----------------------------------------------------------------------------
@@ -313,6 +316,10 @@ public:
 	void setWantsIdle (bool state);
 	/** returns if the view wants idle callback or not */
 	bool wantsIdle () const { return hasViewFlag (kWantsIdle); }
+	/** set the idle rate of this view in Hz, 0 uses the global idle rate */
+	void setIdleRate (uint32_t rate);
+	/** returns the idle rate of this view in Hz */
+	uint32_t getIdleRate () const;
 	/** global idle rate in Hz, defaults to 30 Hz*/
 	static uint32_t idleRate;
 	//@}
@@ -7,14 +7,15 @@
 #include "../../animation/animations.h"
 #include "../../animation/timingfunctions.h"
 #include "../../cdatabrowser.h"
+#include "../../cdrawcontext.h"
 #include "../../cfont.h"
 #include "../../cframe.h"
 #include "../../cgraphicspath.h"
 #include "../../clayeredviewcontainer.h"
-#include "../../coffscreencontext.h"
 #include "../../idatabrowserdelegate.h"
 #include "../../controls/coptionmenu.h"
 #include "../../controls/cscrollbar.h"
+#include "../iplatformfont.h"
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -53,19 +54,32 @@ public:
 		return std::ceil (theme.font->getSize () + 8);
 	}
 
-	CCoord calculateMaxWidth (CFrame* frame)
+	CCoord calculateMaxWidth ()
 	{
+		// large menus are measured from an evenly distributed sample of their entries, so that
+		// opening them does not depend on the number of entries
+		static constexpr int32_t kMaxMeasuredEntries = 256;
+
 		if (maxWidth >= 0.)
 			return maxWidth;
-		auto context = COffscreenContext::create (frame, 1, 1);
+		// the font painter measures without a draw context, no offscreen context is needed
+		auto platformFont = theme.font->getPlatformFont ();
+		auto painter = platformFont ? platformFont->getPainter () : nullptr;
 		maxWidth = 0.;
 		maxTitleWidth = 0.;
 		hasRightMargin = false;
-		for (auto& item : *menu->getItems ())
+		auto numEntries = menu->getNbEntries ();
+		auto numMeasured = std::min (numEntries, kMaxMeasuredEntries);
+		for (auto i = 0; i < numMeasured; ++i)
 		{
-			if (item->isSeparator ())
+			auto index = static_cast<int32_t> (static_cast<int64_t> (i) * numEntries / numMeasured);
+			auto item = menu->getEntry (index);
+			if (!item || item->isSeparator ())
 				continue;
-			auto width = context->getStringWidth (item->getTitle ());
+			CCoord width = 0.;
+			if (painter)
+				width = painter->getStringWidth (nullptr, item->getTitle ().getPlatformString (),
+												 true);
 			hasRightMargin |= item->getSubmenu () ? true : false;
 			hasRightMargin |= item->getIcon () ? true : false;
 			if (maxTitleWidth < width)
@@ -441,7 +455,7 @@ CView* setupGenericOptionMenu (Proc clickCallback, CViewContainer* container,
 	auto frame = container->getFrame ();
 	auto dataSource =
 	    makeOwned<DataSource> (container, optionMenu, clickCallback, theme, parentDataSource);
-	auto maxWidth = dataSource->calculateMaxWidth (frame);
+	auto maxWidth = dataSource->calculateMaxWidth ();
 	if (parentDataSource)
 	{
 		viewRect.offset (viewRect.getWidth (), 0);
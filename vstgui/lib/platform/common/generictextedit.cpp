@@ -9,8 +9,11 @@
 #include "../../cframe.h"
 #include "../../cvstguitimer.h"
 #include "../../cdropsource.h"
+#include <map>
 #include <numeric>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <codecvt>
 #include <locale>
 
@@ -85,33 +88,45 @@ private:
 	bool callSTB (Proc proc);
 	void onStateChanged ();
 	void onTextChange ();
+	class AdvanceTable;
+
+	void setTextInternal (const UTF8String& txt);
 	void fillCharWidthCache ();
+	void updateCharWidthCache (size_t start, size_t end);
+	void onCharsInserted (size_t pos, size_t num);
+	void onCharsDeleted (size_t pos, size_t num);
+	AdvanceTable* getAdvanceTable ();
+	CCoord getTextWidth ();
 	void calcCursorSizes ();
-	CCoord getCharWidth (STB_CharT c, STB_CharT pc) const;
 
 	static constexpr auto BitRecursiveKeyGuard = 1 << 0;
 	static constexpr auto BitBlinkToggle = 1 << 1;
 	static constexpr auto BitCursorIsSet = 1 << 2;
 	static constexpr auto BitCursorSizesValid = 1 << 3;
 	static constexpr auto BitNotifyTextChange = 1 << 4;
+	static constexpr auto BitTextWidthValid = 1 << 5;
 
 	bool isRecursiveKeyEventGuard () const { return hasBit (flags, BitRecursiveKeyGuard); }
 	bool isBlinkToggle () const { return hasBit (flags, BitBlinkToggle); }
 	bool isCursorSet () const { return hasBit (flags, BitCursorIsSet); }
 	bool cursorSizesValid () const { return hasBit (flags, BitCursorSizesValid); }
 	bool notifyTextChange () const { return hasBit (flags, BitNotifyTextChange); }
+	bool textWidthValid () const { return hasBit (flags, BitTextWidthValid); }
 
 	void setRecursiveKeyEventGuard (bool state) { setBit (flags, BitRecursiveKeyGuard, state); }
 	void setBlinkToggle (bool state) { setBit (flags, BitBlinkToggle, state); }
 	void setCursorIsSet (bool state) { setBit (flags, BitCursorIsSet, state); }
 	void setCursorSizesValid (bool state) { setBit (flags, BitCursorSizesValid, state); }
 	void setNotifyTextChange (bool state) { setBit (flags, BitNotifyTextChange, state); }
+	void setTextWidthValid (bool state) { setBit (flags, BitTextWidthValid, state); }
 
 	SharedPointer<CVSTGUITimer> blinkTimer;
 	IPlatformTextEditCallback* callback;
 	STB_TexteditState editState;
+	SharedPointer<AdvanceTable> advanceTable;
 	std::vector<CCoord> charWidthCache;
 	CColor selectionColor{kBlueCColor};
+	CCoord textWidth{0.};
 	CCoord cursorOffset{0.};
 	CCoord cursorHeight{0.};
 	uint32_t flags{0};
@@ -120,6 +135,43 @@ private:
 #endif
 };
 
+//-----------------------------------------------------------------------------
+/** Advances of single characters and character pairs of one font.
+ *
+ *	Shared by all text edits using the same font, so that each glyph and kerning pair is only
+ *	measured once. The text edits own the tables, the registry only refers to them. A table and
+ *	its platform font are released with the last text edit using it.
+ */
+class STBTextEditView::AdvanceTable : public NonAtomicReferenceCounted
+{
+public:
+	static SharedPointer<AdvanceTable> get (CFontDesc* font);
+
+	~AdvanceTable () noexcept override;
+
+	/** advance of c, including the kerning to the previous character pc */
+	CCoord getAdvance (STB_CharT c, STB_CharT pc);
+
+private:
+	using Key = std::tuple<std::string, CCoord, int32_t>;
+	using Registry = std::map<Key, AdvanceTable*>;
+
+	AdvanceTable (const SharedPointer<IPlatformFont>& font, const Key& key);
+
+	static Registry& getRegistry ();
+
+	CCoord getSingleAdvance (uint32_t c);
+	CCoord measure (uint32_t c1, uint32_t c2 = 0);
+	void appendUTF8 (uint32_t c);
+
+	Key key;
+	SharedPointer<IPlatformFont> platformFont;
+	SharedPointer<IPlatformString> platformString;
+	std::string utf8Buffer;
+	std::unordered_map<uint32_t, CCoord> singleAdvances;
+	std::unordered_map<uint64_t, CCoord> pairAdvances;
+};
+
 //-----------------------------------------------------------------------------
 #define VIRTUAL_KEY_BIT 0x80000000
 #define STB_TEXTEDIT_K_SHIFT 0x40000000
@@ -446,6 +498,8 @@ bool STBTextEditView::removed (CView* parent)
 void STBTextEditView::drawStyleChanged ()
 {
 	setCursorSizesValid (false);
+	setTextWidthValid (false);
+	advanceTable = nullptr;
 	charWidthCache.clear ();
 	CTextLabel::drawStyleChanged ();
 }
@@ -535,65 +589,209 @@ void STBTextEditView::onStateChanged ()
 void STBTextEditView::setText (const UTF8String& txt)
 {
 	charWidthCache.clear ();
+	setTextWidthValid (false);
+	setTextInternal (txt);
+#if VSTGUI_STB_TEXTEDIT_USE_UNICODE
+	uString = StringConvert{}.from_bytes (CTextLabel::getText ().getString ());
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void STBTextEditView::setTextInternal (const UTF8String& txt)
+{
 	CTextLabel::setText (txt);
 	if (editState.select_start != editState.select_end)
 		selectAll ();
+}
+
+//-----------------------------------------------------------------------------
+auto STBTextEditView::AdvanceTable::getRegistry () -> Registry&
+{
+	// never destroyed, text edits may still release their table during static destruction
+	static auto registry = new Registry;
+	return *registry;
+}
+
+//-----------------------------------------------------------------------------
+auto STBTextEditView::AdvanceTable::get (CFontDesc* font) -> SharedPointer<AdvanceTable>
+{
+	if (!font)
+		return nullptr;
+	Key key (font->getName ().getString (), font->getSize (), font->getStyle ());
+	auto& registry = getRegistry ();
+	auto it = registry.find (key);
+	if (it != registry.end ())
+		return shared (it->second);
+	auto platformFont = font->getPlatformFont ();
+	if (!platformFont || !platformFont->getPainter ())
+		return nullptr;
+	auto table = owned (new AdvanceTable (platformFont, key));
+	registry.emplace (std::move (key), table.get ());
+	return table;
+}
+
+//-----------------------------------------------------------------------------
+STBTextEditView::AdvanceTable::AdvanceTable (const SharedPointer<IPlatformFont>& font,
+											 const Key& key)
+: key (key), platformFont (font), platformString (IPlatformString::createWithUTF8String (""))
+{
+}
+
+//-----------------------------------------------------------------------------
+STBTextEditView::AdvanceTable::~AdvanceTable () noexcept
+{
+	getRegistry ().erase (key);
+}
+
+//-----------------------------------------------------------------------------
+CCoord STBTextEditView::AdvanceTable::getAdvance (STB_CharT c, STB_CharT pc)
+{
 #if VSTGUI_STB_TEXTEDIT_USE_UNICODE
-	uString = StringConvert{}.from_bytes (CTextLabel::getText ().getString ());
+	auto isHighSurrogate = [] (STB_CharT ch) { return ch >= 0xD800 && ch < 0xDC00; };
+	auto isLowSurrogate = [] (STB_CharT ch) { return ch >= 0xDC00 && ch < 0xE000; };
+	// the whole advance of a surrogate pair is accounted to its second half
+	if (isHighSurrogate (c))
+		return 0.;
+	if (isLowSurrogate (c))
+	{
+		if (!isHighSurrogate (pc))
+			return getSingleAdvance (0xFFFD);
+		return getSingleAdvance (0x10000 + ((static_cast<uint32_t> (pc) - 0xD800) << 10) +
+								 (static_cast<uint32_t> (c) - 0xDC00));
+	}
+	if (isHighSurrogate (pc) || isLowSurrogate (pc))
+		pc = 0;
+	auto c1 = static_cast<uint32_t> (pc);
+	auto c2 = static_cast<uint32_t> (c);
+#else
+	auto c1 = static_cast<uint32_t> (static_cast<uint8_t> (pc));
+	auto c2 = static_cast<uint32_t> (static_cast<uint8_t> (c));
 #endif
+	if (c1 == 0)
+		return getSingleAdvance (c2);
+
+	auto key = (static_cast<uint64_t> (c1) << 32) | c2;
+	auto it = pairAdvances.find (key);
+	if (it != pairAdvances.end ())
+		return it->second;
+	auto advance = measure (c1, c2) - getSingleAdvance (c1);
+	pairAdvances.emplace (key, advance);
+	return advance;
 }
 
 //-----------------------------------------------------------------------------
-CCoord STBTextEditView::getCharWidth (STB_CharT c, STB_CharT pc) const
+CCoord STBTextEditView::AdvanceTable::getSingleAdvance (uint32_t c)
 {
-	auto platformFont = getFont ()->getPlatformFont ();
-	assert (platformFont);
-	auto fontPainter = platformFont->getPainter ();
-	assert (fontPainter);
+	auto it = singleAdvances.find (c);
+	if (it != singleAdvances.end ())
+		return it->second;
+	auto advance = measure (c);
+	singleAdvances.emplace (c, advance);
+	return advance;
+}
+
+//-----------------------------------------------------------------------------
+CCoord STBTextEditView::AdvanceTable::measure (uint32_t c1, uint32_t c2)
+{
+	utf8Buffer.clear ();
+	appendUTF8 (c1);
+	if (c2)
+		appendUTF8 (c2);
+	platformString->setUTF8String (utf8Buffer.data ());
+	return platformFont->getPainter ()->getStringWidth (nullptr, platformString, true);
+}
 
+//-----------------------------------------------------------------------------
+void STBTextEditView::AdvanceTable::appendUTF8 (uint32_t c)
+{
 #if VSTGUI_STB_TEXTEDIT_USE_UNICODE
-	if (pc)
+	if (c < 0x80)
+		utf8Buffer += static_cast<char> (c);
+	else if (c < 0x800)
 	{
-		UTF8String str (StringConvert{}.to_bytes (pc));
-		auto pcWidth = fontPainter->getStringWidth (nullptr, str.getPlatformString (), true);
-		str += StringConvert{}.to_bytes (c);
-		auto tcWidth = fontPainter->getStringWidth (nullptr, str.getPlatformString (), true);
-		return tcWidth - pcWidth;
+		utf8Buffer += static_cast<char> (0xC0 | (c >> 6));
+		utf8Buffer += static_cast<char> (0x80 | (c & 0x3F));
 	}
-	UTF8String str (StringConvert{}.to_bytes (c));
-	return fontPainter->getStringWidth (nullptr, str.getPlatformString (), true);
-#else
-	if (pc)
+	else if (c < 0x10000)
 	{
-		UTF8String str (std::string (1, pc));
-		auto pcWidth = fontPainter->getStringWidth (nullptr, str.getPlatformString (), true);
-		str += std::string (1, c);
-		auto tcWidth = fontPainter->getStringWidth (nullptr, str.getPlatformString (), true);
-		return tcWidth - pcWidth;
+		utf8Buffer += static_cast<char> (0xE0 | (c >> 12));
+		utf8Buffer += static_cast<char> (0x80 | ((c >> 6) & 0x3F));
+		utf8Buffer += static_cast<char> (0x80 | (c & 0x3F));
 	}
-
-	UTF8String str (std::string (1, c));
-	return fontPainter->getStringWidth (nullptr, str.getPlatformString (), true);
+	else
+	{
+		utf8Buffer += static_cast<char> (0xF0 | (c >> 18));
+		utf8Buffer += static_cast<char> (0x80 | ((c >> 12) & 0x3F));
+		utf8Buffer += static_cast<char> (0x80 | ((c >> 6) & 0x3F));
+		utf8Buffer += static_cast<char> (0x80 | (c & 0x3F));
+	}
+#else
+	utf8Buffer += static_cast<char> (c);
 #endif
 }
 
+//-----------------------------------------------------------------------------
+auto STBTextEditView::getAdvanceTable () -> AdvanceTable*
+{
+	if (!advanceTable)
+		advanceTable = AdvanceTable::get (getFont ());
+	assert (advanceTable);
+	return advanceTable;
+}
+
 //-----------------------------------------------------------------------------
 void STBTextEditView::fillCharWidthCache ()
 {
 	if (!charWidthCache.empty ())
 		return;
-#if VSTGUI_STB_TEXTEDIT_USE_UNICODE
-	auto num = uString.size ();
-	charWidthCache.resize (num);
-	for (auto i = 0u; i < num; ++i)
-		charWidthCache[i] = getCharWidth (uString[i], i == 0 ? 0 : uString[i - 1]);
-#else
-	auto num = getText ().length ();
-	charWidthCache.resize (num);
-	const auto& str = getText ().getString ();
-	for (auto i = 0u; i < num; ++i)
-		charWidthCache[i] = getCharWidth (str[i], i == 0 ? 0 : str[i - 1]);
-#endif
+	charWidthCache.resize (static_cast<size_t> (getLength (this)));
+	updateCharWidthCache (0, charWidthCache.size ());
+}
+
+//-----------------------------------------------------------------------------
+void STBTextEditView::updateCharWidthCache (size_t start, size_t end)
+{
+	auto table = getAdvanceTable ();
+	for (auto i = start; i < end; ++i)
+	{
+		auto pos = static_cast<int> (i);
+		charWidthCache[i] =
+			table ? table->getAdvance (getChar (this, pos), i == 0 ? 0 : getChar (this, pos - 1)) :
+					0.;
+	}
+	setTextWidthValid (false);
+}
+
+//-----------------------------------------------------------------------------
+void STBTextEditView::onCharsInserted (size_t pos, size_t num)
+{
+	// an empty cache is filled completely on the next use
+	if (charWidthCache.empty ())
+		return;
+	charWidthCache.insert (charWidthCache.begin () + pos, num, 0.);
+	// the character after the insertion has a new predecessor
+	updateCharWidthCache (pos, std::min (pos + num + 1, charWidthCache.size ()));
+}
+
+//-----------------------------------------------------------------------------
+void STBTextEditView::onCharsDeleted (size_t pos, size_t num)
+{
+	if (charWidthCache.empty ())
+		return;
+	charWidthCache.erase (charWidthCache.begin () + pos, charWidthCache.begin () + pos + num);
+	updateCharWidthCache (pos, std::min (pos + 1, charWidthCache.size ()));
+}
+
+//-----------------------------------------------------------------------------
+CCoord STBTextEditView::getTextWidth ()
+{
+	fillCharWidthCache ();
+	if (!textWidthValid ())
+	{
+		textWidth = std::accumulate (charWidthCache.begin (), charWidthCache.end (), 0.);
+		setTextWidthValid (true);
+	}
+	return textWidth;
 }
 
 //-----------------------------------------------------------------------------
@@ -693,13 +891,15 @@ int STBTextEditView::deleteChars (STBTextEditView* self, size_t pos, size_t num)
 {
 #if VSTGUI_STB_TEXTEDIT_USE_UNICODE
 	self->uString.erase (pos, num);
-	self->setText (StringConvert{}.to_bytes (self->uString));
+	self->setTextInternal (StringConvert{}.to_bytes (self->uString));
+	self->onCharsDeleted (pos, num);
 	self->onTextChange ();
 	return true;
 #else
 	auto str = self->text.getString ();
 	str.erase (pos, num);
-	self->setText (str.data ());
+	self->setTextInternal (str.data ());
+	self->onCharsDeleted (pos, num);
 	self->onTextChange ();
 	return true; // success
 #endif
@@ -713,13 +913,15 @@ int STBTextEditView::insertChars (STBTextEditView* self,
 {
 #if VSTGUI_STB_TEXTEDIT_USE_UNICODE
 	self->uString.insert (pos, text, num);
-	self->setText (StringConvert{}.to_bytes (self->uString));
+	self->setTextInternal (StringConvert{}.to_bytes (self->uString));
+	self->onCharsInserted (pos, num);
 	self->onTextChange ();
 	return true;
 #else
 	auto str = self->text.getString ();
 	str.insert (pos, text, num);
-	self->setText (str.data ());
+	self->setTextInternal (str.data ());
+	self->onCharsInserted (pos, num);
 	self->onTextChange ();
 	return true; // success
 #endif
@@ -750,11 +952,9 @@ void STBTextEditView::layout (StbTexteditRow* row, STBTextEditView* self, int st
 {
 	assert (start_i == 0);
 
-	self->fillCharWidthCache ();
-	auto textWidth = static_cast<float> (
-		std::accumulate (self->charWidthCache.begin (), self->charWidthCache.end (), 0.));
+	auto textWidth = static_cast<float> (self->getTextWidth ());
 
-	row->num_chars = static_cast<int> (self->getText ().length ());
+	row->num_chars = getLength (self);
 	row->baseline_y_delta = 1.25;
 	row->ymin = 0.f;
 	row->ymax = static_cast<float> (self->getFont ()->getSize ());
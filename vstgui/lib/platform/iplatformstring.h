@@ -16,8 +16,15 @@ class IPlatformString : public AtomicReferenceCounted
 {
 public:
 	static SharedPointer<IPlatformString> createWithUTF8String (UTF8StringPtr utf8String = nullptr);
-	
+	/** create a platform string which may reference the storage of utf8String instead of copying
+	 *	it. The owner must call updateUTF8StringReference before each use, as the storage may
+	 *	have moved in the meantime. */
+	static SharedPointer<IPlatformString> createWithUTF8StringReference (UTF8StringPtr utf8String,
+																		 size_t length);
+
 	virtual void setUTF8String (UTF8StringPtr utf8String) = 0;
+	/** the referenced storage has moved, the content is the same */
+	virtual void updateUTF8StringReference (UTF8StringPtr utf8String, size_t length) {}
 };
 
 } // namespace
@@ -6,6 +6,9 @@
 #include "../../cresourcedescription.h"
 
 #include "cairobitmap.h"
+#include "cairobitmapcache.h"
+#include "cairopixelbufferpool.h"
+#include "cairopngcodec.h"
 #include <memory>
 #include <vector>
 
@@ -15,86 +18,15 @@ namespace Cairo {
 namespace CairoBitmapPrivate {
 
 //-----------------------------------------------------------------------------
-struct PNGMemoryReader
+static SurfaceHandle createImageFromMemory (const uint8_t* data, size_t size)
 {
-	PNGMemoryReader (const uint8_t* ptr, size_t size) : ptr (ptr), size (size) {}
-
-	cairo_surface_t* create () { return cairo_image_surface_create_from_png_stream (read, this); }
-
-private:
-	static cairo_status_t read (void* closure, unsigned char* data, unsigned int length)
-	{
-		auto self = reinterpret_cast<PNGMemoryReader*> (closure);
-		auto numBytes = std::min<size_t> (length, self->size);
-		if (numBytes)
-		{
-			memcpy (data, self->ptr, numBytes);
-			self->ptr += numBytes;
-			self->size -= numBytes;
-			return CAIRO_STATUS_SUCCESS;
-		}
-		return CAIRO_STATUS_READ_ERROR;
-	}
-
-	const uint8_t* ptr;
-	size_t size;
-};
-
-//-----------------------------------------------------------------------------
-struct PNGMemoryWriter
-{
-	using Buffer = PNGBitmapBuffer;
-
-	Buffer create (cairo_surface_t* image)
-	{
-		Buffer buffer;
-		cairo_surface_write_to_png_stream (image, write, &buffer);
-		return buffer;
-	}
-
-private:
-	static cairo_status_t write (void* closure, const unsigned char* data, unsigned int length)
-	{
-		auto buffer = reinterpret_cast<Buffer*> (closure);
-		if (!buffer)
-			return CAIRO_STATUS_WRITE_ERROR;
-		buffer->reserve (buffer->size () + length);
-		std::copy_n (data, length, std::back_inserter (*buffer));
-		return CAIRO_STATUS_SUCCESS;
-	}
-};
+	return PNGCodec::decode (data, size);
+}
 
 //-----------------------------------------------------------------------------
 static SurfaceHandle createImageFromPath (const char* path)
 {
-	if (auto surface = cairo_image_surface_create_from_png (path))
-	{
-		if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
-		{
-			cairo_surface_destroy (surface);
-			return {};
-		}
-		if (cairo_image_surface_get_format (surface) == CAIRO_FORMAT_ARGB32)
-			return SurfaceHandle {surface};
-
-		// vstgui always works with 32 bit images
-		auto x = cairo_image_surface_get_width (surface);
-		auto y = cairo_image_surface_get_height (surface);
-		auto surface32 = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, x, y);
-		vstgui_assert (cairo_surface_status (surface32) == CAIRO_STATUS_SUCCESS);
-		auto context = cairo_create (surface32);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_set_source_surface (context, surface, 0, 0);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_paint (context);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_surface_flush (surface32);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_destroy (context);
-		cairo_surface_destroy (surface);
-		return SurfaceHandle {surface32};
-	}
-	return {};
+	return BitmapCache::instance ().load (path, createImageFromMemory);
 }
 
 //-----------------------------------------------------------------------------
@@ -142,7 +74,7 @@ Bitmap::Bitmap (const CPoint* _size)
 	if (_size)
 	{
 		size = *_size;
-		surface = SurfaceHandle (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, size.x, size.y));
+		surface = PixelBufferPool::instance ().createSurface (size.x, size.y);
 	}
 }
 
@@ -281,12 +213,8 @@ SharedPointer<IPlatformBitmap> IPlatformBitmap::createFromPath (UTF8StringPtr ab
 //-----------------------------------------------------------------------------
 SharedPointer<IPlatformBitmap> IPlatformBitmap::createFromMemory (const void* ptr, uint32_t memSize)
 {
-	Cairo::CairoBitmapPrivate::PNGMemoryReader reader (reinterpret_cast<const uint8_t*> (ptr),
-													   memSize);
-	if (auto surface = reader.create ())
-	{
-		return owned (new Cairo::Bitmap (Cairo::SurfaceHandle {surface}));
-	}
+	if (auto surface = Cairo::PNGCodec::decode (reinterpret_cast<const uint8_t*> (ptr), memSize))
+		return owned (new Cairo::Bitmap (surface));
 	return nullptr;
 }
 
@@ -295,8 +223,7 @@ PNGBitmapBuffer IPlatformBitmap::createMemoryPNGRepresentation (const SharedPoin
 {
 	if (auto cairoBitmap = bitmap.cast<Cairo::Bitmap> ())
 	{
-		Cairo::CairoBitmapPrivate::PNGMemoryWriter writer;
-		return writer.create (cairoBitmap->getSurface ());
+		return Cairo::PNGCodec::encode (cairoBitmap->getSurface ());
 	}
 	return {};
 }
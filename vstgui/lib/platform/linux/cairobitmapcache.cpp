@@ -0,0 +1,400 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairobitmapcache.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+namespace {
+
+//------------------------------------------------------------------------
+constexpr uint32_t kCacheFileMagic = 0x43424756; // 'VGBC'
+constexpr uint32_t kCacheFileVersion = 1;
+constexpr size_t kCacheFileHeaderSize = 64;
+constexpr const char* kCacheFileExtension = ".vgbc";
+
+//------------------------------------------------------------------------
+struct CacheFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t contentHash;
+	uint64_t contentSize;
+	uint32_t width;
+	uint32_t height;
+	uint32_t stride;
+};
+static_assert (sizeof (CacheFileHeader) <= kCacheFileHeaderSize, "");
+
+//------------------------------------------------------------------------
+struct Mapping
+{
+	void* address;
+	size_t size;
+
+	static void unmap (void* data)
+	{
+		auto mapping = reinterpret_cast<Mapping*> (data);
+		munmap (mapping->address, mapping->size);
+		delete mapping;
+	}
+};
+static cairo_user_data_key_t mappingKey;
+
+//------------------------------------------------------------------------
+std::atomic<uint32_t> gTempFileCounter {0};
+
+//------------------------------------------------------------------------
+uint64_t hashContent (const uint8_t* data, size_t size)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+//------------------------------------------------------------------------
+bool readFile (const char* path, std::vector<uint8_t>& content)
+{
+	auto fd = open (path, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat (fd, &st) != 0 || st.st_size <= 0)
+	{
+		close (fd);
+		return false;
+	}
+	content.resize (static_cast<size_t> (st.st_size));
+	size_t pos = 0;
+	while (pos < content.size ())
+	{
+		auto numRead = read (fd, content.data () + pos, content.size () - pos);
+		if (numRead <= 0)
+			break;
+		pos += static_cast<size_t> (numRead);
+	}
+	close (fd);
+	return pos == content.size ();
+}
+
+//------------------------------------------------------------------------
+bool writeAll (int fd, const void* data, size_t size)
+{
+	auto ptr = reinterpret_cast<const uint8_t*> (data);
+	while (size)
+	{
+		auto numWritten = write (fd, ptr, size);
+		if (numWritten <= 0)
+			return false;
+		ptr += numWritten;
+		size -= static_cast<size_t> (numWritten);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool isCacheFile (const char* name)
+{
+	auto nameLength = strlen (name);
+	auto extLength = strlen (kCacheFileExtension);
+	return nameLength > extLength &&
+		   strcmp (name + nameLength - extLength, kCacheFileExtension) == 0;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+BitmapCache& BitmapCache::instance ()
+{
+	static BitmapCache gInstance;
+	return gInstance;
+}
+
+//------------------------------------------------------------------------
+void BitmapCache::setDirectory (const std::string& path)
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	directory = path;
+	if (!directory.empty () && directory.back () == '/')
+		directory.pop_back ();
+	if (!directory.empty ())
+		mkdir (directory.data (), 0755);
+}
+
+//------------------------------------------------------------------------
+std::string BitmapCache::getDirectory () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return directory;
+}
+
+//------------------------------------------------------------------------
+bool BitmapCache::isEnabled () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return !directory.empty ();
+}
+
+//------------------------------------------------------------------------
+void BitmapCache::setSizeLimit (uint64_t bytes)
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		sizeLimit = bytes;
+	}
+	evict ({});
+}
+
+//------------------------------------------------------------------------
+uint64_t BitmapCache::getSizeLimit () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return sizeLimit;
+}
+
+//------------------------------------------------------------------------
+auto BitmapCache::getStatistics () const -> Statistics
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return statistics;
+}
+
+//------------------------------------------------------------------------
+void BitmapCache::resetStatistics ()
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	statistics = {};
+}
+
+//------------------------------------------------------------------------
+void BitmapCache::clear ()
+{
+	auto dirPath = getDirectory ();
+	if (dirPath.empty ())
+		return;
+	if (auto dir = opendir (dirPath.data ()))
+	{
+		while (auto entry = readdir (dir))
+		{
+			if (isCacheFile (entry->d_name))
+				unlink ((dirPath + "/" + entry->d_name).data ());
+		}
+		closedir (dir);
+	}
+}
+
+//------------------------------------------------------------------------
+SurfaceHandle BitmapCache::load (const char* path, const DecodeFunc& decodeFunc)
+{
+	std::vector<uint8_t> content;
+	if (!readFile (path, content))
+		return {};
+
+	if (!isEnabled ())
+		return decodeFunc (content.data (), content.size ());
+
+	auto hash = hashContent (content.data (), content.size ());
+	auto entry = entryPath (hash, content.size ());
+	if (auto surface = mapEntry (entry, hash, content.size ()))
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		++statistics.hits;
+		statistics.bytesMapped += static_cast<uint64_t> (cairo_image_surface_get_stride (surface)) *
+								  cairo_image_surface_get_height (surface);
+		return surface;
+	}
+
+	auto surface = decodeFunc (content.data (), content.size ());
+	if (!surface)
+		return {};
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		++statistics.misses;
+		statistics.bytesDecoded += static_cast<uint64_t> (cairo_image_surface_get_stride (surface)) *
+								   cairo_image_surface_get_height (surface);
+	}
+	if (storeEntry (entry, hash, content.size (), surface))
+		evict (entry);
+	return surface;
+}
+
+//------------------------------------------------------------------------
+std::string BitmapCache::entryPath (uint64_t hash, size_t size) const
+{
+	char name[64];
+	snprintf (name, sizeof (name), "/%016llx_%zx", static_cast<unsigned long long> (hash), size);
+	return getDirectory () + name + kCacheFileExtension;
+}
+
+//------------------------------------------------------------------------
+SurfaceHandle BitmapCache::mapEntry (const std::string& entry, uint64_t hash, size_t size)
+{
+	auto fd = open (entry.data (), O_RDONLY);
+	if (fd < 0)
+		return {};
+	struct stat st;
+	if (fstat (fd, &st) != 0 || static_cast<size_t> (st.st_size) < kCacheFileHeaderSize)
+	{
+		close (fd);
+		return {};
+	}
+	auto fileSize = static_cast<size_t> (st.st_size);
+	// private mapping, so that modifications via lockPixels never reach the cache file
+	auto address = mmap (nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if (address == MAP_FAILED)
+	{
+		close (fd);
+		return {};
+	}
+	// mark as recently used for the eviction
+	futimens (fd, nullptr);
+	close (fd);
+
+	CacheFileHeader header;
+	memcpy (&header, address, sizeof (header));
+	auto expectedStride =
+		cairo_format_stride_for_width (CAIRO_FORMAT_ARGB32, static_cast<int> (header.width));
+	if (header.magic != kCacheFileMagic || header.version != kCacheFileVersion ||
+		header.contentHash != hash || header.contentSize != size ||
+		static_cast<int> (header.stride) != expectedStride ||
+		fileSize < kCacheFileHeaderSize + static_cast<size_t> (header.stride) * header.height)
+	{
+		munmap (address, fileSize);
+		return {};
+	}
+
+	auto data = reinterpret_cast<unsigned char*> (address) + kCacheFileHeaderSize;
+	SurfaceHandle surface (cairo_image_surface_create_for_data (
+		data, CAIRO_FORMAT_ARGB32, static_cast<int> (header.width),
+		static_cast<int> (header.height), static_cast<int> (header.stride)));
+	if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
+	{
+		munmap (address, fileSize);
+		return {};
+	}
+	auto mapping = new Mapping {address, fileSize};
+	if (cairo_surface_set_user_data (surface, &mappingKey, mapping, Mapping::unmap) !=
+		CAIRO_STATUS_SUCCESS)
+	{
+		surface.reset ();
+		Mapping::unmap (mapping);
+		return {};
+	}
+	return surface;
+}
+
+//------------------------------------------------------------------------
+bool BitmapCache::storeEntry (const std::string& entry, uint64_t hash, size_t size,
+							  const SurfaceHandle& surface)
+{
+	if (cairo_image_surface_get_format (surface) != CAIRO_FORMAT_ARGB32)
+		return false;
+	cairo_surface_flush (surface);
+	auto data = cairo_image_surface_get_data (surface);
+	if (!data)
+		return false;
+
+	CacheFileHeader header {};
+	header.magic = kCacheFileMagic;
+	header.version = kCacheFileVersion;
+	header.contentHash = hash;
+	header.contentSize = size;
+	header.width = static_cast<uint32_t> (cairo_image_surface_get_width (surface));
+	header.height = static_cast<uint32_t> (cairo_image_surface_get_height (surface));
+	header.stride = static_cast<uint32_t> (cairo_image_surface_get_stride (surface));
+
+	uint8_t headerData[kCacheFileHeaderSize] = {};
+	memcpy (headerData, &header, sizeof (header));
+
+	// write to a temporary file first, so that other processes and threads never see a partial
+	// entry
+	auto tmpPath = entry + "." + std::to_string (getpid ()) + "_" +
+				   std::to_string (++gTempFileCounter) + ".tmp";
+	auto fd = open (tmpPath.data (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return false;
+	auto result = writeAll (fd, headerData, kCacheFileHeaderSize) &&
+				  writeAll (fd, data, static_cast<size_t> (header.stride) * header.height);
+	close (fd);
+	if (result)
+		result = rename (tmpPath.data (), entry.data ()) == 0;
+	if (!result)
+		unlink (tmpPath.data ());
+	return result;
+}
+
+//------------------------------------------------------------------------
+void BitmapCache::evict (const std::string& keep)
+{
+	std::string dirPath;
+	uint64_t limit;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		dirPath = directory;
+		limit = sizeLimit;
+	}
+	if (dirPath.empty ())
+		return;
+
+	struct CacheFile
+	{
+		std::string path;
+		uint64_t size;
+		time_t lastUsed;
+	};
+	std::vector<CacheFile> files;
+	uint64_t totalSize = 0;
+	if (auto dir = opendir (dirPath.data ()))
+	{
+		while (auto entry = readdir (dir))
+		{
+			if (!isCacheFile (entry->d_name))
+				continue;
+			CacheFile file {dirPath + "/" + entry->d_name, 0, 0};
+			struct stat st;
+			if (stat (file.path.data (), &st) != 0)
+				continue;
+			file.size = static_cast<uint64_t> (st.st_size);
+			file.lastUsed = st.st_mtime;
+			totalSize += file.size;
+			files.emplace_back (std::move (file));
+		}
+		closedir (dir);
+	}
+	if (totalSize <= limit)
+		return;
+	std::sort (files.begin (), files.end (), [] (const CacheFile& f1, const CacheFile& f2) {
+		return f1.lastUsed < f2.lastUsed;
+	});
+	for (auto& file : files)
+	{
+		if (totalSize <= limit)
+			break;
+		if (file.path == keep)
+			continue;
+		if (unlink (file.path.data ()) == 0)
+			totalSize -= file.size;
+	}
+}
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
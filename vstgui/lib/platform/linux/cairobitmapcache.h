@@ -0,0 +1,81 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cairoutils.h"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+/** Persistent cache of decoded bitmaps
+ *
+ *	Stores the premultiplied ARGB32 pixels of decoded PNG files in a directory. Entries are keyed
+ *	by the content hash and size of the PNG file only, the decoded pixels do not depend on the path
+ *	or the scale factor of the bitmap. A cached bitmap is loaded by mapping the cache file into
+ *	memory, no decoding is necessary.
+ *
+ *	The cache is disabled until a directory is set.
+ */
+class BitmapCache
+{
+public:
+	struct Statistics
+	{
+		uint64_t hits {0};
+		uint64_t misses {0};
+		uint64_t bytesMapped {0};
+		uint64_t bytesDecoded {0};
+	};
+
+	static BitmapCache& instance ();
+
+	/** set the cache directory, an empty path disables the cache */
+	void setDirectory (const std::string& path);
+	std::string getDirectory () const;
+	bool isEnabled () const;
+
+	/** maximum size of all cache files in bytes, least recently used entries are evicted first */
+	void setSizeLimit (uint64_t bytes);
+	uint64_t getSizeLimit () const;
+
+	Statistics getStatistics () const;
+	void resetStatistics ();
+
+	/** remove all entries from the cache directory */
+	void clear ();
+
+	using DecodeFunc = std::function<SurfaceHandle (const uint8_t* data, size_t size)>;
+
+	/** load the PNG file at path.
+	 *
+	 *	Returns the cached bitmap if available. Otherwise the content of the file is passed to
+	 *	decodeFunc and the result is written to the cache.
+	 */
+	SurfaceHandle load (const char* path, const DecodeFunc& decodeFunc);
+
+private:
+	BitmapCache () = default;
+
+	std::string entryPath (uint64_t hash, size_t size) const;
+	SurfaceHandle mapEntry (const std::string& entry, uint64_t hash, size_t size);
+	bool storeEntry (const std::string& entry, uint64_t hash, size_t size,
+					 const SurfaceHandle& surface);
+	void evict (const std::string& keep);
+
+	mutable std::mutex mutex;
+	std::string directory;
+	uint64_t sizeLimit {256 * 1024 * 1024};
+	Statistics statistics;
+};
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
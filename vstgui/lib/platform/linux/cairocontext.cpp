@@ -37,54 +37,81 @@ void checkCairoStatus (const ContextHandle& handle)
 }
 
 //------------------------------------------------------------------------
-cairo_matrix_t convert (CGraphicsTransform& ct)
+cairo_matrix_t convert (const CGraphicsTransform& ct)
 {
 	return {ct.m11, ct.m21, ct.m12, ct.m22, ct.dx, ct.dy};
 }
 
+//-----------------------------------------------------------------------------
+/** same as pixelAlign but inverts the transform only once for many points */
+struct PixelAligner
+{
+	explicit PixelAligner (const CGraphicsTransform& tm) : tm (tm), inverse (tm.inverse ()) {}
+
+	CPoint operator() (CPoint p) const
+	{
+		tm.transform (p);
+		p.makeIntegral ();
+		inverse.transform (p);
+		return p;
+	}
+
+private:
+	const CGraphicsTransform& tm;
+	CGraphicsTransform inverse;
+};
+
 //-----------------------------------------------------------------------------
 inline bool needPixelAlignment (CDrawMode mode)
 {
 	return (mode.integralMode () && mode.modeIgnoringIntegralMode () == kAntiAliasing);
 }
 
-//------------------------------------------------------------------------
-} // anonymous
-
-//------------------------------------------------------------------------
-DrawBlock::DrawBlock (Context& context) : context (context)
-{
-	auto ct = context.getCurrentTransform ();
-	CRect clip;
-	context.getClipRect (clip);
-	ct.transform (clip);
-	clip.bound (context.getSurfaceRect ());
-	if (clip.isEmpty ())
+//-----------------------------------------------------------------------------
+/** fill the current path with a unit space gradient pattern mapped by gradientMatrix
+ *
+ *	The pattern is locked to the user space in effect when it is set as source, so the shared
+ *	pattern itself is never modified. Without a matrix the geometry is degenerated and the path is
+ *	filled with the last color stop.
+ */
+void fillGradient (cairo_t* cr, const Gradient& gradient, const PatternHandle& pattern,
+				   const cairo_matrix_t* gradientMatrix, bool evenOdd)
+{
+	if (gradientMatrix)
+	{
+		cairo_matrix_t currentMatrix;
+		cairo_get_matrix (cr, &currentMatrix);
+		cairo_transform (cr, gradientMatrix);
+		cairo_set_source (cr, pattern);
+		cairo_set_matrix (cr, &currentMatrix);
+	}
+	else if (!gradient.getColorStops ().empty ())
 	{
-		clipIsEmpty = true;
+		auto color = gradient.getColorStops ().rbegin ()->second;
+		cairo_set_source_rgba (cr, color.red / 255., color.green / 255., color.blue / 255.,
+							   color.alpha / 255.);
 	}
 	else
+		return;
+	if (evenOdd)
 	{
-		cairo_save (context.getCairo ());
-		cairo_rectangle (context.getCairo (), clip.left, clip.top, clip.getWidth (),
-						 clip.getHeight ());
-		cairo_clip (context.getCairo ());
-		auto matrix = convert (ct);
-		cairo_set_matrix (context.getCairo (), &matrix);
-		auto antialiasMode = context.getDrawMode ().modeIgnoringIntegralMode () == kAntiAliasing ?
-								 CAIRO_ANTIALIAS_BEST :
-								 CAIRO_ANTIALIAS_NONE;
-		cairo_set_antialias (context.getCairo (), antialiasMode);
+		cairo_set_fill_rule (cr, CAIRO_FILL_RULE_EVEN_ODD);
+		cairo_fill (cr);
+		cairo_set_fill_rule (cr, CAIRO_FILL_RULE_WINDING);
+	}
+	else
+	{
+		cairo_fill (cr);
 	}
 }
 
 //------------------------------------------------------------------------
-DrawBlock::~DrawBlock ()
+} // anonymous
+
+//------------------------------------------------------------------------
+DrawBlock::DrawBlock (Context& context) : context (context)
 {
-	if (!clipIsEmpty)
-	{
-		cairo_restore (context.getCairo ());
-	}
+	clipIsEmpty = !context.applyDrawState ();
 }
 
 //------------------------------------------------------------------------
@@ -115,11 +142,13 @@ Context::Context (CRect r, cairo_t* context) : super (r)
 //-----------------------------------------------------------------------------
 Context::~Context ()
 {
+	resetDrawState ();
 }
 
 //-----------------------------------------------------------------------------
 void Context::init ()
 {
+	appliedState = {};
 	if (surface)
 		cr.assign (cairo_create (surface));
 	super::init ();
@@ -136,6 +165,7 @@ void Context::beginDraw ()
 //-----------------------------------------------------------------------------
 void Context::endDraw ()
 {
+	resetDrawState ();
 	cairo_restore (cr);
 	if (surface)
 		cairo_surface_flush (surface);
@@ -143,6 +173,57 @@ void Context::endDraw ()
 	super::endDraw ();
 }
 
+//-----------------------------------------------------------------------------
+bool Context::applyDrawState ()
+{
+	const auto& ct = getCurrentTransform ();
+	CRect clip;
+	getClipRect (clip);
+	ct.transform (clip);
+	clip.bound (getSurfaceRect ());
+	if (clip.isEmpty ())
+		return false;
+
+	if (!appliedState.saved || appliedState.clip != clip)
+	{
+		// a clip can only be narrowed, so a changed clip needs a fresh state
+		if (appliedState.saved)
+			cairo_restore (cr);
+		cairo_save (cr);
+		cairo_rectangle (cr, clip.left, clip.top, clip.getWidth (), clip.getHeight ());
+		cairo_clip (cr);
+		appliedState.clip = clip;
+		appliedState.saved = true;
+		appliedState.transformValid = false;
+		appliedState.antialiasValid = false;
+	}
+	if (!appliedState.transformValid || appliedState.transform != ct)
+	{
+		auto matrix = convert (ct);
+		cairo_set_matrix (cr, &matrix);
+		appliedState.transform = ct;
+		appliedState.transformValid = true;
+	}
+	auto antialias = getDrawMode ().modeIgnoringIntegralMode () == kAntiAliasing ?
+						 CAIRO_ANTIALIAS_BEST :
+						 CAIRO_ANTIALIAS_NONE;
+	if (!appliedState.antialiasValid || appliedState.antialias != antialias)
+	{
+		cairo_set_antialias (cr, antialias);
+		appliedState.antialias = antialias;
+		appliedState.antialiasValid = true;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void Context::resetDrawState ()
+{
+	if (appliedState.saved && cr)
+		cairo_restore (cr);
+	appliedState = {};
+}
+
 //-----------------------------------------------------------------------------
 void Context::saveGlobalState ()
 {
@@ -169,11 +250,9 @@ void Context::setupCurrentStroke ()
 {
 	cairo_set_line_width (cr, getLineWidth ());
 	const auto& style = getLineStyle ();
-	if (!style.getDashLengths ().empty ())
-	{
-		cairo_set_dash (cr, style.getDashLengths ().data (), style.getDashLengths ().size (),
-						style.getDashPhase ());
-	}
+	// the cairo state is shared between primitives, so the dash is always set
+	cairo_set_dash (cr, style.getDashLengths ().data (), style.getDashLengths ().size (),
+					style.getDashPhase ());
 	cairo_line_cap_t lineCap;
 	switch (style.getLineCap ())
 	{
@@ -279,27 +358,87 @@ void Context::drawLines (const CDrawContext::LineList& lines)
 	{
 		setupCurrentStroke ();
 		setSourceColor (getFrameColor ());
+		// one path is stroked much faster, but overlapping translucent lines would not blend with
+		// each other anymore
+		auto singlePath = getFrameColor ().alpha == 255 && getGlobalAlpha () == 1.f;
+		auto addLine = [&] (const CPoint& start, const CPoint& end) {
+			cairo_move_to (cr, start.x, start.y);
+			cairo_line_to (cr, end.x, end.y);
+			if (!singlePath)
+				cairo_stroke (cr);
+		};
 		if (getDrawMode ().integralMode ())
 		{
+			PixelAligner aligner (getCurrentTransform ());
 			for (auto& line : lines)
 			{
-				CPoint start = pixelAlign (getCurrentTransform (), line.first);
-				CPoint end = pixelAlign (getCurrentTransform (), line.second);
-				cairo_move_to (cr, start.x + 0.5, start.y + 0.5);
-				cairo_line_to (cr, end.x + 0.5, end.y + 0.5);
-				cairo_stroke (cr);
+				CPoint start = aligner (line.first);
+				CPoint end = aligner (line.second);
+				addLine (start.offset (0.5, 0.5), end.offset (0.5, 0.5));
 			}
 		}
 		else
 		{
 			for (auto& line : lines)
+				addLine (line.first, line.second);
+		}
+		if (singlePath)
+			cairo_stroke (cr);
+	}
+	checkCairoStatus (cr);
+}
+
+//-----------------------------------------------------------------------------
+void Context::drawPolyline (const CPoint* points, size_t numPoints)
+{
+	if (numPoints < 2)
+		return;
+
+	if (auto cd = DrawBlock::begin (*this))
+	{
+		setupCurrentStroke ();
+		setSourceColor (getFrameColor ());
+		if (getDrawMode ().integralMode ())
+		{
+			PixelAligner aligner (getCurrentTransform ());
+			auto p = aligner (points[0]);
+			cairo_move_to (cr, p.x + 0.5, p.y + 0.5);
+			for (size_t i = 1; i < numPoints; ++i)
 			{
-				cairo_move_to (cr, line.first.x, line.first.y);
-				cairo_line_to (cr, line.second.x, line.second.y);
-				cairo_stroke (cr);
+				p = aligner (points[i]);
+				cairo_line_to (cr, p.x + 0.5, p.y + 0.5);
 			}
 		}
+		else
+		{
+			cairo_move_to (cr, points[0].x, points[0].y);
+			for (size_t i = 1; i < numPoints; ++i)
+				cairo_line_to (cr, points[i].x, points[i].y);
+		}
+		cairo_stroke (cr);
 	}
+	checkCairoStatus (cr);
+}
+
+//-----------------------------------------------------------------------------
+void Context::drawEnvelope (const CPoint* upper, const CPoint* lower, size_t numPoints,
+							const CDrawStyle drawStyle)
+{
+	if (numPoints == 0)
+		return;
+
+	if (auto cd = DrawBlock::begin (*this))
+	{
+		cairo_move_to (cr, upper[0].x, upper[0].y);
+		for (size_t i = 1; i < numPoints; ++i)
+			cairo_line_to (cr, upper[i].x, upper[i].y);
+		for (size_t i = numPoints; i > 0; --i)
+			cairo_line_to (cr, lower[i - 1].x, lower[i - 1].y);
+		cairo_close_path (cr);
+
+		draw (drawStyle);
+	}
+	checkCairoStatus (cr);
 }
 
 //-----------------------------------------------------------------------------
@@ -344,6 +483,8 @@ void Context::drawArc (const CRect& rect, const float startAngle1, const float e
 {
 	if (auto cd = DrawBlock::begin (*this))
 	{
+		// the applied draw state is kept between draw calls, the scale must not leak into it
+		SaveCairoState state (cr);
 		CPoint center = rect.getCenter ();
 		cairo_translate (cr, center.x, center.y);
 		cairo_scale (cr, 2.0 / rect.getWidth (), 2.0 / rect.getHeight ());
@@ -357,6 +498,7 @@ void Context::drawEllipse (const CRect& rect, const CDrawStyle drawStyle)
 {
 	if (auto cd = DrawBlock::begin (*this))
 	{
+		SaveCairoState state (cr);
 		CPoint center = rect.getCenter ();
 		cairo_translate (cr, center.x, center.y);
 		cairo_scale (cr, 2.0 / rect.getWidth (), 2.0 / rect.getHeight ());
@@ -389,6 +531,7 @@ void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offs
                 auto cairoBitmap = bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor).cast<Bitmap> ();
 		if (cairoBitmap)
 		{
+			SaveCairoState state (cr);
 			cairo_translate (cr, dest.left, dest.top);
 			cairo_rectangle (cr, 0, 0, dest.getWidth (), dest.getHeight ());
 			cairo_clip (cr);
@@ -427,6 +570,7 @@ void Context::clearRect (const CRect& rect)
 		cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
 		cairo_rectangle (cr, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
 		cairo_fill (cr);
+		cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
 	}
 	checkCairoStatus (cr);
 }
@@ -454,9 +598,9 @@ void Context::drawGraphicsPath (CGraphicsPath* path, CDrawContext::PathDrawMode
 		{
 			auto p = cairoPath->getPath (
 				cr, needPixelAlignment (getDrawMode ()) ? &getCurrentTransform () : nullptr);
+			cairo_matrix_t currentMatrix;
 			if (transformation)
 			{
-				cairo_matrix_t currentMatrix;
 				cairo_matrix_t resultMatrix;
 				auto matrix = convert (*transformation);
 				cairo_get_matrix (cr, &currentMatrix);
@@ -477,6 +621,7 @@ void Context::drawGraphicsPath (CGraphicsPath* path, CDrawContext::PathDrawMode
 					setSourceColor (getFillColor ());
 					cairo_set_fill_rule (cr, CAIRO_FILL_RULE_EVEN_ODD);
 					cairo_fill (cr);
+					cairo_set_fill_rule (cr, CAIRO_FILL_RULE_WINDING);
 					break;
 				}
 				case PathDrawMode::kPathStroked:
@@ -487,6 +632,8 @@ void Context::drawGraphicsPath (CGraphicsPath* path, CDrawContext::PathDrawMode
 					break;
 				}
 			}
+			if (transformation)
+				cairo_set_matrix (cr, &currentMatrix);
 		}
 	}
 	checkCairoStatus (cr);
@@ -504,20 +651,24 @@ void Context::fillLinearGradient (CGraphicsPath* path, const CGradient& gradient
 			if (auto cd = DrawBlock::begin (*this))
 			{
 				auto p = cairoPath->getPath (cr);
-				cairo_append_path (cr, p);
-				cairo_set_source (cr, cairoGradient->getLinearGradient (startPoint, endPoint));
-				if (evenOdd)
-				{
-					cairo_set_fill_rule (cr, CAIRO_FILL_RULE_EVEN_ODD);
-					cairo_fill (cr);
-				}
-				else
+				cairo_matrix_t currentMatrix;
+				cairo_get_matrix (cr, &currentMatrix);
+				if (transformation)
 				{
-					cairo_fill (cr);
+					auto matrix = convert (*transformation);
+					cairo_transform (cr, &matrix);
 				}
+				cairo_append_path (cr, p);
+				cairo_matrix_t gradientMatrix;
+				auto hasMatrix =
+					Gradient::getLinearGradientMatrix (startPoint, endPoint, gradientMatrix);
+				fillGradient (cr, *cairoGradient, cairoGradient->getLinearGradient (),
+							  hasMatrix ? &gradientMatrix : nullptr, evenOdd);
+				cairo_set_matrix (cr, &currentMatrix);
 			}
 		}
 	}
+	checkCairoStatus (cr);
 }
 
 //-----------------------------------------------------------------------------
@@ -525,13 +676,49 @@ void Context::fillRadialGradient (CGraphicsPath* path, const CGradient& gradient
 								  const CPoint& center, CCoord radius, const CPoint& originOffset,
 								  bool evenOdd, CGraphicsTransform* transformation)
 {
-#warning TODO: Implementation
-	auto cd = DrawBlock::begin (*this);
-	if (cd)
+	if (auto cairoPath = dynamic_cast<Path*> (path))
 	{
+		if (auto cairoGradient = dynamic_cast<const Gradient*> (&gradient))
+		{
+			if (auto cd = DrawBlock::begin (*this))
+			{
+				auto p = cairoPath->getPath (cr);
+				cairo_matrix_t currentMatrix;
+				cairo_get_matrix (cr, &currentMatrix);
+				if (transformation)
+				{
+					auto matrix = convert (*transformation);
+					cairo_transform (cr, &matrix);
+				}
+				cairo_append_path (cr, p);
+				cairo_matrix_t gradientMatrix;
+				auto hasMatrix = Gradient::getRadialGradientMatrix (center, radius, gradientMatrix);
+				CPoint unitOffset;
+				if (hasMatrix)
+					unitOffset = CPoint (originOffset.x / radius, originOffset.y / radius);
+				fillGradient (cr, *cairoGradient, cairoGradient->getRadialGradient (unitOffset),
+							  hasMatrix ? &gradientMatrix : nullptr, evenOdd);
+				cairo_set_matrix (cr, &currentMatrix);
+			}
+		}
 	}
+	checkCairoStatus (cr);
 }
 
 //-----------------------------------------------------------------------------
 } // Cairo
+
+//-----------------------------------------------------------------------------
+SharedPointer<COffscreenContext> COffscreenContext::create (const CPoint& size, double scaleFactor)
+{
+	CPoint pixelSize (size.x * scaleFactor, size.y * scaleFactor);
+	auto bitmap = makeOwned<Cairo::Bitmap> (&pixelSize);
+	bitmap->setScaleFactor (scaleFactor);
+	auto context = makeOwned<Cairo::Context> (bitmap);
+	if (context->valid ())
+		return std::move (context);
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
 } // VSTGUI
@@ -27,12 +27,24 @@ public:
 	~Context ();
 
 	bool valid () const { return cr != nullptr; }
+
+	/** applies the clip, transform and antialias mode of the current state to the cairo context.
+	 *	Only the parts which changed since the last call are issued again, consecutive primitives
+	 *	share one cairo_save/cairo_restore pair. Returns false if the clip is empty.
+	 */
+	bool applyDrawState ();
+	/** restores the cairo state saved by applyDrawState () */
+	void resetDrawState ();
 	const SurfaceHandle& getSurface () const { return surface; }
 	const ContextHandle& getCairo () const { return cr; }
 
 	void drawLine (const LinePair& line) override;
 	void drawLines (const LineList& lines) override;
 	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override;
+	void drawPolyline (const CPoint* points, size_t numPoints) override;
+	void drawEnvelope (const CPoint* upper, const CPoint* lower, size_t numPoints,
+	                   const CDrawStyle drawStyle) override;
+	using super::drawPolyline;
 	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override;
 	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2,
 	              const CDrawStyle drawStyle) override;
@@ -66,6 +78,17 @@ private:
 
 	SurfaceHandle surface;
 	ContextHandle cr;
+
+	struct AppliedDrawState
+	{
+		CRect clip;
+		CGraphicsTransform transform;
+		cairo_antialias_t antialias {CAIRO_ANTIALIAS_DEFAULT};
+		bool saved {false};
+		bool transformValid {false};
+		bool antialiasValid {false};
+	};
+	AppliedDrawState appliedState;
 };
 
 //------------------------------------------------------------------------
@@ -73,7 +96,6 @@ struct DrawBlock
 {
 	static DrawBlock begin (Context& context);
 
-	~DrawBlock ();
 	operator bool () { return !clipIsEmpty; }
 private:
 	explicit DrawBlock (Context& context);
@@ -10,7 +10,9 @@
 #include <fontconfig/fontconfig.h>
 #include <freetype2/ft2build.h>
 #include <unordered_map>
+#include <atomic>
 #include <cassert>
+#include <mutex>
 
 #include FT_FREETYPE_H
 
@@ -20,6 +22,16 @@ namespace Cairo {
 namespace {
 
 struct FreeTypeFontFace;
+
+//------------------------------------------------------------------------
+// The FT_Library is not thread-safe and the faces of the FontList are created on first use, both
+// are guarded by this mutex so that fonts can be created on any thread.
+std::mutex& fontMutex ()
+{
+	static std::mutex gMutex;
+	return gMutex;
+}
+
 //------------------------------------------------------------------------
 class FreeType
 {
@@ -90,6 +102,7 @@ struct CairoFontFace
 
 	operator cairo_font_face_t* () const
 	{
+		std::lock_guard<std::mutex> guard (fontMutex ());
 		if (!face && !path.empty ())
 		{
 			ftFace = FreeType::instance ().createFromPath (path);
@@ -219,6 +232,39 @@ struct Font::Impl
 {
 	ScaledFontHandle font;
 	cairo_font_extents_t extents {};
+	/** identifies the font in the shaping cache of LinuxString, unlike the address of the scaled
+	 *	font it is never reused */
+	uint64_t id {nextID ()};
+
+	static uint64_t nextID ()
+	{
+		static std::atomic<uint64_t> gCounter {0};
+		return ++gCounter;
+	}
+
+	const LinuxString::Shaping* shape (const LinuxString& string) const
+	{
+		auto& shaping = string.getShaping ();
+		if (shaping.fontID == id)
+			return &shaping;
+		if (!font)
+			return nullptr;
+		cairo_glyph_t* glyphs = nullptr;
+		int numGlyphs = 0;
+		auto status = cairo_scaled_font_text_to_glyphs (font, 0., 0., string.data (),
+														static_cast<int> (string.length ()),
+														&glyphs, &numGlyphs, nullptr, nullptr,
+														nullptr);
+		if (status != CAIRO_STATUS_SUCCESS)
+			return nullptr;
+		shaping.glyphs.assign (glyphs, glyphs + numGlyphs);
+		cairo_glyph_free (glyphs);
+		cairo_text_extents_t e;
+		cairo_scaled_font_glyph_extents (font, shaping.glyphs.data (), numGlyphs, &e);
+		shaping.width = e.x_advance;
+		shaping.fontID = id;
+		return &shaping;
+	}
 };
 
 //------------------------------------------------------------------------
@@ -336,9 +382,17 @@ void Font::drawString (CDrawContext* context, IPlatformString* string, const CPo
 				auto alpha = color.alpha * cairoContext->getGlobalAlpha ();
 				cairo_set_source_rgba (cr, color.red / 255., color.green / 255., color.blue / 255.,
 									   alpha);
-				cairo_move_to (cr, p.x, p.y);
-				cairo_set_scaled_font (cr, impl->font);
-				cairo_show_text (cr, linuxString->get ().data ());
+				if (auto shaping = impl->shape (*linuxString))
+				{
+					// the cached glyphs are relative to the origin, the translation must not leak
+					// into the lazily applied draw state of the context
+					cairo_save (cr);
+					cairo_translate (cr, p.x, p.y);
+					cairo_set_scaled_font (cr, impl->font);
+					cairo_show_glyphs (cr, shaping->glyphs.data (),
+									   static_cast<int> (shaping->glyphs.size ()));
+					cairo_restore (cr);
+				}
 			}
 		}
 	}
@@ -349,9 +403,8 @@ CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, boo
 {
 	if (auto linuxString = dynamic_cast<LinuxString*> (string))
 	{
-		cairo_text_extents_t e;
-		cairo_scaled_font_text_extents (impl->font, linuxString->get ().data (), &e);
-		return e.x_advance;
+		if (auto shaping = impl->shape (*linuxString))
+			return shaping->width;
 	}
 	return 0;
 }
@@ -30,42 +30,65 @@ Gradient::~Gradient ()
 //------------------------------------------------------------------------
 void Gradient::destroy () const
 {
+	std::lock_guard<std::mutex> guard (mutex);
 	linearGradient.reset ();
 	radialGradient.reset ();
 }
 
 //------------------------------------------------------------------------
-const PatternHandle& Gradient::getLinearGradient (CPoint start, CPoint end) const
+PatternHandle Gradient::createPattern (cairo_pattern_t* pattern) const
 {
-	if (!linearGradient || start != linearGradientStart || end != linearGradientEnd)
-	{
-		destroy ();
-		linearGradientStart = start;
-		linearGradientEnd = end;
-		linearGradient =
-			PatternHandle (cairo_pattern_create_linear (start.x, start.y, end.x, end.y));
-		for (auto& it : this->colorStops)
-			cairo_pattern_add_color_stop_rgba (linearGradient, it.first, it.second.red / 255.,
-											   it.second.green / 255., it.second.blue / 255.,
-											   it.second.alpha);
-	}
+	for (auto& it : this->colorStops)
+		cairo_pattern_add_color_stop_rgba (pattern, it.first, it.second.red / 255.,
+										   it.second.green / 255., it.second.blue / 255.,
+										   it.second.alpha / 255.);
+	return PatternHandle (pattern);
+}
+
+//------------------------------------------------------------------------
+PatternHandle Gradient::getLinearGradient () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	if (!linearGradient)
+		linearGradient = createPattern (cairo_pattern_create_linear (0., 0., 1., 0.));
 	return linearGradient;
 }
 
 //------------------------------------------------------------------------
-const PatternHandle& Gradient::getRadialGradient () const
+PatternHandle Gradient::getRadialGradient (const CPoint& originOffset) const
 {
-	if (!radialGradient)
+	std::lock_guard<std::mutex> guard (mutex);
+	if (!radialGradient || originOffset != radialGradientOffset)
 	{
-		radialGradient = PatternHandle (cairo_pattern_create_radial (0, 0, 1, 0, 0, 1));
-		for (auto& it : this->colorStops)
-			cairo_pattern_add_color_stop_rgba (radialGradient, it.first, it.second.red / 255.,
-											   it.second.green / 255., it.second.blue / 255.,
-											   it.second.alpha);
+		radialGradientOffset = originOffset;
+		radialGradient = createPattern (
+			cairo_pattern_create_radial (originOffset.x, originOffset.y, 0., 0., 0., 1.));
 	}
 	return radialGradient;
 }
 
+//------------------------------------------------------------------------
+bool Gradient::getLinearGradientMatrix (const CPoint& start, const CPoint& end,
+										cairo_matrix_t& matrix)
+{
+	auto delta = end - start;
+	if (delta.x == 0. && delta.y == 0.)
+		return false;
+	// the x axis of the unit space runs along the gradient, the y axis perpendicular to it
+	cairo_matrix_init (&matrix, delta.x, delta.y, -delta.y, delta.x, start.x, start.y);
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool Gradient::getRadialGradientMatrix (const CPoint& center, CCoord radius,
+										cairo_matrix_t& matrix)
+{
+	if (radius <= 0.)
+		return false;
+	cairo_matrix_init (&matrix, radius, 0., 0., radius, center.x, center.y);
+	return true;
+}
+
 //------------------------------------------------------------------------
 } // Cairo
 } // VSTGUI
@@ -8,44 +8,58 @@
 #include "../../cpoint.h"
 #include "cairoutils.h"
 #include <cairo/cairo.h>
+#include <mutex>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
 namespace Cairo {
 
 //------------------------------------------------------------------------
+/** Cairo gradient
+ *
+ *	The patterns are created in unit space and are mapped to the geometry via the user space in
+ *	effect when they are set as source, so one pattern serves all geometries and contexts and is
+ *	never modified after creation. The linear pattern spans from (0, 0) to (1, 0), the radial
+ *	pattern from a circle with radius 0 at the origin offset to the unit circle.
+ */
 class Gradient : public CGradient
 {
 public:
 	Gradient (const ColorStopMap& colorStopMap);
 	~Gradient ();
 
+	using CGradient::addColorStop;
 	void addColorStop (const std::pair<double, CColor>& colorStop) override
 	{
 		destroy ();
 		CGradient::addColorStop (colorStop);
 	}
 
-#if VSTGUI_RVALUE_REF_SUPPORT
 	void addColorStop (std::pair<double, CColor>&& colorStop) override
 	{
 		destroy ();
 		CGradient::addColorStop (std::move (colorStop));
 	}
-#endif
 
-	const PatternHandle& getLinearGradient (CPoint start, CPoint end) const;
-	const PatternHandle& getRadialGradient () const;
+	PatternHandle getLinearGradient () const;
+	/** originOffset is relative to the radius */
+	PatternHandle getRadialGradient (const CPoint& originOffset = CPoint ()) const;
+
+	/** user space mapping the unit space of the linear pattern to start and end */
+	static bool getLinearGradientMatrix (const CPoint& start, const CPoint& end,
+										 cairo_matrix_t& matrix);
+	/** user space mapping the unit space of the radial pattern to center and radius */
+	static bool getRadialGradientMatrix (const CPoint& center, CCoord radius,
+										 cairo_matrix_t& matrix);
 
 private:
 	void destroy () const;
+	PatternHandle createPattern (cairo_pattern_t* pattern) const;
 
-	/* we want to calculate a normalized linear and radial gradiant */
+	mutable std::mutex mutex;
 	mutable PatternHandle linearGradient;
 	mutable PatternHandle radialGradient;
-
-	mutable CPoint linearGradientStart;
-	mutable CPoint linearGradientEnd;
+	mutable CPoint radialGradientOffset;
 };
 
 //------------------------------------------------------------------------
@@ -4,12 +4,110 @@
 
 #include "cairopath.h"
 #include "../../cgradient.h"
-#include "../../cgraphicstransform.h"
 #include "cairocontext.h"
+#include <algorithm>
+#include <cmath>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
 namespace Cairo {
+namespace {
+
+//------------------------------------------------------------------------
+struct ArcGeometry
+{
+	double centerX;
+	double centerY;
+	double radiusX;
+	double radiusY;
+	double startAngle;
+	double endAngle;
+
+	ArcGeometry (CCoord left, CCoord top, CCoord right, CCoord bottom, double startDegrees,
+				 double endDegrees)
+	{
+		radiusX = (right - left) / 2.;
+		radiusY = (bottom - top) / 2.;
+		centerX = left + radiusX;
+		centerY = top + radiusY;
+		startAngle = radians (startDegrees);
+		endAngle = radians (endDegrees);
+		if (radiusX != radiusY)
+		{
+			startAngle = atan2 (sin (startAngle) * radiusX, cos (startAngle) * radiusY);
+			endAngle = atan2 (sin (endAngle) * radiusX, cos (endAngle) * radiusY);
+		}
+	}
+
+	CPoint pointAt (double angle) const
+	{
+		return {centerX + radiusX * cos (angle), centerY + radiusY * sin (angle)};
+	}
+};
+
+//------------------------------------------------------------------------
+struct Bounds
+{
+	CRect rect;
+	bool empty {true};
+
+	void add (CCoord x, CCoord y)
+	{
+		if (empty)
+		{
+			rect = {x, y, x, y};
+			empty = false;
+			return;
+		}
+		rect.left = std::min (rect.left, x);
+		rect.top = std::min (rect.top, y);
+		rect.right = std::max (rect.right, x);
+		rect.bottom = std::max (rect.bottom, y);
+	}
+	void add (const CPoint& p) { add (p.x, p.y); }
+
+	/** add the extents of the arc swept by cairo_arc or cairo_arc_negative */
+	void add (const ArcGeometry& arc, bool clockwise)
+	{
+		auto a1 = arc.startAngle;
+		auto a2 = arc.endAngle;
+		if (clockwise)
+		{
+			while (a2 < a1)
+				a2 += 2. * M_PI;
+		}
+		else
+		{
+			while (a2 > a1)
+				a2 -= 2. * M_PI;
+			std::swap (a1, a2);
+		}
+		add (arc.pointAt (a1));
+		add (arc.pointAt (a2));
+		// the extreme points on the axes inside the sweep
+		auto quadrant = static_cast<int64_t> (std::ceil (a1 / (M_PI / 2.)));
+		for (auto i = 0; i < 4 && quadrant * (M_PI / 2.) <= a2; ++i, ++quadrant)
+		{
+			switch (((quadrant % 4) + 4) % 4)
+			{
+				case 0: add (arc.centerX + arc.radiusX, arc.centerY); break;
+				case 1: add (arc.centerX, arc.centerY + arc.radiusY); break;
+				case 2: add (arc.centerX - arc.radiusX, arc.centerY); break;
+				case 3: add (arc.centerX, arc.centerY - arc.radiusY); break;
+			}
+		}
+	}
+};
+
+//------------------------------------------------------------------------
+inline bool isSameAlignment (const CGraphicsTransform& t1, const CGraphicsTransform& t2)
+{
+	return t1.m11 == t2.m11 && t1.m12 == t2.m12 && t1.m21 == t2.m21 && t1.m22 == t2.m22 &&
+		   t1.dx == t2.dx && t1.dy == t2.dy;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
 
 //------------------------------------------------------------------------
 Path::Path (const ContextHandle& cr) noexcept : cr (cr)
@@ -32,44 +130,43 @@ CGradient* Path::createGradient (double color1Start, double color2Start,
 //------------------------------------------------------------------------
 bool Path::hitTest (const CPoint& p, bool evenOddFilled, CGraphicsTransform* transform)
 {
-#warning TODO: Implementation (use cairo_in_fill)
-	(void)p;
-	(void)evenOddFilled;
-	(void)transform;
-	return false;
+	auto cPath = getPath (cr);
+	if (!cPath)
+		return false;
+	cairo_save (cr);
+	cairo_new_path (cr);
+	if (transform)
+	{
+		cairo_matrix_t matrix = {transform->m11, transform->m21, transform->m12,
+								 transform->m22, transform->dx,	 transform->dy};
+		cairo_set_matrix (cr, &matrix);
+	}
+	else
+		cairo_identity_matrix (cr);
+	cairo_append_path (cr, cPath);
+	// the path is now in device space, test the point there
+	cairo_identity_matrix (cr);
+	cairo_set_fill_rule (cr, evenOddFilled ? CAIRO_FILL_RULE_EVEN_ODD : CAIRO_FILL_RULE_WINDING);
+	auto result = cairo_in_fill (cr, p.x, p.y) != 0;
+	cairo_new_path (cr);
+	cairo_restore (cr);
+	return result;
 }
 
 //------------------------------------------------------------------------
 CPoint Path::getCurrentPosition ()
 {
-	CPoint p;
-	if (auto cPath = getPath (cr))
-	{
-		cairo_save (cr);
-		cairo_new_path (cr);
-		cairo_append_path (cr, cPath);
-		cairo_get_current_point (cr, &p.x, &p.y);
-		cairo_restore (cr);
-	}
-	return p;
+	if (!boundsValid)
+		calculateBounds ();
+	return currentPosition;
 }
 
 //------------------------------------------------------------------------
 CRect Path::getBoundingBox ()
 {
-	CRect r;
-	if (auto cPath = getPath (cr))
-	{
-		cairo_save (cr);
-		cairo_new_path (cr);
-		cairo_append_path (cr, cPath);
-		CPoint p1, p2;
-		cairo_path_extents (cr, &p1.x, &p1.y, &p2.x, &p2.y);
-		cairo_restore (cr);
-		r.setTopLeft (p1);
-		r.setBottomRight (p2);
-	}
-	return r;
+	if (!boundsValid)
+		calculateBounds ();
+	return boundingBox;
 }
 
 //------------------------------------------------------------------------
@@ -80,118 +177,241 @@ void Path::dirty ()
 		cairo_path_destroy (path);
 		path = nullptr;
 	}
+	for (auto& entry : alignedPaths)
+	{
+		if (entry.path)
+		{
+			cairo_path_destroy (entry.path);
+			entry.path = nullptr;
+		}
+	}
+	boundsValid = false;
 }
 
 //------------------------------------------------------------------------
-cairo_path_t* Path::getPath (const ContextHandle& handle, const CGraphicsTransform* alignTm)
+void Path::calculateBounds ()
 {
-	if (alignTm)
-		dirty ();
-	if (!path)
+	// computed from the elements, bezier curves are bounded by their control points
+	Bounds bounds;
+	CPoint subpathStart;
+	CPoint current;
+	bool hasCurrentPoint = false;
+	for (auto& e : elements)
 	{
-		cairo_new_path (handle);
-		for (auto& e : elements)
+		switch (e.type)
 		{
-			switch (e.type)
+			case Element::Type::kBeginSubpath:
 			{
-				case Element::Type::kBeginSubpath:
-				{
-					cairo_new_sub_path (handle);
-					if (alignTm)
-					{
-						auto p = pixelAlign (*alignTm,
-											 CPoint {e.instruction.point.x, e.instruction.point.y});
-						cairo_move_to (handle, p.x - 0.5, p.y - 0.5);
-					}
-					else
-						cairo_move_to (handle, e.instruction.point.x, e.instruction.point.y);
+				current = subpathStart = CPoint {e.instruction.point.x, e.instruction.point.y};
+				hasCurrentPoint = true;
+				bounds.add (current);
+				break;
+			}
+			case Element::Type::kCloseSubpath:
+			{
+				if (hasCurrentPoint)
+					current = subpathStart;
+				break;
+			}
+			case Element::Type::kLine:
+			{
+				current = CPoint {e.instruction.point.x, e.instruction.point.y};
+				if (!hasCurrentPoint)
+					subpathStart = current;
+				hasCurrentPoint = true;
+				bounds.add (current);
+				break;
+			}
+			case Element::Type::kBezierCurve:
+			{
+				auto& curve = e.instruction.curve;
+				if (!hasCurrentPoint)
+					subpathStart = CPoint {curve.control1.x, curve.control1.y};
+				bounds.add (curve.control1.x, curve.control1.y);
+				bounds.add (curve.control2.x, curve.control2.y);
+				bounds.add (curve.end.x, curve.end.y);
+				current = CPoint {curve.end.x, curve.end.y};
+				hasCurrentPoint = true;
+				break;
+			}
+			case Element::Type::kRect:
+			{
+				auto& r = e.instruction.rect;
+				bounds.add (r.left, r.top);
+				bounds.add (r.right, r.bottom);
+				current = subpathStart = CPoint {r.left, r.top};
+				hasCurrentPoint = true;
+				break;
+			}
+			case Element::Type::kEllipse:
+			{
+				auto& r = e.instruction.rect;
+				if (r.right == r.left || r.bottom == r.top)
 					break;
-				}
-				case Element::Type::kCloseSubpath:
+				bounds.add (r.left, r.top);
+				bounds.add (r.right, r.bottom);
+				current = subpathStart = CPoint {std::max (r.left, r.right), (r.top + r.bottom) / 2.};
+				hasCurrentPoint = true;
+				break;
+			}
+			case Element::Type::kArc:
+			{
+				auto& arc = e.instruction.arc;
+				ArcGeometry geometry (arc.rect.left, arc.rect.top, arc.rect.right, arc.rect.bottom,
+									  arc.startAngle, arc.endAngle);
+				bounds.add (geometry, arc.clockwise);
+				if (!hasCurrentPoint)
+					subpathStart = geometry.pointAt (geometry.startAngle);
+				current = geometry.pointAt (geometry.endAngle);
+				hasCurrentPoint = true;
+				break;
+			}
+		}
+	}
+	boundingBox = bounds.empty ? CRect () : bounds.rect;
+	currentPosition = hasCurrentPoint ? current : CPoint ();
+	boundsValid = true;
+}
+
+//------------------------------------------------------------------------
+cairo_path_t* Path::getPath (const ContextHandle& handle, const CGraphicsTransform* alignTm)
+{
+	if (!alignTm)
+	{
+		if (!path)
+			path = createPath (handle, nullptr);
+		return path;
+	}
+
+	CGraphicsTransform key = *alignTm;
+	key.dx -= std::floor (key.dx);
+	key.dy -= std::floor (key.dy);
+
+	auto entry = alignedPaths.begin ();
+	for (auto it = alignedPaths.begin (); it != alignedPaths.end (); ++it)
+	{
+		if (it->path && isSameAlignment (it->key, key))
+		{
+			it->lastUsed = ++useCounter;
+			return it->path;
+		}
+		if (!it->path || (entry->path && it->lastUsed < entry->lastUsed))
+			entry = it;
+	}
+	if (entry->path)
+		cairo_path_destroy (entry->path);
+	entry->key = key;
+	entry->path = createPath (handle, &key);
+	entry->lastUsed = ++useCounter;
+	return entry->path;
+}
+
+//------------------------------------------------------------------------
+cairo_path_t* Path::createPath (const ContextHandle& handle,
+								const CGraphicsTransform* alignTm) const
+{
+	cairo_new_path (handle);
+	for (auto& e : elements)
+	{
+		switch (e.type)
+		{
+			case Element::Type::kBeginSubpath:
+			{
+				cairo_new_sub_path (handle);
+				if (alignTm)
 				{
-					cairo_close_path (handle);
-					break;
+					auto p =
+						pixelAlign (*alignTm, CPoint {e.instruction.point.x, e.instruction.point.y});
+					cairo_move_to (handle, p.x - 0.5, p.y - 0.5);
 				}
-				case Element::Type::kLine:
+				else
+					cairo_move_to (handle, e.instruction.point.x, e.instruction.point.y);
+				break;
+			}
+			case Element::Type::kCloseSubpath:
+			{
+				cairo_close_path (handle);
+				break;
+			}
+			case Element::Type::kLine:
+			{
+				if (alignTm)
 				{
-					if (alignTm)
-					{
-						auto p = pixelAlign (*alignTm,
-											 CPoint {e.instruction.point.x, e.instruction.point.y});
-						cairo_line_to (handle, p.x - 0.5, p.y - 0.5);
-					}
-					else
-						cairo_line_to (handle, e.instruction.point.x, e.instruction.point.y);
-					break;
+					auto p =
+						pixelAlign (*alignTm, CPoint {e.instruction.point.x, e.instruction.point.y});
+					cairo_line_to (handle, p.x - 0.5, p.y - 0.5);
 				}
-				case Element::Type::kBezierCurve:
+				else
+					cairo_line_to (handle, e.instruction.point.x, e.instruction.point.y);
+				break;
+			}
+			case Element::Type::kBezierCurve:
+			{
+				cairo_curve_to (handle, e.instruction.curve.control1.x,
+								e.instruction.curve.control1.y, e.instruction.curve.control2.x,
+								e.instruction.curve.control2.y, e.instruction.curve.end.x,
+								e.instruction.curve.end.y);
+				break;
+			}
+			case Element::Type::kRect:
+			{
+				if (alignTm)
 				{
-					cairo_curve_to (handle, e.instruction.curve.control1.x,
-									e.instruction.curve.control1.y, e.instruction.curve.control2.x,
-									e.instruction.curve.control2.y, e.instruction.curve.end.x,
-									e.instruction.curve.end.y);
-					break;
+					auto r = pixelAlign (
+						*alignTm, CRect {e.instruction.rect.left, e.instruction.rect.top,
+										 e.instruction.rect.right, e.instruction.rect.bottom});
+					cairo_rectangle (handle, r.left - 0.5, r.top - 0.5, r.getWidth (),
+									 r.getHeight ());
 				}
-				case Element::Type::kRect:
+				else
 				{
-					if (alignTm)
-					{
-						auto r = pixelAlign (
-							*alignTm, CRect {e.instruction.rect.left, e.instruction.rect.top,
-											 e.instruction.rect.right, e.instruction.rect.bottom});
-						cairo_rectangle (handle, r.left - 0.5, r.top - 0.5, r.getWidth (),
-										 r.getHeight ());
-					}
-					else
-					{
-						cairo_rectangle (handle, e.instruction.rect.left, e.instruction.rect.top,
-										 e.instruction.rect.right - e.instruction.rect.left,
-										 e.instruction.rect.bottom - e.instruction.rect.top);
-					}
-					break;
+					cairo_rectangle (handle, e.instruction.rect.left, e.instruction.rect.top,
+									 e.instruction.rect.right - e.instruction.rect.left,
+									 e.instruction.rect.bottom - e.instruction.rect.top);
 				}
-				case Element::Type::kEllipse: {
-#warning TODO: Implementation Element::Type::kEllipse
+				break;
+			}
+			case Element::Type::kEllipse:
+			{
+				auto& r = e.instruction.rect;
+				if (r.right == r.left || r.bottom == r.top)
 					break;
+				cairo_matrix_t matrix;
+				cairo_get_matrix (handle, &matrix);
+				cairo_new_sub_path (handle);
+				cairo_translate (handle, (r.left + r.right) / 2., (r.top + r.bottom) / 2.);
+				cairo_scale (handle, std::abs (r.right - r.left) / 2.,
+							 std::abs (r.bottom - r.top) / 2.);
+				cairo_arc (handle, 0, 0, 1, 0, 2. * M_PI);
+				cairo_set_matrix (handle, &matrix);
+				cairo_close_path (handle);
+				break;
+			}
+			case Element::Type::kArc:
+			{
+				auto& arc = e.instruction.arc;
+				ArcGeometry geometry (arc.rect.left, arc.rect.top, arc.rect.right, arc.rect.bottom,
+									  arc.startAngle, arc.endAngle);
+				cairo_matrix_t matrix;
+				cairo_get_matrix (handle, &matrix);
+				cairo_translate (handle, geometry.centerX, geometry.centerY);
+				cairo_scale (handle, geometry.radiusX, geometry.radiusY);
+				if (arc.clockwise)
+				{
+					cairo_arc (handle, 0, 0, 1, geometry.startAngle, geometry.endAngle);
 				}
-				case Element::Type::kArc:
+				else
 				{
-					auto radiusX =
-						(e.instruction.arc.rect.right - e.instruction.arc.rect.left) / 2.;
-					auto radiusY =
-						(e.instruction.arc.rect.bottom - e.instruction.arc.rect.top) / 2.;
-
-					auto centerX = static_cast<double> (e.instruction.arc.rect.left + radiusX);
-					auto centerY = static_cast<double> (e.instruction.arc.rect.top + radiusY);
-
-					double startAngle = radians (e.instruction.arc.startAngle);
-					double endAngle = radians (e.instruction.arc.endAngle);
-					if (radiusX != radiusY)
-					{
-						startAngle = atan2 (sin (startAngle) * radiusX, cos (startAngle) * radiusY);
-						endAngle = atan2 (sin (endAngle) * radiusX, cos (endAngle) * radiusY);
-					}
-					cairo_matrix_t matrix;
-					cairo_get_matrix (handle, &matrix);
-					cairo_translate (handle, centerX, centerY);
-					cairo_scale (handle, radiusX, radiusY);
-					if (e.instruction.arc.clockwise)
-					{
-						cairo_arc (handle, 0, 0, 1, startAngle, endAngle);
-					}
-					else
-					{
-						cairo_arc_negative (handle, 0, 0, 1, startAngle, endAngle);
-					}
-					cairo_set_matrix (handle, &matrix);
-					break;
+					cairo_arc_negative (handle, 0, 0, 1, geometry.startAngle, geometry.endAngle);
 				}
+				cairo_set_matrix (handle, &matrix);
+				break;
 			}
 		}
-		path = cairo_copy_path (handle);
-		cairo_new_path (handle); // clear path
 	}
-	return path;
+	auto result = cairo_copy_path (handle);
+	cairo_new_path (handle); // clear path
+	return result;
 }
 
 //------------------------------------------------------------------------
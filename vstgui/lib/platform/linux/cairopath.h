@@ -5,7 +5,9 @@
 #pragma once
 
 #include "../../cgraphicspath.h"
+#include "../../cgraphicstransform.h"
 #include "cairoutils.h"
+#include <array>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -33,8 +35,27 @@ public:
 
 //------------------------------------------------------------------------
 private:
+	/** pixel aligned paths are cached per alignment transform. The integral part of the
+	 *	translation does not change the aligned path in user space, so it is not part of the key.
+	 */
+	struct AlignedPath
+	{
+		CGraphicsTransform key;
+		cairo_path_t* path {nullptr};
+		uint32_t lastUsed {0};
+	};
+	static constexpr size_t kNumAlignedPaths = 4;
+
+	cairo_path_t* createPath (const ContextHandle& handle, const CGraphicsTransform* alignTm) const;
+	void calculateBounds ();
+
 	ContextHandle cr;
 	cairo_path_t* path {nullptr};
+	std::array<AlignedPath, kNumAlignedPaths> alignedPaths;
+	uint32_t useCounter {0};
+	CRect boundingBox;
+	CPoint currentPosition;
+	bool boundsValid {false};
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairopixelbufferpool.h"
+#include <cstring>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+namespace {
+
+//------------------------------------------------------------------------
+cairo_user_data_key_t gPixelBufferKey;
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+struct PixelBufferPool::Buffer
+{
+	explicit Buffer (size_t size) : size (size), data (new uint8_t[size]) {}
+
+	size_t size;
+	std::unique_ptr<uint8_t[]> data;
+	uint64_t releaseCount {0};
+};
+
+//------------------------------------------------------------------------
+PixelBufferPool& PixelBufferPool::instance ()
+{
+	// never destroyed, surfaces may still be released during static destruction
+	static auto gInstance = new PixelBufferPool;
+	return *gInstance;
+}
+
+//------------------------------------------------------------------------
+size_t PixelBufferPool::getSizeClass (size_t bytes)
+{
+	size_t powerOfTwo = 1;
+	while (powerOfTwo <= bytes / 2)
+		powerOfTwo *= 2;
+	auto step = powerOfTwo < 4 ? 1 : powerOfTwo / 4;
+	return (bytes + step - 1) / step * step;
+}
+
+//------------------------------------------------------------------------
+SurfaceHandle PixelBufferPool::createSurface (int width, int height)
+{
+	auto stride = cairo_format_stride_for_width (CAIRO_FORMAT_ARGB32, width);
+	if (width <= 0 || height <= 0 || stride <= 0)
+		return SurfaceHandle (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+	auto bytes = static_cast<size_t> (stride) * static_cast<size_t> (height);
+	if (bytes < kMinPooledBytes)
+		return SurfaceHandle (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+
+	auto buffer = acquire (getSizeClass (bytes));
+	memset (buffer->data.get (), 0, bytes);
+	SurfaceHandle surface (cairo_image_surface_create_for_data (
+		buffer->data.get (), CAIRO_FORMAT_ARGB32, width, height, stride));
+	if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS ||
+		cairo_surface_set_user_data (surface, &gPixelBufferKey, buffer.get (),
+									 releaseSurfaceData) != CAIRO_STATUS_SUCCESS)
+	{
+		surface.reset ();
+		release (std::move (buffer));
+		return SurfaceHandle (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+	}
+	// the buffer is owned by the surface from now on and returned by releaseSurfaceData
+	buffer.release ();
+	return surface;
+}
+
+//------------------------------------------------------------------------
+void PixelBufferPool::releaseSurfaceData (void* data)
+{
+	instance ().release (BufferPtr (static_cast<Buffer*> (data)));
+}
+
+//------------------------------------------------------------------------
+auto PixelBufferPool::acquire (size_t sizeClass) -> BufferPtr
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		auto it = unusedBuffers.find (sizeClass);
+		if (it != unusedBuffers.end ())
+		{
+			// the most recently returned buffer is the most likely one to be still resident
+			auto buffer = std::move (it->second.back ());
+			it->second.pop_back ();
+			if (it->second.empty ())
+				unusedBuffers.erase (it);
+			pooledBytes -= buffer->size;
+			return buffer;
+		}
+	}
+	return BufferPtr (new Buffer (sizeClass));
+}
+
+//------------------------------------------------------------------------
+void PixelBufferPool::release (BufferPtr&& buffer)
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	buffer->releaseCount = ++releaseCounter;
+	pooledBytes += buffer->size;
+	unusedBuffers[buffer->size].push_back (std::move (buffer));
+	trimLocked (highWaterMark);
+}
+
+//------------------------------------------------------------------------
+void PixelBufferPool::trimLocked (size_t maxBytes)
+{
+	while (pooledBytes > maxBytes)
+	{
+		auto oldest = unusedBuffers.begin ();
+		for (auto it = unusedBuffers.begin (); it != unusedBuffers.end (); ++it)
+		{
+			if (it->second.front ()->releaseCount < oldest->second.front ()->releaseCount)
+				oldest = it;
+		}
+		pooledBytes -= oldest->second.front ()->size;
+		oldest->second.pop_front ();
+		if (oldest->second.empty ())
+			unusedBuffers.erase (oldest);
+	}
+}
+
+//------------------------------------------------------------------------
+void PixelBufferPool::trim (size_t maxBytes)
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	trimLocked (maxBytes);
+}
+
+//------------------------------------------------------------------------
+void PixelBufferPool::setHighWaterMark (size_t bytes)
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	highWaterMark = bytes;
+	trimLocked (highWaterMark);
+}
+
+//------------------------------------------------------------------------
+size_t PixelBufferPool::getHighWaterMark () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return highWaterMark;
+}
+
+//------------------------------------------------------------------------
+size_t PixelBufferPool::getPooledBytes () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return pooledBytes;
+}
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
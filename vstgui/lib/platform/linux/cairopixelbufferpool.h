@@ -0,0 +1,74 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cairoutils.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+/** Pool of pixel buffers for image surfaces
+ *
+ *	Offscreen contexts and bitmaps are often short lived and large. Their pixel buffers are
+ *	returned to the pool when the surface is destroyed and reused by the next surface of the same
+ *	size class, this avoids the allocation and page faults of a fresh buffer on every frame.
+ *
+ *	Buffers are grouped in size classes of four steps per power of two. Surfaces smaller than
+ *	kMinPooledBytes are not pooled. When the unused buffers exceed the high water mark, the least
+ *	recently returned buffers are freed.
+ */
+class PixelBufferPool
+{
+public:
+	static constexpr size_t kMinPooledBytes = 64 * 1024;
+	static constexpr size_t kDefaultHighWaterMark = 64 * 1024 * 1024;
+
+	static PixelBufferPool& instance ();
+
+	/** create an ARGB32 image surface cleared to transparent black */
+	SurfaceHandle createSurface (int width, int height);
+
+	/** maximum size of all unused buffers in bytes */
+	void setHighWaterMark (size_t bytes);
+	size_t getHighWaterMark () const;
+
+	/** size of all unused buffers in bytes */
+	size_t getPooledBytes () const;
+
+	/** free unused buffers until at most maxBytes are left */
+	void trim (size_t maxBytes = 0);
+
+	static size_t getSizeClass (size_t bytes);
+
+private:
+	struct Buffer;
+	using BufferPtr = std::unique_ptr<Buffer>;
+
+	PixelBufferPool () = default;
+
+	BufferPtr acquire (size_t sizeClass);
+	void release (BufferPtr&& buffer);
+	void trimLocked (size_t maxBytes);
+
+	static void releaseSurfaceData (void* data);
+
+	mutable std::mutex mutex;
+	std::map<size_t, std::deque<BufferPtr>> unusedBuffers;
+	size_t pooledBytes {0};
+	size_t highWaterMark {kDefaultHighWaterMark};
+	uint64_t releaseCounter {0};
+};
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
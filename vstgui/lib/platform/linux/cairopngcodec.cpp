@@ -0,0 +1,350 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairopngcodec.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+#include <png.h>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+namespace PNGCodec {
+namespace {
+
+//------------------------------------------------------------------------
+std::atomic<int> gCompressionLevel {6};
+
+//------------------------------------------------------------------------
+/** calls proc (firstRow, endRow) for bands of rows, large images are split across threads */
+template <typename Proc>
+void forEachBand (uint32_t width, uint32_t height, Proc proc)
+{
+	uint32_t numBands = 1;
+	if (static_cast<uint64_t> (width) * height >= kParallelPixelThreshold)
+		numBands = std::min (std::max (std::thread::hardware_concurrency (), 1u), 8u);
+	numBands = std::min (numBands, height);
+	if (numBands <= 1)
+	{
+		proc (0u, height);
+		return;
+	}
+	auto rowsPerBand = (height + numBands - 1) / numBands;
+	std::vector<std::thread> threads;
+	threads.reserve (numBands - 1);
+	for (auto row = rowsPerBand; row < height; row += rowsPerBand)
+		threads.emplace_back (proc, row, std::min (row + rowsPerBand, height));
+	proc (0u, rowsPerBand);
+	for (auto& thread : threads)
+		thread.join ();
+}
+
+//------------------------------------------------------------------------
+/** same rounding as cairo's own PNG loader */
+inline uint32_t multiplyAlpha (uint32_t alpha, uint32_t color)
+{
+	auto temp = alpha * color + 0x80;
+	return (temp + (temp >> 8)) >> 8;
+}
+
+//------------------------------------------------------------------------
+/** pixels are native 0xAARRGGBB values, independent of the byte order */
+void premultiplyRows (uint8_t* data, uint32_t stride, uint32_t width, uint32_t firstRow,
+					  uint32_t endRow)
+{
+	for (auto y = firstRow; y < endRow; ++y)
+	{
+		auto pixel = reinterpret_cast<uint32_t*> (data + y * stride);
+		for (auto end = pixel + width; pixel != end; ++pixel)
+		{
+			auto alpha = *pixel >> 24;
+			if (alpha == 0xFF)
+				continue;
+			if (alpha == 0)
+			{
+				*pixel = 0;
+				continue;
+			}
+			*pixel = (alpha << 24) | (multiplyAlpha (alpha, (*pixel >> 16) & 0xFF) << 16) |
+					 (multiplyAlpha (alpha, (*pixel >> 8) & 0xFF) << 8) |
+					 multiplyAlpha (alpha, *pixel & 0xFF);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+inline uint8_t unpremultiply (uint32_t alpha, uint32_t color)
+{
+	return static_cast<uint8_t> ((color * 255 + alpha / 2) / alpha);
+}
+
+//------------------------------------------------------------------------
+/** writes RGBA bytes with straight alpha, RGB24 surfaces get an opaque alpha */
+void unpremultiplyRows (const uint8_t* data, uint32_t stride, uint32_t width, bool hasAlpha,
+						uint8_t* out, uint32_t firstRow, uint32_t endRow)
+{
+	for (auto y = firstRow; y < endRow; ++y)
+	{
+		auto pixel = reinterpret_cast<const uint32_t*> (data + y * stride);
+		auto dst = out + static_cast<size_t> (y) * width * 4;
+		for (auto end = pixel + width; pixel != end; ++pixel, dst += 4)
+		{
+			auto alpha = hasAlpha ? *pixel >> 24 : 0xFF;
+			uint32_t r = (*pixel >> 16) & 0xFF;
+			uint32_t g = (*pixel >> 8) & 0xFF;
+			uint32_t b = *pixel & 0xFF;
+			if (alpha != 0xFF && alpha != 0)
+			{
+				r = unpremultiply (alpha, r);
+				g = unpremultiply (alpha, g);
+				b = unpremultiply (alpha, b);
+			}
+			else if (alpha == 0)
+			{
+				r = g = b = 0;
+			}
+			dst[0] = static_cast<uint8_t> (r);
+			dst[1] = static_cast<uint8_t> (g);
+			dst[2] = static_cast<uint8_t> (b);
+			dst[3] = static_cast<uint8_t> (alpha);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+struct ReadState
+{
+	const uint8_t* ptr;
+	size_t size;
+};
+
+//------------------------------------------------------------------------
+void readData (png_structp png, png_bytep out, png_size_t length)
+{
+	auto state = static_cast<ReadState*> (png_get_io_ptr (png));
+	if (length > state->size)
+		png_error (png, "unexpected end of data");
+	memcpy (out, state->ptr, length);
+	state->ptr += length;
+	state->size -= length;
+}
+
+//------------------------------------------------------------------------
+void writeData (png_structp png, png_bytep data, png_size_t length)
+{
+	auto buffer = static_cast<PNGBitmapBuffer*> (png_get_io_ptr (png));
+	bool failed = false;
+	try
+	{
+		buffer->insert (buffer->end (), data, data + length);
+	}
+	catch (const std::bad_alloc&)
+	{
+		failed = true;
+	}
+	if (failed)
+		png_error (png, "out of memory");
+}
+
+//------------------------------------------------------------------------
+void flushData (png_structp) {}
+
+//------------------------------------------------------------------------
+void handleError (png_structp png, png_const_charp)
+{
+	png_longjmp (png, 1);
+}
+
+//------------------------------------------------------------------------
+void ignoreWarning (png_structp, png_const_charp) {}
+
+// libpng reports errors with longjmp, so the functions calling setjmp must not own any objects
+// with destructors
+
+//------------------------------------------------------------------------
+bool readHeader (png_structp png, png_infop info, png_uint_32& width, png_uint_32& height)
+{
+	if (setjmp (png_jmpbuf (png)))
+		return false;
+	png_read_info (png, info);
+
+	auto colorType = png_get_color_type (png, info);
+	auto bitDepth = png_get_bit_depth (png, info);
+	if (colorType == PNG_COLOR_TYPE_PALETTE)
+		png_set_palette_to_rgb (png);
+	if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8)
+		png_set_expand_gray_1_2_4_to_8 (png);
+	if (png_get_valid (png, info, PNG_INFO_tRNS))
+		png_set_tRNS_to_alpha (png);
+	if (bitDepth == 16)
+		png_set_strip_16 (png);
+	if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
+		png_set_gray_to_rgb (png);
+	if (png_get_interlace_type (png, info) != PNG_INTERLACE_NONE)
+		png_set_interlace_handling (png);
+	// produce the in memory layout of native 0xAARRGGBB pixels
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	png_set_bgr (png);
+	png_set_filler (png, 0xFF, PNG_FILLER_AFTER);
+#else
+	png_set_filler (png, 0xFF, PNG_FILLER_BEFORE);
+	png_set_swap_alpha (png);
+#endif
+	png_read_update_info (png, info);
+
+	width = png_get_image_width (png, info);
+	height = png_get_image_height (png, info);
+	return png_get_rowbytes (png, info) == static_cast<png_size_t> (width) * 4;
+}
+
+//------------------------------------------------------------------------
+bool readImage (png_structp png, png_bytepp rows)
+{
+	if (setjmp (png_jmpbuf (png)))
+		return false;
+	png_read_image (png, rows);
+	png_read_end (png, nullptr);
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool writeImage (png_structp png, png_infop info, uint32_t width, uint32_t height,
+				 int compressionLevel, png_bytepp rows, PNGBitmapBuffer* buffer)
+{
+	if (setjmp (png_jmpbuf (png)))
+		return false;
+	png_set_write_fn (png, buffer, writeData, flushData);
+	png_set_compression_level (png, compressionLevel);
+	png_set_IHDR (png, info, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
+				  PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+	png_write_info (png, info);
+	png_write_image (png, rows);
+	png_write_end (png, info);
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+SurfaceHandle decode (const uint8_t* data, size_t size)
+{
+	if (!data || size < 8 || png_sig_cmp (const_cast<png_bytep> (data), 0, 8) != 0)
+		return {};
+
+	auto png = png_create_read_struct (PNG_LIBPNG_VER_STRING, nullptr, handleError, ignoreWarning);
+	if (!png)
+		return {};
+	auto info = png_create_info_struct (png);
+	if (!info)
+	{
+		png_destroy_read_struct (&png, nullptr, nullptr);
+		return {};
+	}
+	ReadState state {data, size};
+	png_set_read_fn (png, &state, readData);
+
+	SurfaceHandle surface;
+	png_uint_32 width = 0;
+	png_uint_32 height = 0;
+	if (readHeader (png, info, width, height))
+	{
+		surface.assign (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, static_cast<int> (width),
+													static_cast<int> (height)));
+		if (cairo_surface_status (surface) == CAIRO_STATUS_SUCCESS)
+		{
+			auto pixels = cairo_image_surface_get_data (surface);
+			auto stride = static_cast<uint32_t> (cairo_image_surface_get_stride (surface));
+			std::vector<png_bytep> rows (height);
+			for (png_uint_32 y = 0; y < height; ++y)
+				rows[y] = pixels + y * stride;
+			if (readImage (png, rows.data ()))
+			{
+				forEachBand (width, height, [&] (uint32_t firstRow, uint32_t endRow) {
+					premultiplyRows (pixels, stride, width, firstRow, endRow);
+				});
+				cairo_surface_mark_dirty (surface);
+			}
+			else
+				surface.reset ();
+		}
+		else
+			surface.reset ();
+	}
+	png_destroy_read_struct (&png, &info, nullptr);
+	return surface;
+}
+
+//------------------------------------------------------------------------
+PNGBitmapBuffer encode (cairo_surface_t* surface, int compressionLevel)
+{
+	if (!surface || cairo_surface_get_type (surface) != CAIRO_SURFACE_TYPE_IMAGE)
+		return {};
+	auto format = cairo_image_surface_get_format (surface);
+	if (format != CAIRO_FORMAT_ARGB32 && format != CAIRO_FORMAT_RGB24)
+		return {};
+	cairo_surface_flush (surface);
+	auto width = static_cast<uint32_t> (cairo_image_surface_get_width (surface));
+	auto height = static_cast<uint32_t> (cairo_image_surface_get_height (surface));
+	auto stride = static_cast<uint32_t> (cairo_image_surface_get_stride (surface));
+	auto data = cairo_image_surface_get_data (surface);
+	if (!data || width == 0 || height == 0)
+		return {};
+
+	auto bytesPerRow = static_cast<size_t> (width) * 4;
+	std::vector<uint8_t> pixels (bytesPerRow * height);
+	auto hasAlpha = format == CAIRO_FORMAT_ARGB32;
+	forEachBand (width, height, [&] (uint32_t firstRow, uint32_t endRow) {
+		unpremultiplyRows (data, stride, width, hasAlpha, pixels.data (), firstRow, endRow);
+	});
+	std::vector<png_bytep> rows (height);
+	for (uint32_t y = 0; y < height; ++y)
+		rows[y] = pixels.data () + y * bytesPerRow;
+
+	PNGBitmapBuffer buffer;
+	// typical images compress to less than half of their size, this avoids most reallocations
+	buffer.reserve (pixels.size () / 2 + 1024);
+
+	auto png = png_create_write_struct (PNG_LIBPNG_VER_STRING, nullptr, handleError, ignoreWarning);
+	if (!png)
+		return {};
+	auto info = png_create_info_struct (png);
+	if (!info)
+	{
+		png_destroy_write_struct (&png, nullptr);
+		return {};
+	}
+	if (!writeImage (png, info, width, height, std::min (std::max (compressionLevel, 0), 9),
+					 rows.data (), &buffer))
+		buffer.clear ();
+	png_destroy_write_struct (&png, &info);
+	return buffer;
+}
+
+//------------------------------------------------------------------------
+PNGBitmapBuffer encode (cairo_surface_t* surface)
+{
+	return encode (surface, getCompressionLevel ());
+}
+
+//------------------------------------------------------------------------
+void setCompressionLevel (int level)
+{
+	gCompressionLevel = std::min (std::max (level, 0), 9);
+}
+
+//------------------------------------------------------------------------
+int getCompressionLevel ()
+{
+	return gCompressionLevel;
+}
+
+//------------------------------------------------------------------------
+} // PNGCodec
+} // Cairo
+} // VSTGUI
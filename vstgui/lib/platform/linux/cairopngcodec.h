@@ -0,0 +1,44 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../iplatformbitmap.h"
+#include "cairoutils.h"
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+/** PNG decoder and encoder working directly on the pixels of cairo image surfaces
+ *
+ *	The decoder lets libpng write the rows into the stride of an ARGB32 surface and premultiplies
+ *	them in place. The encoder un-premultiplies into one buffer and compresses it into a buffer
+ *	which is pre-sized from the image size. The zlib stream itself is sequential, the per pixel
+ *	conversions of large images run in bands on several threads.
+ */
+namespace PNGCodec {
+
+/** decode PNG data into a premultiplied ARGB32 image surface, returns an empty handle on error */
+SurfaceHandle decode (const uint8_t* data, size_t size);
+
+/** encode an ARGB32 or RGB24 image surface with the zlib compression level 0 (fastest) to 9 */
+PNGBitmapBuffer encode (cairo_surface_t* surface, int compressionLevel);
+/** encode with the compression level set via setCompressionLevel */
+PNGBitmapBuffer encode (cairo_surface_t* surface);
+
+/** compression level used by IPlatformBitmap::createMemoryPNGRepresentation, defaults to 6 */
+void setCompressionLevel (int level);
+int getCompressionLevel ();
+
+/** images with at least this number of pixels are converted in bands on several threads */
+constexpr uint32_t kParallelPixelThreshold = 512 * 512;
+
+//------------------------------------------------------------------------
+} // PNGCodec
+} // Cairo
+} // VSTGUI
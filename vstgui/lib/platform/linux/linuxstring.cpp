@@ -14,7 +14,21 @@ SharedPointer<IPlatformString> IPlatformString::createWithUTF8String (UTF8String
 }
 
 //------------------------------------------------------------------------
-LinuxString::LinuxString (UTF8StringPtr utf8String) : str (utf8String)
+SharedPointer<IPlatformString> IPlatformString::createWithUTF8StringReference (
+	UTF8StringPtr utf8String, size_t length)
+{
+	return owned (new LinuxString (utf8String, length));
+}
+
+//------------------------------------------------------------------------
+LinuxString::LinuxString (UTF8StringPtr utf8String)
+{
+	setUTF8String (utf8String);
+}
+
+//------------------------------------------------------------------------
+LinuxString::LinuxString (UTF8StringPtr utf8String, size_t length)
+: ptr (utf8String ? utf8String : ""), len (utf8String ? length : 0)
 {
 }
 
@@ -22,6 +36,20 @@ LinuxString::LinuxString (UTF8StringPtr utf8String) : str (utf8String)
 void LinuxString::setUTF8String (UTF8StringPtr utf8String)
 {
 	str = utf8String ? utf8String : "";
+	ptr = str.data ();
+	len = str.length ();
+	shaping = {};
+}
+
+//------------------------------------------------------------------------
+void LinuxString::updateUTF8StringReference (UTF8StringPtr utf8String, size_t length)
+{
+	// only a referencing string follows the storage, the content and so the shaping stays valid
+	if (isReference ())
+	{
+		ptr = utf8String ? utf8String : "";
+		len = utf8String ? length : 0;
+	}
 }
 
 //------------------------------------------------------------------------
@@ -5,6 +5,10 @@
 #pragma once
 
 #include "../iplatformstring.h"
+#include "../../vstguifwd.h"
+#include <cairo/cairo.h>
+#include <string>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -13,12 +17,35 @@ namespace VSTGUI {
 class LinuxString : public IPlatformString
 {
 public:
+	/** Shaping result of the string for one font, the glyph positions are relative to the origin */
+	struct Shaping
+	{
+		uint64_t fontID {0};
+		std::vector<cairo_glyph_t> glyphs;
+		CCoord width {0.};
+	};
+
+	/** copies utf8String */
 	LinuxString (UTF8StringPtr utf8String);
-	virtual void setUTF8String (UTF8StringPtr utf8String) override;
+	/** references utf8String without copying, see IPlatformString::createWithUTF8StringReference */
+	LinuxString (UTF8StringPtr utf8String, size_t length);
+
+	void setUTF8String (UTF8StringPtr utf8String) override;
+	void updateUTF8StringReference (UTF8StringPtr utf8String, size_t length) override;
+
+	UTF8StringPtr data () const { return ptr; }
+	size_t length () const { return len; }
+	bool isReference () const { return ptr != str.data (); }
+
+	/** cached shaping of the last font used to measure or draw the string, only valid if its
+	 *	fontID matches */
+	Shaping& getShaping () const { return shaping; }
 
-	const std::string& get () const { return str; }
 private:
 	std::string str;
+	UTF8StringPtr ptr;
+	size_t len;
+	mutable Shaping shaping;
 };
 
 //------------------------------------------------------------------------
@@ -709,14 +709,7 @@ SharedPointer<COffscreenContext> Frame::createOffscreenContext (CCoord width,
 																CCoord height,
 																double scaleFactor)
 {
-	CPoint size (width * scaleFactor, height * scaleFactor);
-	auto bitmap = new Cairo::Bitmap (&size);
-	bitmap->setScaleFactor (scaleFactor);
-	auto context = owned (new Cairo::Context (bitmap));
-	bitmap->forget ();
-	if (context->valid ())
-		return context;
-	return nullptr;
+	return COffscreenContext::create (CPoint (width, height), scaleFactor);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
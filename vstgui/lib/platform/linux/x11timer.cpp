@@ -4,6 +4,7 @@
 
 #include "x11timer.h"
 #include "x11platform.h"
+#include <algorithm>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -17,6 +18,232 @@ SharedPointer<IPlatformTimer> IPlatformTimer::create (IPlatformTimerCallback* ca
 //------------------------------------------------------------------------
 namespace X11 {
 
+//------------------------------------------------------------------------
+constexpr uint64_t TimerWheel::kNoTimer;
+constexpr size_t TimerWheel::kNumSlots;
+
+//------------------------------------------------------------------------
+TimerWheel::TimerWheel (uint32_t slackMs) : slack (std::max<uint32_t> (slackMs, 1))
+{
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::setSlack (uint32_t ms)
+{
+	ms = std::max<uint32_t> (ms, 1);
+	if (ms == slack)
+		return;
+	currentTick = currentTick * slack / ms;
+	slack = ms;
+	for (auto& slot : slots)
+		slot.clear ();
+	for (auto& it : entries)
+		insert (it.first, it.second);
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::insert (ITimerHandler* handler, Entry& entry)
+{
+	entry.dueTick = std::max (toTick (entry.dueTime), currentTick + 1);
+	slots[entry.dueTick % kNumSlots].emplace_back (handler);
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::unlink (ITimerHandler* handler, const Entry& entry)
+{
+	auto& slot = slots[entry.dueTick % kNumSlots];
+	auto it = std::find (slot.begin (), slot.end (), handler);
+	if (it != slot.end ())
+		slot.erase (it);
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::add (ITimerHandler* handler, uint32_t periodMs, uint64_t nowMs)
+{
+	if (entries.empty ())
+		currentTick = toTick (nowMs);
+	auto it = entries.find (handler);
+	if (it != entries.end ())
+	{
+		unlink (handler, it->second);
+		entries.erase (it);
+	}
+	periodMs = std::max<uint32_t> (periodMs, 1);
+	auto& entry = entries[handler];
+	entry.period = periodMs;
+	entry.dueTime = nowMs + periodMs;
+	insert (handler, entry);
+}
+
+//------------------------------------------------------------------------
+bool TimerWheel::remove (ITimerHandler* handler)
+{
+	auto it = entries.find (handler);
+	if (it == entries.end ())
+		return false;
+	unlink (handler, it->second);
+	entries.erase (it);
+	return true;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::advance (uint64_t nowMs)
+{
+	auto nowTick = toTick (nowMs);
+	if (nowTick <= currentTick)
+		return;
+	// a full turn of the wheel visits every slot
+	auto numTicks = std::min<uint64_t> (nowTick - currentTick, kNumSlots);
+	dueHandlers.clear ();
+	for (uint64_t tick = nowTick - numTicks + 1; tick <= nowTick; ++tick)
+	{
+		auto& slot = slots[tick % kNumSlots];
+		for (auto it = slot.begin (); it != slot.end ();)
+		{
+			if (entries.find (*it)->second.dueTick <= nowTick)
+			{
+				dueHandlers.emplace_back (*it);
+				it = slot.erase (it);
+			}
+			else
+				++it;
+		}
+	}
+	currentTick = nowTick;
+
+	// reschedule all due timers before firing, so that the handlers can stop and restart them
+	auto handlers = std::move (dueHandlers);
+	for (auto handler : handlers)
+	{
+		auto& entry = entries.find (handler)->second;
+		auto lateness = nowMs > entry.dueTime ? nowMs - entry.dueTime : 0;
+		entry.statistics.fireCount++;
+		entry.statistics.totalLatenessMs += lateness;
+		entry.statistics.maxLatenessMs = std::max (entry.statistics.maxLatenessMs, lateness);
+		entry.dueTime += entry.period;
+		if (entry.dueTime <= nowMs)
+			entry.dueTime = nowMs + entry.period; // drop missed periods
+		insert (handler, entry);
+	}
+	for (auto handler : handlers)
+	{
+		// an earlier handler may have stopped this timer
+		if (entries.find (handler) != entries.end ())
+			handler->onTimer ();
+	}
+	handlers.clear ();
+	dueHandlers = std::move (handlers);
+}
+
+//------------------------------------------------------------------------
+uint64_t TimerWheel::getNextDueTime () const
+{
+	auto result = kNoTimer;
+	for (const auto& it : entries)
+		result = std::min (result, it.second.dueTick * slack - slack / 2);
+	return result;
+}
+
+//------------------------------------------------------------------------
+bool TimerWheel::getStatistics (ITimerHandler* handler, Statistics& statistics) const
+{
+	auto it = entries.find (handler);
+	if (it == entries.end ())
+		return false;
+	statistics = it->second.statistics;
+	return true;
+}
+
+//------------------------------------------------------------------------
+RunLoopTimerWheel::RunLoopTimerWheel (const GetRunLoopFunc& getRunLoop) : getRunLoop (getRunLoop)
+{
+}
+
+//------------------------------------------------------------------------
+RunLoopTimerWheel& RunLoopTimerWheel::instance ()
+{
+	static RunLoopTimerWheel gInstance ([] () { return RunLoop::get (); });
+	return gInstance;
+}
+
+//------------------------------------------------------------------------
+bool RunLoopTimerWheel::add (ITimerHandler* handler, uint32_t periodMs)
+{
+	wheel.add (handler, periodMs, Platform::getCurrentTimeMs ());
+	return updateRunLoopTimer ();
+}
+
+//------------------------------------------------------------------------
+bool RunLoopTimerWheel::remove (ITimerHandler* handler)
+{
+	if (!wheel.remove (handler))
+		return false;
+	return updateRunLoopTimer ();
+}
+
+//------------------------------------------------------------------------
+void RunLoopTimerWheel::setSlack (uint32_t ms)
+{
+	wheel.setSlack (ms);
+	updateRunLoopTimer ();
+}
+
+//------------------------------------------------------------------------
+void RunLoopTimerWheel::onTimer ()
+{
+	inAdvance = true;
+	wheel.advance (Platform::getCurrentTimeMs ());
+	inAdvance = false;
+	updateRunLoopTimer ();
+}
+
+//------------------------------------------------------------------------
+bool RunLoopTimerWheel::updateRunLoopTimer ()
+{
+	// timers started or stopped by the fired handlers are handled after the wheel advanced
+	if (inAdvance)
+		return true;
+	auto runLoop = getRunLoop ();
+	if (registeredRunLoop && registeredRunLoop != runLoop)
+	{
+		// the run loop of the registration was exited or replaced
+		registeredRunLoop->unregisterTimer (this);
+		registeredRunLoop = nullptr;
+		registeredInterval = 0;
+	}
+	if (!runLoop)
+	{
+		vstgui_assert (wheel.empty (), "Timer only works of run loop was set");
+		return wheel.empty ();
+	}
+	uint64_t interval = 0;
+	if (!wheel.empty ())
+	{
+		auto now = Platform::getCurrentTimeMs ();
+		auto nextDueTime = wheel.getNextDueTime ();
+		auto slack = wheel.getSlack ();
+		interval = nextDueTime > now ? nextDueTime - now : 0;
+		// keep the registered interval while it wakes up within the slack of the next due
+		// time, otherwise the jitter of the run loop would cause a new registration per fire
+		if (registeredInterval && registeredInterval + slack >= interval &&
+			registeredInterval <= interval + slack)
+			return true;
+		interval = std::max<uint64_t> ((interval + slack - 1) / slack, 1) * slack;
+	}
+	if (interval == registeredInterval)
+		return true;
+	if (registeredInterval)
+		runLoop->unregisterTimer (this);
+	registeredRunLoop = nullptr;
+	registeredInterval = 0;
+	if (interval && runLoop->registerTimer (interval, this))
+	{
+		registeredRunLoop = runLoop;
+		registeredInterval = interval;
+	}
+	return interval == registeredInterval;
+}
+
 //------------------------------------------------------------------------
 Timer::Timer (IPlatformTimerCallback* _callback)
 {
@@ -32,21 +259,13 @@ Timer::~Timer () noexcept
 //------------------------------------------------------------------------
 bool Timer::start (uint32_t periodMs)
 {
-	auto runLoop = RunLoop::get ();
-	vstgui_assert (runLoop, "Timer only works of run loop was set");
-	if (!runLoop)
-		return false;
-	return runLoop->registerTimer (periodMs, this);
+	return RunLoopTimerWheel::instance ().add (this, periodMs);
 }
 
 //------------------------------------------------------------------------
 bool Timer::stop ()
 {
-	auto runLoop = RunLoop::get ();
-	vstgui_assert (runLoop, "Timer only works of run loop was set");
-	if (!runLoop)
-		return false;
-	return runLoop->unregisterTimer (this);
+	return RunLoopTimerWheel::instance ().remove (this);
 }
 
 //------------------------------------------------------------------------
@@ -56,6 +275,25 @@ void Timer::onTimer ()
 		callback->fire ();
 }
 
+//------------------------------------------------------------------------
+bool Timer::getStatistics (TimerWheel::Statistics& statistics) const
+{
+	return RunLoopTimerWheel::instance ().getWheel ().getStatistics (const_cast<Timer*> (this),
+																	 statistics);
+}
+
+//------------------------------------------------------------------------
+void Timer::setSlack (uint32_t ms)
+{
+	RunLoopTimerWheel::instance ().setSlack (ms);
+}
+
+//------------------------------------------------------------------------
+uint32_t Timer::getSlack ()
+{
+	return RunLoopTimerWheel::instance ().getWheel ().getSlack ();
+}
+
 //------------------------------------------------------------------------
 } // X11
 } // VSTGUI
@@ -6,12 +6,119 @@
 
 #include "../iplatformtimer.h"
 #include "x11frame.h"
+#include <array>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
 namespace X11 {
 
 //------------------------------------------------------------------------
+/** Hashed timer wheel
+ *
+ *	The time is divided into ticks of slack milliseconds and every timer is hashed into the slot of
+ *	the tick it is due in. Timers due in the same tick fire together, so a larger slack coalesces
+ *	more timers into one wake up. A timer fires at most half a tick early.
+ *
+ *	Timers may be added and removed from within ITimerHandler::onTimer.
+ */
+class TimerWheel
+{
+public:
+	struct Statistics
+	{
+		uint64_t fireCount {0};
+		/** delay between the due time and the actual fire time */
+		uint64_t totalLatenessMs {0};
+		uint64_t maxLatenessMs {0};
+	};
+
+	static constexpr uint64_t kNoTimer = std::numeric_limits<uint64_t>::max ();
+
+	explicit TimerWheel (uint32_t slackMs = 4);
+
+	void setSlack (uint32_t ms);
+	uint32_t getSlack () const { return slack; }
+
+	/** adds or restarts the timer, it fires first at nowMs + periodMs */
+	void add (ITimerHandler* handler, uint32_t periodMs, uint64_t nowMs);
+	bool remove (ITimerHandler* handler);
+	bool empty () const { return entries.empty (); }
+
+	/** fires all timers due at nowMs */
+	void advance (uint64_t nowMs);
+	/** earliest time at which advance fires a timer or kNoTimer */
+	uint64_t getNextDueTime () const;
+
+	bool getStatistics (ITimerHandler* handler, Statistics& statistics) const;
+
+private:
+	static constexpr size_t kNumSlots = 256;
+
+	struct Entry
+	{
+		uint64_t dueTime;
+		uint64_t dueTick;
+		uint32_t period;
+		Statistics statistics;
+	};
+
+	uint64_t toTick (uint64_t timeMs) const { return (timeMs + slack / 2) / slack; }
+	void insert (ITimerHandler* handler, Entry& entry);
+	void unlink (ITimerHandler* handler, const Entry& entry);
+
+	using Slot = std::vector<ITimerHandler*>;
+
+	uint32_t slack;
+	uint64_t currentTick {0};
+	std::unordered_map<ITimerHandler*, Entry> entries;
+	std::array<Slot, kNumSlots> slots;
+	std::vector<ITimerHandler*> dueHandlers;
+};
+
+//------------------------------------------------------------------------
+/** Drives a timer wheel with one timer registered at the current run loop
+ *
+ *	The registration is bound to the run loop it was made with. When that run loop was exited or
+ *	replaced, the timer is registered again at the current run loop.
+ */
+class RunLoopTimerWheel : public ITimerHandler
+{
+public:
+	using GetRunLoopFunc = std::function<SharedPointer<IRunLoop> ()>;
+
+	explicit RunLoopTimerWheel (const GetRunLoopFunc& getRunLoop);
+
+	/** the timer wheel shared by all platform timers */
+	static RunLoopTimerWheel& instance ();
+
+	bool add (ITimerHandler* handler, uint32_t periodMs);
+	bool remove (ITimerHandler* handler);
+	void setSlack (uint32_t ms);
+
+	const TimerWheel& getWheel () const { return wheel; }
+
+	void onTimer () override;
+
+private:
+	bool updateRunLoopTimer ();
+
+	GetRunLoopFunc getRunLoop;
+	TimerWheel wheel;
+	SharedPointer<IRunLoop> registeredRunLoop;
+	uint64_t registeredInterval {0};
+	bool inAdvance {false};
+};
+
+//------------------------------------------------------------------------
+/** Platform timer
+ *
+ *	All timers share one timer wheel, which is driven by a single timer registered at the run loop.
+ *	That timer is only registered while at least one timer is running.
+ */
 class Timer : public IPlatformTimer, public ITimerHandler
 {
 public:
@@ -23,6 +130,13 @@ public:
 
 	void onTimer () override;
 
+	/** fire statistics since the last start, returns false if the timer is not running */
+	bool getStatistics (TimerWheel::Statistics& statistics) const;
+
+	/** set the slack of the shared timer wheel in milliseconds */
+	static void setSlack (uint32_t ms);
+	static uint32_t getSlack ();
+
 private:
 	IPlatformTimerCallback* callback = nullptr;
 };
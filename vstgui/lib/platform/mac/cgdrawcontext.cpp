@@ -857,6 +857,17 @@ CGPoint CGDrawContext::pixelAlligned (const CGPoint& p) const
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+SharedPointer<COffscreenContext> COffscreenContext::create (const CPoint& size, double scaleFactor)
+{
+	auto bitmap = makeOwned<CGBitmap> (CPoint (size.x * scaleFactor, size.y * scaleFactor));
+	bitmap->setScaleFactor (scaleFactor);
+	auto context = makeOwned<CGDrawContext> (bitmap);
+	if (context->getCGContext ())
+		return std::move (context);
+	return nullptr;
+}
+
 } // namespace
 
 #endif // MAC
@@ -1156,12 +1156,7 @@ SharedPointer<IPlatformViewLayer> NSViewFrame::createPlatformViewLayer (IPlatfor
 //-----------------------------------------------------------------------------
 SharedPointer<COffscreenContext> NSViewFrame::createOffscreenContext (CCoord width, CCoord height, double scaleFactor)
 {
-	auto bitmap = makeOwned<CGBitmap> (CPoint (width * scaleFactor, height * scaleFactor));
-	bitmap->setScaleFactor (scaleFactor);
-	auto context = makeOwned<CGDrawContext> (bitmap);
-	if (context->getCGContext ())
-		return std::move (context);
-	return nullptr;
+	return COffscreenContext::create (CPoint (width, height), scaleFactor);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
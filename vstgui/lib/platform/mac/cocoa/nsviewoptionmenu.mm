@@ -65,12 +65,13 @@ static id VSTGUI_NSMenu_Init (id self, SEL _cmd, void* _menu)
 
 		int32_t index = -1;
 		bool multipleCheck = menu->isMultipleCheckStyle ();
-		CConstMenuItemIterator it = menu->getItems ()->begin ();
-		while (it != menu->getItems ()->end ())
+		int32_t numEntries = menu->getNbEntries ();
+		while (index + 1 < numEntries)
 		{
-			CMenuItem* item = (*it);
-			it++;
 			index++;
+			CMenuItem* item = menu->getEntry (index);
+			if (!item)
+				continue;
 			NSMenuItem* nsItem = nullptr;
 			NSMutableString* itemTitle = [[[NSMutableString alloc] initWithString:fromUTF8String<NSString*> (item->getTitle ())] autorelease];
 			if (menu->getPrefixNumbers ())
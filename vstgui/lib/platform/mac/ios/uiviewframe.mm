@@ -285,14 +285,7 @@ SharedPointer<IPlatformOptionMenu> UIViewFrame::createPlatformOptionMenu ()
 //-----------------------------------------------------------------------------
 SharedPointer<COffscreenContext> UIViewFrame::createOffscreenContext (CCoord width, CCoord height, double scaleFactor)
 {
-	CGBitmap* bitmap = new CGBitmap (CPoint (width * scaleFactor, height * scaleFactor));
-	bitmap->setScaleFactor (scaleFactor);
-	CGDrawContext* context = new CGDrawContext (bitmap);
-	bitmap->forget ();
-	if (context->getCGContext ())
-		return owned<COffscreenContext> (context);
-	context->forget ();
-	return 0;
+	return COffscreenContext::create (CPoint (width, height), scaleFactor);
 }
 
 #if VSTGUI_OPENGL_SUPPORT
@@ -14,6 +14,13 @@ SharedPointer<IPlatformString> IPlatformString::createWithUTF8String (UTF8String
 	return makeOwned<MacString> (utf8String);
 }
 
+//-----------------------------------------------------------------------------
+SharedPointer<IPlatformString> IPlatformString::createWithUTF8StringReference (
+	UTF8StringPtr utf8String, size_t length)
+{
+	return createWithUTF8String (utf8String);
+}
+
 //-----------------------------------------------------------------------------
 MacString::MacString (UTF8StringPtr utf8String)
 : cfString (nullptr)
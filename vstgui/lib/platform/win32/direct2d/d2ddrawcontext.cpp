@@ -840,6 +840,15 @@ void D2DDrawContext::restoreGlobalState ()
 	}
 }
 
+//-----------------------------------------------------------------------------
+// D2DBitmap uses the WIC imaging factory, worker threads must have initialized COM
+SharedPointer<COffscreenContext> COffscreenContext::create (const CPoint& size, double scaleFactor)
+{
+	auto bitmap = makeOwned<D2DBitmap> (CPoint (size.x * scaleFactor, size.y * scaleFactor));
+	bitmap->setScaleFactor (scaleFactor);
+	return makeOwned<D2DDrawContext> (bitmap);
+}
+
 } // namespace
 
 #endif // WINDOWS
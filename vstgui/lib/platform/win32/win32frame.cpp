@@ -472,11 +472,7 @@ SharedPointer<IPlatformOpenGLView> Win32Frame::createPlatformOpenGLView ()
 //-----------------------------------------------------------------------------
 SharedPointer<COffscreenContext> Win32Frame::createOffscreenContext (CCoord width, CCoord height, double scaleFactor)
 {
-	D2DBitmap* bitmap = new D2DBitmap (CPoint (width * scaleFactor, height * scaleFactor));
-	bitmap->setScaleFactor (scaleFactor);
-	auto context = owned<COffscreenContext> (new D2DDrawContext (bitmap));
-	bitmap->forget ();
-	return context;
+	return COffscreenContext::create (CPoint (width, height), scaleFactor);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -33,16 +33,15 @@ COptionMenu* getItemMenu (int32_t idx, int32_t &idxInMenu, int32_t &offsetIdx, C
 	
 
 	COptionMenu *menu = 0;
-	CMenuItemIterator it = _menu->getItems ()->begin ();
-	while (it != _menu->getItems ()->end ())
+	for (int32_t i = 0; i < _menu->getNbEntries (); ++i)
 	{
-		if ((*it)->getSubmenu ())
+		CMenuItem* item = _menu->getEntry (i);
+		if (item && item->getSubmenu ())
 		{
-			menu = getItemMenu (idx, idxInMenu, offsetIdx, (*it)->getSubmenu ());
+			menu = getItemMenu (idx, idxInMenu, offsetIdx, item->getSubmenu ());
 			if (menu)
 				break;
 		}
-		it++;
 	}
 	return menu;
 }
@@ -129,11 +128,11 @@ HMENU Win32OptionMenu::createMenu (COptionMenu* _menu, int32_t& offsetIdx)
 	int32_t offset = offsetIdx;
 	int32_t nbEntries = _menu->getNbEntries ();
 	offsetIdx += nbEntries;
-	int32_t inc = 0;
-	CMenuItemIterator it = _menu->getItems ()->begin ();
-	while (it != _menu->getItems ()->end ())
+	for (int32_t inc = 0; inc < nbEntries; ++inc)
 	{
-		CMenuItem* item = (*it);
+		CMenuItem* item = _menu->getEntry (inc);
+		if (!item)
+			continue;
 		if (item->isSeparator ())
 		{
 			AppendMenu (menu, MF_SEPARATOR, 0, 0);
@@ -222,8 +221,6 @@ HMENU Win32OptionMenu::createMenu (COptionMenu* _menu, int32_t& offsetIdx)
 			if (titleWithPrefixNumbers)
 				std::free (titleWithPrefixNumbers);
 		}
-		inc++;
-		it++;
 	}
 	return menu;
 }
@@ -18,6 +18,13 @@ SharedPointer<IPlatformString> IPlatformString::createWithUTF8String (UTF8String
 	return owned<IPlatformString> (new WinString (utf8String));
 }
 
+//-----------------------------------------------------------------------------
+SharedPointer<IPlatformString> IPlatformString::createWithUTF8StringReference (
+	UTF8StringPtr utf8String, size_t length)
+{
+	return createWithUTF8String (utf8String);
+}
+
 //-----------------------------------------------------------------------------
 WinString::WinString (UTF8StringPtr utf8String)
 : wideString (0)
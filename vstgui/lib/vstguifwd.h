@@ -154,6 +154,7 @@ class IDraggingSession;
 class IDropTarget;
 class ICommandMenuItemTarget;
 class IOptionMenuListener;
+class IOptionMenuItemProvider;
 class ITextLabelListener;
 
 #if VSTGUI_TOUCH_EVENT_HANDLING
@@ -162,6 +163,7 @@ class ITouchEvent;
 
 // classes
 class CBitmap;
+class CAsyncBitmapBuffer;
 class CNinePartTiledBitmap;
 class CResourceDescription;
 class CLineStyle;
@@ -184,6 +186,7 @@ class GenericStringListDataBrowserSource;
 
 // views
 class CFrame;
+class CAsyncBitmapView;
 class CDataBrowser;
 class CGradientView;
 class CLayeredViewContainer;
@@ -0,0 +1,228 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+namespace {
+
+//------------------------------------------------------------------------
+struct Entry
+{
+	std::string group;
+	std::string name;
+	Function function;
+};
+
+//------------------------------------------------------------------------
+std::vector<Entry>& registry ()
+{
+	static std::vector<Entry> gRegistry;
+	return gRegistry;
+}
+
+//------------------------------------------------------------------------
+struct Options
+{
+	std::string filter;
+	std::string outputPath;
+	uint32_t repetitions {10};
+	double minBatchTimeMs {20.};
+	bool list {false};
+};
+
+//------------------------------------------------------------------------
+struct Result
+{
+	std::string name;
+	uint64_t iterations;
+	std::vector<double> nsPerIteration;
+
+	double min () const
+	{
+		return *std::min_element (nsPerIteration.begin (), nsPerIteration.end ());
+	}
+	double max () const
+	{
+		return *std::max_element (nsPerIteration.begin (), nsPerIteration.end ());
+	}
+	double median () const
+	{
+		auto values = nsPerIteration;
+		std::sort (values.begin (), values.end ());
+		auto mid = values.size () / 2;
+		if (values.size () % 2)
+			return values[mid];
+		return (values[mid - 1] + values[mid]) / 2.;
+	}
+	double mean () const
+	{
+		double sum = 0.;
+		for (auto v : nsPerIteration)
+			sum += v;
+		return sum / nsPerIteration.size ();
+	}
+	double stddev () const
+	{
+		auto m = mean ();
+		double sum = 0.;
+		for (auto v : nsPerIteration)
+			sum += (v - m) * (v - m);
+		return std::sqrt (sum / nsPerIteration.size ());
+	}
+};
+
+//------------------------------------------------------------------------
+double runBatch (const Function& function, uint64_t iterations)
+{
+	State state (iterations);
+	function (state);
+	return static_cast<double> (
+		std::chrono::duration_cast<std::chrono::nanoseconds> (state.getElapsed ()).count ());
+}
+
+//------------------------------------------------------------------------
+Result run (const Entry& entry, const Options& options)
+{
+	Result result;
+	result.name = entry.group + "." + entry.name;
+
+	// warm up and find an iteration count which takes at least minBatchTimeMs per batch
+	const double minBatchTimeNs = options.minBatchTimeMs * 1000000.;
+	uint64_t iterations = 1;
+	while (true)
+	{
+		auto elapsed = runBatch (entry.function, iterations);
+		if (elapsed >= minBatchTimeNs || iterations >= (1ull << 40))
+			break;
+		auto factor = elapsed > 0. ? std::min (10., 1.2 * minBatchTimeNs / elapsed) : 10.;
+		iterations = std::max (iterations + 1, static_cast<uint64_t> (iterations * factor));
+	}
+	result.iterations = iterations;
+
+	for (auto i = 0u; i < options.repetitions; ++i)
+	{
+		auto elapsed = runBatch (entry.function, iterations);
+		result.nsPerIteration.push_back (elapsed / iterations);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+std::string toJSON (const std::vector<Result>& results, const Options& options)
+{
+	std::string json = "{\n";
+	json += "\t\"version\": 1,\n";
+	json += "\t\"repetitions\": " + std::to_string (options.repetitions) + ",\n";
+	json += "\t\"benchmarks\": [";
+	char buffer[512];
+	for (auto it = results.begin (); it != results.end (); ++it)
+	{
+		snprintf (buffer, sizeof (buffer),
+				  "%s\n\t\t{\"name\": \"%s\", \"iterations\": %llu, \"median_ns\": %.3f, "
+				  "\"mean_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f, \"stddev_ns\": %.3f}",
+				  it == results.begin () ? "" : ",", it->name.data (),
+				  static_cast<unsigned long long> (it->iterations), it->median (), it->mean (),
+				  it->min (), it->max (), it->stddev ());
+		json += buffer;
+	}
+	json += "\n\t]\n}\n";
+	return json;
+}
+
+//------------------------------------------------------------------------
+bool parseOptions (int argc, char* argv[], Options& options)
+{
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto arg = argv[i];
+		auto hasValue = i + 1 < argc;
+		if (strcmp (arg, "--filter") == 0 && hasValue)
+			options.filter = argv[++i];
+		else if (strcmp (arg, "--output") == 0 && hasValue)
+			options.outputPath = argv[++i];
+		else if (strcmp (arg, "--repetitions") == 0 && hasValue)
+			options.repetitions = std::max (1, atoi (argv[++i]));
+		else if (strcmp (arg, "--min-time") == 0 && hasValue)
+			options.minBatchTimeMs = std::max (1., atof (argv[++i]));
+		else if (strcmp (arg, "--list") == 0)
+			options.list = true;
+		else
+		{
+			fprintf (stderr,
+					 "usage: %s [--filter substring] [--output file.json] [--repetitions n] "
+					 "[--min-time ms] [--list]\n",
+					 argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+Registrar::Registrar (const char* group, const char* name, Function&& function)
+{
+	registry ().push_back ({group, name, std::move (function)});
+}
+
+//------------------------------------------------------------------------
+int runBenchmarks (int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions (argc, argv, options))
+		return -1;
+
+	auto entries = registry ();
+	std::sort (entries.begin (), entries.end (), [] (const Entry& e1, const Entry& e2) {
+		return e1.group == e2.group ? e1.name < e2.name : e1.group < e2.group;
+	});
+
+	std::vector<Result> results;
+	for (auto& entry : entries)
+	{
+		auto name = entry.group + "." + entry.name;
+		if (!options.filter.empty () && name.find (options.filter) == std::string::npos)
+			continue;
+		if (options.list)
+		{
+			printf ("%s\n", name.data ());
+			continue;
+		}
+		fprintf (stderr, "%s ", name.data ());
+		fflush (stderr);
+		results.push_back (run (entry, options));
+		fprintf (stderr, "%.3f ns\n", results.back ().median ());
+	}
+	if (options.list)
+		return 0;
+
+	auto json = toJSON (results, options);
+	if (options.outputPath.empty ())
+	{
+		printf ("%s", json.data ());
+		return 0;
+	}
+	if (auto file = fopen (options.outputPath.data (), "w"))
+	{
+		fwrite (json.data (), 1, json.size (), file);
+		fclose (file);
+		return 0;
+	}
+	fprintf (stderr, "Could not write %s\n", options.outputPath.data ());
+	return -1;
+}
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
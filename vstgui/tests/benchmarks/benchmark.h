@@ -0,0 +1,115 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+	How-to write benchmarks:
+
+	1) include this file
+	2) declare a benchmark : BENCHMARK (Group, Name)
+	3) do the setup, then put the code to measure into a "while (state.keepRunning ())" loop
+	4) pass results which are otherwise unused to doNotOptimize
+
+	Example:
+
+		BENCHMARK (CRect, bound)
+		{
+			CRect r (0, 0, 100, 100);
+			while (state.keepRunning ())
+			{
+				CRect r2 (50, 50, 150, 150);
+				doNotOptimize (r2.bound (r));
+			}
+		}
+
+	The benchmark function is called several times with a calibrated iteration count. Only the time
+	spent inside the keepRunning loop is measured.
+*/
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+
+//------------------------------------------------------------------------
+class State
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit State (uint64_t iterations) : remaining (iterations), iterations (iterations) {}
+
+	bool keepRunning ()
+	{
+		if (!started)
+		{
+			started = true;
+			start = Clock::now ();
+		}
+		if (remaining == 0)
+		{
+			stop = Clock::now ();
+			return false;
+		}
+		--remaining;
+		return true;
+	}
+
+	/** exclude the following code from the measurement until resumeTiming is called */
+	void pauseTiming () { pauseStart = Clock::now (); }
+	void resumeTiming () { paused += Clock::now () - pauseStart; }
+
+	uint64_t getIterations () const { return iterations; }
+	Clock::duration getElapsed () const { return (stop - start) - paused; }
+
+private:
+	uint64_t remaining;
+	uint64_t iterations;
+	bool started {false};
+	Clock::time_point start;
+	Clock::time_point stop;
+	Clock::time_point pauseStart;
+	Clock::duration paused {0};
+};
+
+using Function = std::function<void (State& state)>;
+
+//------------------------------------------------------------------------
+struct Registrar
+{
+	Registrar (const char* group, const char* name, Function&& function);
+};
+
+//------------------------------------------------------------------------
+/** run all registered benchmarks and write the results as JSON */
+int runBenchmarks (int argc, char* argv[]);
+
+//------------------------------------------------------------------------
+/** prevent the compiler from optimizing away the computation of value */
+template <typename T>
+inline void doNotOptimize (const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile ("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+#define BENCHMARK(group, name)                                                                     \
+	static void group##_##name##_Benchmark (VSTGUI::Benchmark::State& state);                      \
+	static VSTGUI::Benchmark::Registrar group##_##name##_Registrar (#group, #name,                 \
+																	 group##_##name##_Benchmark);  \
+	static void group##_##name##_Benchmark (VSTGUI::Benchmark::State& state)
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
@@ -0,0 +1,255 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "platform_helper.h"
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cbitmapfilter.h"
+#include "vstgui/lib/cgradient.h"
+#include "vstgui/lib/cgraphicspath.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+namespace {
+
+//------------------------------------------------------------------------
+void buildKnobPath (CGraphicsPath* path, CCoord offset)
+{
+	CRect r (offset, offset, offset + 40., offset + 40.);
+	path->addEllipse (r);
+	r.inset (5., 5.);
+	path->addArc (r, 135., 45., true);
+	path->addRoundRect (CRect (offset, offset + 50., offset + 80., offset + 70.), 4.);
+	path->beginSubpath (offset, offset + 80.);
+	path->addBezierCurve (offset + 10., offset + 70., offset + 30., offset + 90., offset + 40.,
+						  offset + 80.);
+	path->addLine (offset + 60., offset + 100.);
+	path->closeSubpath ();
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createTestBitmap (CCoord width, CCoord height)
+{
+	auto bitmap = makeOwned<CBitmap> (width, height);
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		uint32_t i = 0;
+		do
+		{
+			auto v = static_cast<uint8_t> (i++ * 31);
+			accessor->setColor (CColor (v, static_cast<uint8_t> (v + 64), 128, v | 1));
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+void runFilter (State& state, IdStringPtr filterName, CCoord size, bool replace,
+				const std::function<void (BitmapFilter::IFilter*)>& setup)
+{
+	auto bitmap = createTestBitmap (size, size);
+	auto filter = owned (BitmapFilter::Factory::getInstance ().createFilter (filterName));
+	if (!filter)
+		return;
+	filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap.get ());
+	setup (filter);
+	while (state.keepRunning ())
+		doNotOptimize (filter->run (replace));
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsPath, construct)
+{
+	auto context = createOffscreenContext (200., 200.);
+	CCoord offset = 0.;
+	while (state.keepRunning ())
+	{
+		auto path = owned (context->createGraphicsPath ());
+		buildKnobPath (path, offset);
+		doNotOptimize (path->getBoundingBox ());
+		offset = offset > 50. ? 0. : offset + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsPath, fill)
+{
+	auto context = createOffscreenContext (200., 200.);
+	auto path = owned (context->createGraphicsPath ());
+	buildKnobPath (path, 10.);
+	context->beginDraw ();
+	context->setFillColor (kRedCColor);
+	while (state.keepRunning ())
+		context->drawGraphicsPath (path, CDrawContext::kPathFilled);
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsPath, strokePixelAligned)
+{
+	auto context = createOffscreenContext (200., 200.);
+	auto path = owned (context->createGraphicsPath ());
+	buildKnobPath (path, 10.);
+	context->beginDraw ();
+	context->setFrameColor (kBlueCColor);
+	context->setLineWidth (2.);
+	context->setDrawMode (kAntiAliasing);
+	while (state.keepRunning ())
+		context->drawGraphicsPath (path, CDrawContext::kPathStroked);
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsPath, strokeTransformed)
+{
+	auto context = createOffscreenContext (200., 200.);
+	auto path = owned (context->createGraphicsPath ());
+	buildKnobPath (path, 10.);
+	context->beginDraw ();
+	context->setFrameColor (kBlueCColor);
+	context->setLineWidth (2.);
+	context->setDrawMode (kAntiAliasing | kNonIntegralMode);
+	CGraphicsTransform tm;
+	while (state.keepRunning ())
+	{
+		tm.rotate (1., CPoint (50., 50.));
+		context->drawGraphicsPath (path, CDrawContext::kPathStroked, &tm);
+	}
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CDrawContext, drawRect)
+{
+	auto context = createOffscreenContext (200., 200.);
+	context->beginDraw ();
+	context->setFillColor (kGreenCColor);
+	context->setFrameColor (kBlackCColor);
+	CCoord offset = 0.;
+	while (state.keepRunning ())
+	{
+		context->drawRect (CRect (offset, offset, offset + 20., offset + 20.), kDrawFilledAndStroked);
+		offset = offset > 150. ? 0. : offset + 1.;
+	}
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (COffscreenContext, create)
+{
+	while (state.keepRunning ())
+	{
+		auto context = createOffscreenContext (512., 512.);
+		doNotOptimize (context.get ());
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CDrawContext, drawLines)
+{
+	auto context = createOffscreenContext (512., 200.);
+	CDrawContext::LineList lines;
+	for (auto i = 0; i < 512; ++i)
+	{
+		auto y = 100. + 90. * std::sin (i * 0.05);
+		lines.emplace_back (CPoint (i, y), CPoint (i + 1, 100. + 90. * std::sin ((i + 1) * 0.05)));
+	}
+	context->beginDraw ();
+	context->setFrameColor (kBlackCColor);
+	context->setDrawMode (kAntiAliasing | kNonIntegralMode);
+	while (state.keepRunning ())
+		context->drawLines (lines);
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGradient, fillLinearVaryingSize)
+{
+	// one gradient shared by rows of different sizes, like list or slider backgrounds
+	auto context = createOffscreenContext (200., 200.);
+	auto gradient = owned (CGradient::create (0., 1., kRedCColor, kBlueCColor));
+	gradient->addColorStop (0.5, kGreenCColor);
+	CCoord size = 10.;
+	context->beginDraw ();
+	while (state.keepRunning ())
+	{
+		auto path = owned (context->createGraphicsPath ());
+		path->addRect (CRect (0., 0., size, 20.));
+		context->fillLinearGradient (path, *gradient, CPoint (0., 0.), CPoint (size, 0.));
+		size = size > 190. ? 10. : size + 1.;
+	}
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGradient, fillRadial)
+{
+	auto context = createOffscreenContext (200., 200.);
+	auto gradient = owned (CGradient::create (0., 1., kWhiteCColor, kBlackCColor));
+	auto path = owned (context->createGraphicsPath ());
+	path->addEllipse (CRect (10., 10., 190., 190.));
+	context->beginDraw ();
+	while (state.keepRunning ())
+		context->fillRadialGradient (path, *gradient, CPoint (100., 100.), 90.);
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, boxBlur)
+{
+	runFilter (state, BitmapFilter::Standard::kBoxBlur, 256., true, [] (BitmapFilter::IFilter* f) {
+		f->setProperty (BitmapFilter::Standard::Property::kRadius, 4);
+	});
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, boxBlurToNewBitmap)
+{
+	runFilter (state, BitmapFilter::Standard::kBoxBlur, 256., false, [] (BitmapFilter::IFilter* f) {
+		f->setProperty (BitmapFilter::Standard::Property::kRadius, 4);
+	});
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, boxBlurAlphaOnly)
+{
+	runFilter (state, BitmapFilter::Standard::kBoxBlur, 256., true, [] (BitmapFilter::IFilter* f) {
+		f->setProperty (BitmapFilter::Standard::Property::kRadius, 4);
+		f->setProperty (BitmapFilter::Standard::Property::kAlphaChannelOnly, 1);
+	});
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, setColor)
+{
+	runFilter (state, BitmapFilter::Standard::kSetColor, 256., true, [] (BitmapFilter::IFilter* f) {
+		f->setProperty (BitmapFilter::Standard::Property::kInputColor, kRedCColor);
+		f->setProperty (BitmapFilter::Standard::Property::kIgnoreAlphaColorValue, 1);
+	});
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, grayscale)
+{
+	runFilter (state, BitmapFilter::Standard::kGrayscale, 256., true,
+			   [] (BitmapFilter::IFilter* f) {});
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, scaleBilinear)
+{
+	runFilter (state, BitmapFilter::Standard::kScaleBilinear, 256., false,
+			   [] (BitmapFilter::IFilter* f) {
+				   f->setProperty (BitmapFilter::Standard::Property::kOutputRect,
+								   CRect (0, 0, 173, 173));
+			   });
+}
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
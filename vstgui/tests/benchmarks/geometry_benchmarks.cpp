@@ -0,0 +1,135 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cgraphicstransform.h"
+#include "vstgui/lib/cpoint.h"
+#include "vstgui/lib/crect.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+
+//------------------------------------------------------------------------
+BENCHMARK (CRect, bound)
+{
+	const CRect clip (10, 10, 90, 90);
+	CCoord x = 0.;
+	while (state.keepRunning ())
+	{
+		CRect r (x, x, x + 50., x + 50.);
+		r.bound (clip);
+		doNotOptimize (r);
+		x = x > 100. ? 0. : x + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CRect, unite)
+{
+	CCoord x = 0.;
+	while (state.keepRunning ())
+	{
+		CRect r (10, 10, 90, 90);
+		r.unite (CRect (x, x, x + 50., x + 50.));
+		doNotOptimize (r);
+		x = x > 100. ? 0. : x + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CRect, rectOverlap)
+{
+	const CRect r (10, 10, 90, 90);
+	CCoord x = 0.;
+	while (state.keepRunning ())
+	{
+		doNotOptimize (r.rectOverlap (CRect (x, x, x + 5., x + 5.)));
+		x = x > 100. ? 0. : x + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CRect, pointInside)
+{
+	const CRect r (10, 10, 90, 90);
+	CPoint p;
+	while (state.keepRunning ())
+	{
+		doNotOptimize (r.pointInside (p));
+		p.x = p.x > 100. ? 0. : p.x + 1.;
+		p.y = p.x * 0.5;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CRect, makeIntegral)
+{
+	CCoord x = 0.;
+	while (state.keepRunning ())
+	{
+		CRect r (x + 0.3, x + 0.6, x + 50.2, x + 50.7);
+		doNotOptimize (r.makeIntegral ());
+		x = x > 100. ? 0. : x + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsTransform, transformPoint)
+{
+	CGraphicsTransform tm;
+	tm.translate (10., 20.).scale (2., 2.).rotate (30.);
+	CPoint p;
+	while (state.keepRunning ())
+	{
+		CPoint p2 (p);
+		doNotOptimize (tm.transform (p2));
+		p.x = p.x > 100. ? 0. : p.x + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsTransform, transformRect)
+{
+	CGraphicsTransform tm;
+	tm.translate (10., 20.).scale (2., 2.);
+	CCoord x = 0.;
+	while (state.keepRunning ())
+	{
+		CRect r (x, x, x + 50., x + 50.);
+		doNotOptimize (tm.transform (r));
+		x = x > 100. ? 0. : x + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsTransform, concat)
+{
+	CGraphicsTransform tm;
+	tm.scale (1.5, 1.5);
+	CCoord x = 0.;
+	while (state.keepRunning ())
+	{
+		auto result = tm * CGraphicsTransform ().translate (x, x);
+		doNotOptimize (result);
+		x = x > 100. ? 0. : x + 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CGraphicsTransform, inverse)
+{
+	CGraphicsTransform tm;
+	tm.translate (10., 20.).scale (2., 3.).rotate (15.);
+	while (state.keepRunning ())
+	{
+		auto result = tm.inverse ();
+		doNotOptimize (result);
+		tm.dx += 1.;
+	}
+}
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
@@ -0,0 +1,16 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+
+//------------------------------------------------------------------------
+#if __linux__
+namespace VSTGUI { void* soHandle = nullptr; }
+#endif
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	return VSTGUI::Benchmark::runBenchmarks (argc, argv);
+}
@@ -0,0 +1,20 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstgui/lib/coffscreencontext.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+
+//------------------------------------------------------------------------
+/** create an offscreen draw context without a frame */
+SharedPointer<COffscreenContext> createOffscreenContext (CCoord width, CCoord height,
+														 double scaleFactor = 1.);
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
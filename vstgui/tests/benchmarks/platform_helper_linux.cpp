@@ -0,0 +1,28 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "platform_helper.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+
+//------------------------------------------------------------------------
+SharedPointer<COffscreenContext> createOffscreenContext (CCoord width, CCoord height,
+														 double scaleFactor)
+{
+	CPoint size (width * scaleFactor, height * scaleFactor);
+	auto bitmap = owned (new Cairo::Bitmap (&size));
+	bitmap->setScaleFactor (scaleFactor);
+	auto context = owned (new Cairo::Context (bitmap));
+	if (context->valid ())
+		return context;
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
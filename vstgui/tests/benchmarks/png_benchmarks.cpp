@@ -0,0 +1,166 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/platform/linux/cairopngcodec.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+namespace {
+
+//------------------------------------------------------------------------
+/** premultiplied gradient with a varying alpha channel */
+Cairo::SurfaceHandle createTestSurface (int width, int height)
+{
+	Cairo::SurfaceHandle surface (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+	auto data = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	for (auto y = 0; y < height; ++y)
+	{
+		auto pixel = reinterpret_cast<uint32_t*> (data + y * stride);
+		for (auto x = 0; x < width; ++x)
+		{
+			uint32_t alpha = (x + y) & 0xFF;
+			uint32_t r = (x * 255 / width) * alpha / 255;
+			uint32_t g = (y * 255 / height) * alpha / 255;
+			uint32_t b = ((x ^ y) & 0xFF) * alpha / 255;
+			pixel[x] = (alpha << 24) | (r << 16) | (g << 8) | b;
+		}
+	}
+	cairo_surface_mark_dirty (surface);
+	return surface;
+}
+
+//------------------------------------------------------------------------
+struct CairoPNGReader
+{
+	const uint8_t* ptr;
+	size_t size;
+
+	static cairo_status_t read (void* closure, unsigned char* data, unsigned int length)
+	{
+		auto self = reinterpret_cast<CairoPNGReader*> (closure);
+		if (length > self->size)
+			return CAIRO_STATUS_READ_ERROR;
+		memcpy (data, self->ptr, length);
+		self->ptr += length;
+		self->size -= length;
+		return CAIRO_STATUS_SUCCESS;
+	}
+};
+
+//------------------------------------------------------------------------
+/** the decode path used before PNGCodec, including the copy of non ARGB32 images */
+Cairo::SurfaceHandle cairoDecode (const PNGBitmapBuffer& buffer)
+{
+	CairoPNGReader reader {buffer.data (), buffer.size ()};
+	Cairo::SurfaceHandle surface (
+		cairo_image_surface_create_from_png_stream (CairoPNGReader::read, &reader));
+	if (cairo_image_surface_get_format (surface) == CAIRO_FORMAT_ARGB32)
+		return surface;
+	Cairo::SurfaceHandle surface32 (
+		cairo_image_surface_create (CAIRO_FORMAT_ARGB32, cairo_image_surface_get_width (surface),
+									cairo_image_surface_get_height (surface)));
+	auto context = cairo_create (surface32);
+	cairo_set_source_surface (context, surface, 0, 0);
+	cairo_paint (context);
+	cairo_destroy (context);
+	cairo_surface_flush (surface32);
+	return surface32;
+}
+
+//------------------------------------------------------------------------
+cairo_status_t cairoWrite (void* closure, const unsigned char* data, unsigned int length)
+{
+	auto buffer = reinterpret_cast<PNGBitmapBuffer*> (closure);
+	buffer->reserve (buffer->size () + length);
+	std::copy_n (data, length, std::back_inserter (*buffer));
+	return CAIRO_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------
+/** the encode path used before PNGCodec */
+PNGBitmapBuffer cairoEncode (cairo_surface_t* surface)
+{
+	PNGBitmapBuffer buffer;
+	cairo_surface_write_to_png_stream (surface, cairoWrite, &buffer);
+	return buffer;
+}
+
+//------------------------------------------------------------------------
+void runDecode (State& state, int size, bool useCodec)
+{
+	auto png = Cairo::PNGCodec::encode (createTestSurface (size, size));
+	while (state.keepRunning ())
+	{
+		auto surface = useCodec ? Cairo::PNGCodec::decode (png.data (), png.size ()) :
+								  cairoDecode (png);
+		doNotOptimize (static_cast<cairo_surface_t*> (surface));
+	}
+}
+
+//------------------------------------------------------------------------
+void runEncode (State& state, int size, bool useCodec, int compressionLevel = 6)
+{
+	auto surface = createTestSurface (size, size);
+	while (state.keepRunning ())
+	{
+		auto png = useCodec ? Cairo::PNGCodec::encode (surface, compressionLevel) :
+							  cairoEncode (surface);
+		doNotOptimize (png.size ());
+	}
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (PNG, decodeCairo128)
+{
+	runDecode (state, 128, false);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (PNG, decodeCodec128)
+{
+	runDecode (state, 128, true);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (PNG, decodeCairo1024)
+{
+	runDecode (state, 1024, false);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (PNG, decodeCodec1024)
+{
+	runDecode (state, 1024, true);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (PNG, encodeCairo1024)
+{
+	runEncode (state, 1024, false);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (PNG, encodeCodec1024)
+{
+	runEncode (state, 1024, true);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (PNG, encodeCodec1024Fastest)
+{
+	runEncode (state, 1024, true, 1);
+}
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
@@ -0,0 +1,125 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cview.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/xmlparser.h"
+#include <string>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+namespace {
+
+//------------------------------------------------------------------------
+/** a skin with numGroups containers, each containing a row of typical controls */
+std::string createSyntheticSkin (uint32_t numGroups)
+{
+	std::string xml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<vstgui-ui-description version="1">
+	<colors>
+		<color name="background" rgba="#202020ff"/>
+		<color name="text" rgba="#e0e0e0ff"/>
+		<color name="accent" rgba="#ff8000ff"/>
+	</colors>
+	<fonts>
+		<font font-name="Arial" name="label" size="11"/>
+		<font font-name="Arial" name="value" size="9" bold="true"/>
+	</fonts>
+	<gradients>
+		<gradient name="button">
+			<color-stop rgba="#dcdcdcff" start="0"/>
+			<color-stop rgba="#b4b4b4ff" start="1"/>
+		</gradient>
+	</gradients>
+	<control-tags>
+)";
+	for (auto i = 0u; i < numGroups; ++i)
+	{
+		auto index = std::to_string (i);
+		xml += "\t\t<control-tag name=\"Param" + index + "\" tag=\"" + index + "\"/>\n";
+	}
+	xml += "\t</control-tags>\n";
+	xml += "\t<template background-color=\"background\" class=\"CViewContainer\" name=\"main\" "
+		   "origin=\"0, 0\" size=\"1000, " + std::to_string (numGroups * 40) + "\">\n";
+	for (auto i = 0u; i < numGroups; ++i)
+	{
+		auto y = std::to_string (i * 40);
+		auto tag = "Param" + std::to_string (i);
+		xml += "\t\t<view class=\"CViewContainer\" origin=\"0, " + y + "\" size=\"1000, 40\" "
+			   "background-color=\"background\" transparent=\"false\">\n";
+		xml += "\t\t\t<view class=\"CTextLabel\" origin=\"5, 5\" size=\"100, 20\" font=\"label\" "
+			   "font-color=\"text\" back-color=\"background\" text-alignment=\"left\" "
+			   "title=\"Parameter " + std::to_string (i) + "\" transparent=\"true\"/>\n";
+		xml += "\t\t\t<view class=\"CKnob\" origin=\"110, 5\" size=\"30, 30\" control-tag=\"" +
+			   tag + "\" angle-range=\"270\" angle-start=\"135\" corona-color=\"accent\" "
+			   "corona-drawing=\"true\" handle-color=\"text\" value-inset=\"3\" "
+			   "default-value=\"0.5\" min-value=\"0\" max-value=\"1\" wheel-inc-value=\"0.1\"/>\n";
+		xml += "\t\t\t<view class=\"CSlider\" origin=\"150, 10\" size=\"200, 20\" control-tag=\"" +
+			   tag + "\" orientation=\"horizontal\" draw-back=\"true\" draw-back-color=\"background\" "
+			   "draw-frame=\"true\" draw-frame-color=\"text\" draw-value=\"true\" "
+			   "draw-value-color=\"accent\" mode=\"free click\" handle-offset=\"0, 0\" "
+			   "bitmap-offset=\"0, 0\" zoom-factor=\"10\"/>\n";
+		xml += "\t\t\t<view class=\"CParamDisplay\" origin=\"360, 10\" size=\"60, 20\" "
+			   "control-tag=\"" + tag + "\" font=\"value\" font-color=\"text\" "
+			   "back-color=\"background\" frame-color=\"accent\" value-precision=\"2\" "
+			   "text-inset=\"2, 0\" round-rect-radius=\"3\" style-round-rect=\"true\"/>\n";
+		xml += "\t\t\t<view class=\"CTextButton\" origin=\"430, 10\" size=\"80, 20\" "
+			   "control-tag=\"" + tag + "\" title=\"Reset\" font=\"label\" gradient=\"button\" "
+			   "gradient-highlighted=\"button\" frame-color=\"text\" round-radius=\"4\" "
+			   "kick-style=\"true\"/>\n";
+		xml += "\t\t\t<view class=\"COptionMenu\" origin=\"520, 10\" size=\"120, 20\" "
+			   "control-tag=\"" + tag + "\" font=\"label\" font-color=\"text\" "
+			   "back-color=\"background\" frame-color=\"text\" menu-popup-style=\"true\"/>\n";
+		xml += "\t\t</view>\n";
+	}
+	xml += "\t</template>\n</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+const std::string& syntheticSkin ()
+{
+	static std::string skin = createSyntheticSkin (500);
+	return skin;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (UIDescription, parse)
+{
+	auto& skin = syntheticSkin ();
+	while (state.keepRunning ())
+	{
+		Xml::MemoryContentProvider provider (skin.data (), static_cast<uint32_t> (skin.size ()));
+		UIDescription desc (&provider);
+		doNotOptimize (desc.parse ());
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (UIDescription, createView)
+{
+	auto& skin = syntheticSkin ();
+	Xml::MemoryContentProvider provider (skin.data (), static_cast<uint32_t> (skin.size ()));
+	auto desc = makeOwned<UIDescription> (&provider);
+	if (!desc->parse ())
+		return;
+	while (state.keepRunning ())
+	{
+		auto view = desc->createView ("main", nullptr);
+		doNotOptimize (view);
+		state.pauseTiming ();
+		if (view)
+			view->forget ();
+		state.resumeTiming ();
+	}
+}
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
@@ -0,0 +1,125 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "platform_helper.h"
+#include "vstgui/lib/controls/ctextlabel.h"
+#include "vstgui/lib/cviewcontainer.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+namespace {
+
+//------------------------------------------------------------------------
+/** a hierarchy of nested containers, each level holding fanOut children */
+void fillContainer (CViewContainer* container, uint32_t depth, uint32_t fanOut, bool withLabels)
+{
+	auto size = container->getViewSize ().getWidth ();
+	auto childSize = size / fanOut;
+	for (auto i = 0u; i < fanOut; ++i)
+	{
+		CRect r (0, 0, childSize, childSize);
+		r.offset (i * childSize, (i % 2) * childSize * 0.5);
+		if (depth == 0)
+		{
+			if (withLabels)
+			{
+				auto label = new CTextLabel (r, "Label");
+				label->setBackColor (kGreyCColor);
+				container->addView (label);
+			}
+			else
+			{
+				container->addView (new CView (r));
+			}
+			continue;
+		}
+		auto child = new CViewContainer (r);
+		child->setBackgroundColor (CColor (static_cast<uint8_t> (depth * 40), 100, 100, 255));
+		fillContainer (child, depth - 1, fanOut, withLabels);
+		container->addView (child);
+	}
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CViewContainer> createHierarchy (uint32_t depth, uint32_t fanOut, bool withLabels)
+{
+	auto container = makeOwned<CViewContainer> (CRect (0, 0, 1024, 1024));
+	container->setBackgroundColor (kBlackCColor);
+	fillContainer (container, depth, fanOut, withLabels);
+	return container;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, drawRectDeep)
+{
+	auto container = createHierarchy (5, 4, false);
+	auto context = createOffscreenContext (1024., 1024.);
+	context->beginDraw ();
+	while (state.keepRunning ())
+		container->drawRect (context, container->getViewSize ());
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, drawRectPartial)
+{
+	auto container = createHierarchy (5, 4, false);
+	auto context = createOffscreenContext (1024., 1024.);
+	context->beginDraw ();
+	CCoord offset = 0.;
+	while (state.keepRunning ())
+	{
+		container->drawRect (context, CRect (offset, offset, offset + 64., offset + 64.));
+		offset = offset > 900. ? 0. : offset + 17.;
+	}
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, drawRectLabels)
+{
+	auto container = createHierarchy (3, 6, true);
+	auto context = createOffscreenContext (1024., 1024.);
+	context->beginDraw ();
+	while (state.keepRunning ())
+		container->drawRect (context, container->getViewSize ());
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, getViewAt)
+{
+	auto container = createHierarchy (5, 4, false);
+	CPoint p;
+	while (state.keepRunning ())
+	{
+		doNotOptimize (container->getViewAt (p, GetViewOptions ().deep ()));
+		p.x = p.x > 1000. ? 0. : p.x + 13.;
+		p.y = p.y > 1000. ? 0. : p.y + 7.;
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, getViewsAt)
+{
+	auto container = createHierarchy (5, 4, false);
+	CViewContainer::ViewList views;
+	CPoint p;
+	while (state.keepRunning ())
+	{
+		views.clear ();
+		doNotOptimize (container->getViewsAt (p, views, GetViewOptions ().deep ()));
+		p.x = p.x > 1000. ? 0. : p.x + 13.;
+		p.y = p.y > 1000. ? 0. : p.y + 7.;
+	}
+}
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
@@ -44,6 +44,37 @@ struct MessageReceiver : public CBaseObject
 	bool messageReceived {false};
 };
 
+struct AnimationRecord
+{
+	int numStarted {0};
+	int numFinished {0};
+	int numCanceled {0};
+	float lastPos {-1.f};
+};
+
+struct RecordingTarget : public IAnimationTarget
+{
+	RecordingTarget (AnimationRecord& record, Animator* removeInTick = nullptr)
+	: record (record), removeInTick (removeInTick) {}
+
+	AnimationRecord& record;
+	Animator* removeInTick;
+
+	void animationStart (CView* view, IdStringPtr name) override { ++record.numStarted; }
+	void animationTick (CView* view, IdStringPtr name, float pos) override
+	{
+		record.lastPos = pos;
+		if (removeInTick)
+			removeInTick->removeAnimations (view);
+	}
+	void animationFinished (CView* view, IdStringPtr name, bool wasCanceled) override
+	{
+		++record.numFinished;
+		if (wasCanceled)
+			++record.numCanceled;
+	}
+};
+
 } // anonymous
 
 //-----------------------------------------------------------------------------
@@ -78,6 +109,41 @@ TESTCASE(AnimatorTest,
 		CFRunLoopRun ();
 	);
 	
+	TEST(advanceAllAnimationsToSameTime,
+		auto a = owned (new Animator ());
+		auto view = owned (new CView (CRect (0, 0, 0, 0)));
+		AnimationRecord r1;
+		AnimationRecord r2;
+		a->addAnimation (view, "Test1", new RecordingTarget (r1), new LinearTimingFunction (100));
+		a->addAnimation (view, "Test2", new RecordingTarget (r2), new LinearTimingFunction (200));
+		a->advance (1000);
+		EXPECT (r1.numStarted == 1);
+		EXPECT (r2.numStarted == 1);
+		EXPECT (r1.lastPos == 0.f);
+		a->advance (1050);
+		EXPECT (r1.lastPos == 0.5f);
+		EXPECT (r2.lastPos == 0.25f);
+		a->advance (1100);
+		EXPECT (r1.lastPos == 1.f);
+		EXPECT (r1.numFinished == 1);
+		EXPECT (r1.numCanceled == 0);
+		EXPECT (r2.numFinished == 0);
+		a->advance (1200);
+		EXPECT (r2.numFinished == 1);
+		EXPECT (r1.numFinished == 1);
+	);
+
+	TEST(removeInTickFinishesOnce,
+		auto a = owned (new Animator ());
+		auto view = owned (new CView (CRect (0, 0, 0, 0)));
+		AnimationRecord r;
+		a->addAnimation (view, "Test", new RecordingTarget (r, a), new LinearTimingFunction (100));
+		a->advance (1000);
+		EXPECT (r.numStarted == 1);
+		EXPECT (r.numFinished == 1);
+		EXPECT (r.numCanceled == 1);
+	);
+
 	TEST(animationMessage,
 		auto a = owned (new Animator ());
 		auto view = owned (new CView (CRect (0, 0, 0, 0)));
@@ -0,0 +1,94 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/casyncbitmapview.h"
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/platform/iplatformbitmap.h"
+#include "../unittests.h"
+#include <thread>
+
+namespace VSTGUI {
+
+TESTCASE(CAsyncBitmapBufferTest,
+
+	TEST(swapWithoutPost,
+		auto buffer = makeOwned<CAsyncBitmapBuffer> ();
+		EXPECT (buffer->hasPending () == false);
+		EXPECT (buffer->swap () == false);
+		EXPECT (buffer->getFront () == nullptr);
+		EXPECT (buffer->getGeneration () == 0);
+	);
+
+	TEST(swapTakesLastPosted,
+		auto buffer = makeOwned<CAsyncBitmapBuffer> ();
+		auto b1 = makeOwned<CBitmap> (10, 10);
+		auto b2 = makeOwned<CBitmap> (10, 10);
+		buffer->post (b1);
+		buffer->post (b2);
+		EXPECT (buffer->hasPending ());
+		EXPECT (buffer->swap ());
+		EXPECT (buffer->getFront () == b2);
+		EXPECT (buffer->getGeneration () == 1);
+		EXPECT (buffer->hasPending () == false);
+		EXPECT (buffer->swap () == false);
+		EXPECT (buffer->getFront () == b2);
+		EXPECT (buffer->getGeneration () == 1);
+	);
+
+	TEST(clear,
+		auto buffer = makeOwned<CAsyncBitmapBuffer> ();
+		buffer->post (makeOwned<CBitmap> (10, 10));
+		buffer->swap ();
+		buffer->post (makeOwned<CBitmap> (10, 10));
+		buffer->clear ();
+		EXPECT (buffer->getFront () == nullptr);
+		EXPECT (buffer->swap () == false);
+	);
+
+	TEST(renderOnWorkerThread,
+		auto buffer = makeOwned<CAsyncBitmapBuffer> ();
+		std::thread worker ([buffer] () {
+			if (auto offscreen = COffscreenContext::create (CPoint (20, 10)))
+			{
+				offscreen->beginDraw ();
+				offscreen->setFillColor (kRedCColor);
+				offscreen->drawRect (CRect (0, 0, 20, 10), kDrawFilled);
+				offscreen->endDraw ();
+				buffer->post (offscreen->getBitmap ());
+			}
+		});
+		worker.join ();
+		EXPECT (buffer->swap ());
+		EXPECT (buffer->getFront ());
+		EXPECT (buffer->getFront ()->getWidth () == 20);
+		EXPECT (buffer->getFront ()->getHeight () == 10);
+	);
+);
+
+TESTCASE(COffscreenContextTest,
+
+	TEST(createStandalone,
+		auto offscreen = COffscreenContext::create (CPoint (10, 20), 2.);
+		EXPECT (offscreen);
+		EXPECT (offscreen->getWidth () == 10);
+		EXPECT (offscreen->getHeight () == 20);
+		EXPECT (offscreen->getBitmap ()->getPlatformBitmap ()->getScaleFactor () == 2.);
+	);
+
+	TEST(createStandaloneEmpty,
+		// the platform decides, but an empty context must be safe to draw into
+		if (auto offscreen = COffscreenContext::create (CPoint (0, 20)))
+		{
+			EXPECT (offscreen->getWidth () == 0);
+			offscreen->beginDraw ();
+			offscreen->drawRect (CRect (0, 0, 10, 10), kDrawFilled);
+			offscreen->endDraw ();
+		}
+		if (auto offscreen = COffscreenContext::create (CPoint (20, 0)))
+			EXPECT (offscreen->getHeight () == 0);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,71 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdrawmethods.h"
+#include "../../../lib/crect.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+TESTCASE(CDrawMethodsTest,
+
+	TEST(decimateMinMaxKeepsFewSamples,
+		float samples[3];
+		samples[0] = -1.f;
+		samples[1] = 0.f;
+		samples[2] = 1.f;
+		std::vector<CPoint> points;
+		CDrawMethods::decimateMinMax (samples, 3, CRect (0, 0, 100, 10), 1., points);
+		EXPECT (points.size () == 3);
+		EXPECT (points[0] == CPoint (0, 10));
+		EXPECT (points[1] == CPoint (50, 5));
+		EXPECT (points[2] == CPoint (100, 0));
+	);
+
+	TEST(decimateMinMaxTwoPointsPerPixel,
+		std::vector<float> samples (1000, 0.f);
+		samples[10] = 1.f;
+		samples[15] = -1.f;
+		std::vector<CPoint> points;
+		CDrawMethods::decimateMinMax (samples.data (), samples.size (), CRect (0, 0, 10, 10), 1.,
+									  points);
+		EXPECT (points.size () <= 20);
+		EXPECT (points[0] == CPoint (0.5, 0));
+		EXPECT (points[1] == CPoint (0.5, 10));
+		EXPECT (points.back ().x == 9.5);
+	);
+
+	TEST(decimateMinMaxScaleFactor,
+		std::vector<float> samples (1000, 0.5f);
+		std::vector<CPoint> points;
+		CDrawMethods::decimateMinMax (samples.data (), samples.size (), CRect (0, 0, 10, 10), 2.,
+									  points);
+		EXPECT (points.size () == 20);
+		EXPECT (points[0] == CPoint (0.25, 2.5));
+	);
+
+	TEST(decimateEnvelope,
+		std::vector<float> samples (100, 0.f);
+		samples[3] = 1.f;
+		samples[7] = -0.5f;
+		std::vector<CPoint> upper;
+		std::vector<CPoint> lower;
+		CDrawMethods::decimateEnvelope (samples.data (), samples.size (), CRect (0, 0, 10, 10), 1.,
+										upper, lower);
+		EXPECT (upper.size () == 10);
+		EXPECT (lower.size () == 10);
+		EXPECT (upper[0] == CPoint (0.5, 0));
+		EXPECT (lower[0] == CPoint (0.5, 7.5));
+		EXPECT (upper[1] == CPoint (1.5, 5));
+		EXPECT (lower[1] == CPoint (1.5, 5));
+	);
+
+	TEST(decimateEmpty,
+		std::vector<CPoint> points (2);
+		CDrawMethods::decimateMinMax (nullptr, 0, CRect (0, 0, 10, 10), 1., points);
+		EXPECT (points.empty ());
+	);
+);
+
+} // VSTGUI
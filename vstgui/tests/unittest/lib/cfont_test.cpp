@@ -4,6 +4,7 @@
 
 #include "../unittests.h"
 #include "../../../lib/cfont.h"
+#include "../../../lib/platform/iplatformfont.h"
 
 namespace VSTGUI {
 
@@ -41,6 +42,51 @@ TESTCASE(CFontTests,
 		EXPECT(f != *kSystemFont);
 	);
 
+	TEST(sharedPlatformFont,
+		CPlatformFontCache::purge ();
+		auto before = CPlatformFontCache::getStatistics ();
+		auto f1 = makeOwned<CFontDesc> ("Arial", 17, kBoldFace);
+		auto f2 = makeOwned<CFontDesc> ("Arial", 17, kBoldFace);
+		auto pf1 = f1->getPlatformFont ();
+		auto pf2 = f2->getPlatformFont ();
+		EXPECT(pf1 == pf2);
+		auto stats = CPlatformFontCache::getStatistics ();
+		EXPECT(stats.hits + stats.misses == before.hits + before.misses + 2);
+		if (pf1)
+		{
+			EXPECT(stats.hits == before.hits + 1);
+			EXPECT(stats.liveFonts == before.liveFonts + 1);
+			EXPECT(stats.hitRate () > 0.);
+		}
+	);
+
+	TEST(differentFontsAreNotShared,
+		CFontDesc f1 ("Arial", 17, kBoldFace);
+		CFontDesc f2 ("Arial", 17, kItalicFace);
+		CFontDesc f3 ("Arial", 18, kBoldFace);
+		if (f1.getPlatformFont ())
+		{
+			EXPECT(f1.getPlatformFont () != f2.getPlatformFont ());
+			EXPECT(f1.getPlatformFont () != f3.getPlatformFont ());
+		}
+	);
+
+	TEST(evictWhenUnreferenced,
+		CPlatformFontCache::purge ();
+		auto before = CPlatformFontCache::getStatistics ();
+		auto f1 = makeOwned<CFontDesc> ("Arial", 19, kNormalFace);
+		if (f1->getPlatformFont ())
+		{
+			auto f2 = makeOwned<CFontDesc> (*f1);
+			EXPECT(f2->getPlatformFont () == f1->getPlatformFont ());
+			EXPECT(CPlatformFontCache::getStatistics ().liveFonts == before.liveFonts + 1);
+			f1 = nullptr;
+			EXPECT(CPlatformFontCache::getStatistics ().liveFonts == before.liveFonts + 1);
+			f2->setSize (20);
+			EXPECT(CPlatformFontCache::getStatistics ().liveFonts == before.liveFonts);
+		}
+	);
+
 );
 
 } // VSTGUI
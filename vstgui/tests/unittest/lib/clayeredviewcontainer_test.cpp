@@ -0,0 +1,140 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/clayeredviewcontainer.h"
+#include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../unittests.h"
+#include "platform_helper.h"
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+using DrawOrder = std::vector<CView*>;
+
+//-----------------------------------------------------------------------------
+class DrawCountView : public CView
+{
+public:
+	DrawCountView (const CRect& r, DrawOrder* drawOrder = nullptr)
+	: CView (r), drawOrder (drawOrder)
+	{
+	}
+
+	void draw (CDrawContext* context) override
+	{
+		++drawCount;
+		if (drawOrder)
+			drawOrder->push_back (this);
+	}
+
+	uint32_t drawCount {0};
+	DrawOrder* drawOrder;
+};
+
+//-----------------------------------------------------------------------------
+class InvalidRectRecorder : public CViewContainer
+{
+public:
+	InvalidRectRecorder () : CViewContainer (CRect (0, 0, 100, 100)) {}
+
+	void invalidRect (const CRect& rect) override { invalidRects.push_back (rect); }
+
+	std::vector<CRect> invalidRects;
+};
+
+//-----------------------------------------------------------------------------
+void drawFrame (CFrame* frame, COffscreenContext* context)
+{
+	context->beginDraw ();
+	frame->drawRect (context, frame->getViewSize ());
+	context->endDraw ();
+}
+
+} // anonymous
+
+TESTCASE(CLayeredViewContainerTest,
+
+	TEST(softwareLayerForwardsInvalidRectToParent,
+		auto platformHandle = UnitTest::PlatformParentHandle::create ();
+		auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+		auto parent = new InvalidRectRecorder ();
+		auto layered = new CLayeredViewContainer (CRect (10, 10, 60, 60));
+		parent->addView (layered);
+		frame->addView (parent);
+		frame->open (platformHandle->getHandle (), platformHandle->getType ());
+		if (!layered->getPlatformLayer ())
+		{
+			parent->invalidRects.clear ();
+			layered->invalidRect (CRect (0, 0, 5, 5));
+			EXPECT (parent->invalidRects.size () == 1);
+			EXPECT (parent->invalidRects[0] == CRect (10, 10, 15, 15));
+		}
+		frame->close ();
+	);
+
+	TEST(softwareLayerRedrawsOnlyInvalidViews,
+		auto platformHandle = UnitTest::PlatformParentHandle::create ();
+		auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+		auto layered = new CLayeredViewContainer (CRect (10, 10, 90, 90));
+		auto view1 = new DrawCountView (CRect (0, 0, 20, 20));
+		auto view2 = new DrawCountView (CRect (40, 40, 60, 60));
+		layered->addView (view1);
+		layered->addView (view2);
+		frame->addView (layered);
+		frame->open (platformHandle->getHandle (), platformHandle->getType ());
+		if (!layered->getPlatformLayer ())
+		{
+			auto context = COffscreenContext::create (frame, 100, 100);
+			EXPECT (context);
+			drawFrame (frame, context);
+			EXPECT (view1->drawCount == 1);
+			EXPECT (view2->drawCount == 1);
+			drawFrame (frame, context);
+			EXPECT (view1->drawCount == 1);
+			EXPECT (view2->drawCount == 1);
+			view1->invalid ();
+			drawFrame (frame, context);
+			EXPECT (view1->drawCount == 2);
+			EXPECT (view2->drawCount == 1);
+		}
+		frame->close ();
+	);
+
+	TEST(softwareLayerDrawsChildLayersByZIndex,
+		auto platformHandle = UnitTest::PlatformParentHandle::create ();
+		auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+		DrawOrder drawOrder;
+		auto layered = new CLayeredViewContainer (CRect (0, 0, 100, 100));
+		auto upper = new CLayeredViewContainer (CRect (0, 0, 50, 50));
+		auto lower = new CLayeredViewContainer (CRect (0, 0, 50, 50));
+		auto view = new DrawCountView (CRect (0, 0, 100, 100), &drawOrder);
+		auto upperView = new DrawCountView (CRect (0, 0, 50, 50), &drawOrder);
+		auto lowerView = new DrawCountView (CRect (0, 0, 50, 50), &drawOrder);
+		upper->setZIndex (2);
+		lower->setZIndex (1);
+		upper->addView (upperView);
+		lower->addView (lowerView);
+		layered->addView (upper);
+		layered->addView (lower);
+		layered->addView (view);
+		frame->addView (layered);
+		frame->open (platformHandle->getHandle (), platformHandle->getType ());
+		if (!layered->getPlatformLayer ())
+		{
+			auto context = COffscreenContext::create (frame, 100, 100);
+			drawFrame (frame, context);
+			EXPECT (drawOrder.size () == 3);
+			EXPECT (drawOrder[0] == view);
+			EXPECT (drawOrder[1] == lowerView);
+			EXPECT (drawOrder[2] == upperView);
+		}
+		frame->close ();
+	);
+);
+
+} // VSTGUI
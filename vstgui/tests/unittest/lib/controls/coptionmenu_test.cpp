@@ -0,0 +1,101 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../lib/controls/coptionmenu.h"
+#include "../../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class TestItemProvider : public IOptionMenuItemProvider, public NonAtomicReferenceCounted
+{
+public:
+	TestItemProvider (int32_t numItems) : numItems (numItems) {}
+
+	int32_t getNumItems () const override { return numItems; }
+	CMenuItem* createItem (int32_t index) override
+	{
+		++numCreated;
+		if (index % 10 == 9)
+			return new CMenuItem ("", nullptr, 0, nullptr, CMenuItem::kSeparator);
+		return new CMenuItem (std::to_string (index).data ());
+	}
+
+	int32_t numItems;
+	int32_t numCreated {0};
+};
+
+} // anonymous
+
+TESTCASE(COptionMenuTest,
+
+	TEST(itemProviderCreatesEntriesOnDemand,
+		auto provider = makeOwned<TestItemProvider> (20000);
+		auto menu = owned (new COptionMenu ());
+		menu->setItemProvider (provider);
+		EXPECT(menu->getNbEntries () == 20000);
+		EXPECT(menu->getMax () == 19999.f);
+		EXPECT(provider->numCreated == 0);
+		auto item = menu->getEntry (12345);
+		EXPECT(item);
+		EXPECT(item->getTitle () == "12345");
+		EXPECT(provider->numCreated == 1);
+		EXPECT(menu->getEntry (12345) == item);
+		EXPECT(provider->numCreated == 1);
+		EXPECT(menu->getEntry (20000) == nullptr);
+		EXPECT(provider->numCreated == 1);
+	);
+
+	TEST(itemProviderCheckEntryAlone,
+		auto provider = makeOwned<TestItemProvider> (100);
+		auto menu = owned (new COptionMenu ());
+		menu->setItemProvider (provider);
+		auto item = menu->getEntry (2);
+		item->setChecked (true);
+		menu->checkEntryAlone (50);
+		EXPECT(item->isChecked () == false);
+		EXPECT(provider->numCreated == 1);
+		EXPECT(menu->isCheckEntry (50));
+		EXPECT(menu->isCheckEntry (51) == false);
+	);
+
+	TEST(itemProviderSetCurrentCreatesNoEntries,
+		auto provider = makeOwned<TestItemProvider> (20000);
+		auto menu = owned (new COptionMenu ());
+		menu->setItemProvider (provider);
+		EXPECT(menu->setCurrent (12345, false));
+		EXPECT(menu->getCurrentIndex (true) == 12345);
+		EXPECT(menu->getCurrentIndex (false) == 12345);
+		EXPECT(menu->setCurrent (20000) == false);
+		EXPECT(provider->numCreated == 0);
+		EXPECT(menu->getCurrent ()->getTitle () == "12345");
+		EXPECT(provider->numCreated == 1);
+	);
+
+	TEST(itemProviderReload,
+		auto provider = makeOwned<TestItemProvider> (10);
+		auto menu = owned (new COptionMenu ());
+		menu->setItemProvider (provider);
+		auto item = shared (menu->getEntry (0));
+		provider->numItems = 20;
+		menu->setItemProvider (provider);
+		EXPECT(menu->getNbEntries () == 20);
+		EXPECT(menu->getEntry (0) != item);
+	);
+
+	TEST(removeAllEntryRemovesItemProvider,
+		auto provider = makeOwned<TestItemProvider> (10);
+		auto menu = owned (new COptionMenu ());
+		menu->setItemProvider (provider);
+		menu->removeAllEntry ();
+		EXPECT(menu->getItemProvider () == nullptr);
+		EXPECT(menu->getNbEntries () == 0);
+		menu->addEntry ("Entry");
+		EXPECT(menu->getNbEntries () == 1);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,82 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../lib/controls/cvumeter.h"
+#include "../../unittests.h"
+
+namespace VSTGUI {
+
+TESTCASE(CVuMeterTest,
+
+	TEST(timeBasedFallOff,
+		auto m = owned (new CVuMeter (CRect (0, 0, 10, 100), nullptr, nullptr, 10));
+		m->setDecreaseStepValue (0.1f);
+		m->setValue (1.f);
+		EXPECT (m->advance (0) == true);
+		EXPECT (m->getLitLedCount () == 10);
+		EXPECT (m->advance (0) == false);
+		m->setValue (0.f);
+		EXPECT (m->advance (100) == true);
+		EXPECT (m->getLitLedCount () == 7);
+		EXPECT (m->advance (100) == false);
+		EXPECT (m->advance (200) == true);
+		EXPECT (m->getLitLedCount () == 4);
+	);
+
+	TEST(peakHold,
+		auto m = owned (new CVuMeter (CRect (0, 0, 10, 100), nullptr, nullptr, 10));
+		m->setDecreaseStepValue (0.1f);
+		m->setPeakHoldTime (500);
+		m->setValue (1.f);
+		m->advance (1000);
+		m->setValue (0.f);
+		EXPECT (m->advance (1400) == false);
+		EXPECT (m->getLitLedCount () == 10);
+		EXPECT (m->advance (1600) == true);
+		EXPECT (m->getLitLedCount () == 7);
+	);
+
+	TEST(fallOffUsesIdleRateOfView,
+		auto m = owned (new CVuMeter (CRect (0, 0, 10, 100), nullptr, nullptr, 10));
+		m->setDecreaseStepValue (0.1f);
+		m->setIdleRate (10);
+		m->setValue (1.f);
+		m->advance (0);
+		m->setValue (0.f);
+		EXPECT (m->advance (100) == true);
+		EXPECT (m->getLitLedCount () == 9);
+	);
+
+	TEST(copyKeepsPeakHoldTime,
+		auto m = owned (new CVuMeter (CRect (0, 0, 10, 100), nullptr, nullptr, 10));
+		m->setPeakHoldTime (500);
+		auto copy = owned (new CVuMeter (*m));
+		EXPECT (copy->getPeakHoldTime () == 500);
+	);
+
+	TEST(valueQueue,
+		auto m = owned (new CVuMeter (CRect (0, 0, 10, 100), nullptr, nullptr, 10));
+		auto& queue = m->getValueQueue ();
+		EXPECT (queue.empty ());
+		EXPECT (queue.push (0.2f));
+		EXPECT (queue.push (0.72f));
+		EXPECT (queue.push (0.5f));
+		EXPECT (m->advance (0) == true);
+		EXPECT (queue.empty ());
+		EXPECT (m->getValue () == 0.72f);
+		EXPECT (m->getLitLedCount () == 7);
+	);
+
+	TEST(valueQueueFull,
+		CVuMeter::ValueQueue queue;
+		for (auto i = 0u; i < CVuMeter::ValueQueue::kCapacity; ++i)
+			EXPECT (queue.push (0.f));
+		EXPECT (queue.push (0.f) == false);
+		float value;
+		EXPECT (queue.pop (value));
+		EXPECT (queue.push (1.f));
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,91 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cshadowviewcontainer.h"
+#include "../../../lib/crect.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+CShadowMask makeTestMask ()
+{
+	CShadowMask mask (40, 30);
+	for (uint32_t y = 8; y < 20; ++y)
+	{
+		for (uint32_t x = 5; x < 30; ++x)
+			mask.getRow (y)[x] = static_cast<uint8_t> (x * 8);
+	}
+	mask.getRow (0)[0] = 255;
+	mask.getRow (29)[39] = 255;
+	return mask;
+}
+
+} // anonymous
+
+TESTCASE(CShadowMaskTest,
+
+	TEST(blurEmpty,
+		CShadowMask mask (10, 10);
+		mask.blur (4.);
+		for (uint32_t y = 0; y < 10; ++y)
+		{
+			for (uint32_t x = 0; x < 10; ++x)
+				EXPECT (mask.getRow (y)[x] == 0);
+		}
+	);
+
+	TEST(blurExtent,
+		EXPECT (CShadowMask::blurExtent (0.) == 0);
+		EXPECT (CShadowMask::blurExtent (4.) > 4);
+		EXPECT (CShadowMask::blurExtent (8.) > CShadowMask::blurExtent (4.));
+	);
+
+	TEST(blurSpreadsAlpha,
+		CShadowMask mask (21, 21);
+		mask.getRow (10)[10] = 255;
+		mask.blur (2.);
+		EXPECT (mask.getRow (10)[10] < 255);
+		EXPECT (mask.getRow (10)[10] > 0);
+		EXPECT (mask.getRow (10)[12] > 0);
+		EXPECT (mask.getRow (12)[10] == mask.getRow (10)[12]);
+		EXPECT (mask.getRow (0)[0] == 0);
+	);
+
+	TEST(blurRectMatchesFullBlur,
+		auto mask = makeTestMask ();
+		auto full = mask;
+		full.blur (3.);
+
+		auto extent = static_cast<CCoord> (CShadowMask::blurExtent (3.));
+		CRect outputRect (20, 2, 26, 7);
+		CRect inputRect (outputRect);
+		inputRect.extend (extent, extent);
+		inputRect.bound (CRect (0, 0, 40, 30));
+		auto part = mask.copyRect (inputRect);
+		part.blur (3.);
+		for (auto y = outputRect.top; y < outputRect.bottom; ++y)
+		{
+			for (auto x = outputRect.left; x < outputRect.right; ++x)
+			{
+				auto expected = full.getRow (static_cast<uint32_t> (y))[static_cast<uint32_t> (x)];
+				auto partY = static_cast<uint32_t> (y - inputRect.top);
+				auto partX = static_cast<uint32_t> (x - inputRect.left);
+				EXPECT (part.getRow (partY)[partX] == expected);
+			}
+		}
+	);
+
+	TEST(copyRect,
+		auto mask = makeTestMask ();
+		auto part = mask.copyRect (CRect (10, 8, 20, 10));
+		EXPECT (part.getWidth () == 10);
+		EXPECT (part.getHeight () == 2);
+		EXPECT (part.getRow (1)[0] == 80);
+	);
+);
+
+} // VSTGUI
@@ -6,6 +6,7 @@
 #include "../../../lib/cstring.h"
 #include "../../../lib/cview.h"
 #include "../../../lib/cviewcontainer.h"
+#include "../../../lib/cframe.h"
 #include "../../../lib/dragging.h"
 #include "../../../lib/iviewlistener.h"
 #include "../../../lib/idatapackage.h"
@@ -103,6 +104,39 @@ TESTCASE(CViewTest,
 		EXPECT(v.wantsIdle () == false);
 	);
 
+	TEST(idleRate,
+		View v;
+		EXPECT(v.getIdleRate () == CView::idleRate);
+		v.setIdleRate (60);
+		EXPECT(v.getIdleRate () == 60);
+		v.setIdleRate (0);
+		EXPECT(v.getIdleRate () == CView::idleRate);
+	);
+
+	TEST(effectiveVisibility,
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		auto container = new CViewContainer (CRect (50, 50, 100, 100));
+		auto v = new View ();
+		EXPECT(v->isEffectivelyVisible () == false);
+		container->addView (v);
+		EXPECT(v->isEffectivelyVisible () == false);
+		frame->addView (container);
+		frame->attached (frame);
+		EXPECT(v->isEffectivelyVisible () == true);
+		container->setVisible (false);
+		EXPECT(v->isEffectivelyVisible () == false);
+		container->setVisible (true);
+		container->setAlphaValue (0.f);
+		EXPECT(v->isEffectivelyVisible () == false);
+		container->setAlphaValue (1.f);
+		v->setViewSize (CRect (60, 60, 70, 70));
+		EXPECT(v->isEffectivelyVisible () == false);
+		v->setViewSize (CRect (45, 45, 55, 55));
+		EXPECT(v->isEffectivelyVisible () == true);
+		container->setViewSize (CRect (50, 50, 50, 100));
+		EXPECT(v->isEffectivelyVisible () == false);
+	);
+
 	TEST(mouseEnabledState,
 		View v;
 		EXPECT(v.getMouseEnabled () == true);
@@ -286,7 +320,7 @@ TESTCASE(CViewTest,
 TESTCASE(CViewMacTest,
 
 	TEST(idleAfterAttached,
-		auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto parent = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
 		auto container = owned (new CViewContainer (CRect (50, 50, 100, 100)));
 		container->attached (parent);
 		auto v = new View ();
@@ -303,7 +337,7 @@ TESTCASE(CViewMacTest,
 	);
 
 	TEST(idleBeforeAttached,
-		auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto parent = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
 		auto container = owned (new CViewContainer (CRect (50, 50, 100, 100)));
 		auto v = new View ();
 		container->addView (v);
@@ -0,0 +1,227 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairobitmapcache.h"
+#include "../../../unittests.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** uses a temporary cache directory and restores the state of the shared cache at the end of a
+ *	test */
+struct CacheGuard
+{
+	CacheGuard () : cache (Cairo::BitmapCache::instance ())
+	{
+		char tmpl[] = "/tmp/vstgui_bitmapcache_XXXXXX";
+		if (mkdtemp (tmpl))
+			directory = tmpl;
+		sizeLimit = cache.getSizeLimit ();
+		cache.setDirectory (directory);
+		cache.resetStatistics ();
+	}
+	~CacheGuard ()
+	{
+		cache.clear ();
+		cache.setDirectory ({});
+		cache.setSizeLimit (sizeLimit);
+		cache.resetStatistics ();
+		for (const auto& file : files)
+			unlink (file.data ());
+		rmdir (directory.data ());
+	}
+
+	/** write a source file which the test decode function turns into a width x 4 bitmap */
+	std::string writeFile (const std::string& name, size_t width)
+	{
+		auto path = directory + "/" + name;
+		if (auto file = fopen (path.data (), "wb"))
+		{
+			std::vector<uint8_t> content (width, static_cast<uint8_t> (name.size ()));
+			fwrite (content.data (), 1, content.size (), file);
+			fclose (file);
+		}
+		files.emplace_back (path);
+		return path;
+	}
+
+	size_t numCacheFiles () const
+	{
+		size_t result = 0;
+		if (auto dir = opendir (directory.data ()))
+		{
+			while (auto entry = readdir (dir))
+			{
+				std::string name (entry->d_name);
+				if (name.size () > 5 && name.compare (name.size () - 5, 5, ".vgbc") == 0)
+					++result;
+			}
+			closedir (dir);
+		}
+		return result;
+	}
+
+	Cairo::BitmapCache& cache;
+	std::string directory;
+	std::vector<std::string> files;
+	uint64_t sizeLimit;
+};
+
+//------------------------------------------------------------------------
+std::atomic<uint32_t> gNumDecoded {0};
+
+//------------------------------------------------------------------------
+Cairo::SurfaceHandle decode (const uint8_t* data, size_t size)
+{
+	++gNumDecoded;
+	auto width = static_cast<int> (size);
+	Cairo::SurfaceHandle surface (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, 4));
+	auto pixels = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	for (auto y = 0; y < 4; ++y)
+	{
+		for (auto x = 0; x < width * 4; ++x)
+			pixels[y * stride + x] = static_cast<uint8_t> (data[x / 4] + x + y);
+	}
+	return surface;
+}
+
+//------------------------------------------------------------------------
+bool hasDecodedPixels (const Cairo::SurfaceHandle& surface, uint8_t value, int width)
+{
+	if (!surface || cairo_image_surface_get_width (surface) != width ||
+		cairo_image_surface_get_height (surface) != 4)
+		return false;
+	auto pixels = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	for (auto y = 0; y < 4; ++y)
+	{
+		for (auto x = 0; x < width * 4; ++x)
+		{
+			if (pixels[y * stride + x] != static_cast<uint8_t> (value + x + y))
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+constexpr uint64_t kEntrySize = 64 + 100 * 4 * 4;
+
+} // anonymous
+
+TESTCASE(CairoBitmapCacheTest,
+
+	TEST(disabledCacheDecodesEveryTime,
+		CacheGuard guard;
+		auto path = guard.writeFile ("a.png", 100);
+		guard.cache.setDirectory ({});
+		EXPECT (guard.cache.isEnabled () == false);
+		gNumDecoded = 0;
+		EXPECT (hasDecodedPixels (guard.cache.load (path.data (), decode), 5, 100));
+		EXPECT (hasDecodedPixels (guard.cache.load (path.data (), decode), 5, 100));
+		EXPECT (gNumDecoded == 2);
+		EXPECT (guard.cache.getStatistics ().hits == 0);
+	);
+
+	TEST(hitMapsTheDecodedPixels,
+		CacheGuard guard;
+		auto path = guard.writeFile ("a.png", 100);
+		gNumDecoded = 0;
+		EXPECT (hasDecodedPixels (guard.cache.load (path.data (), decode), 5, 100));
+		EXPECT (guard.numCacheFiles () == 1);
+		auto surface = guard.cache.load (path.data (), decode);
+		EXPECT (hasDecodedPixels (surface, 5, 100));
+		EXPECT (gNumDecoded == 1);
+		auto statistics = guard.cache.getStatistics ();
+		EXPECT (statistics.misses == 1);
+		EXPECT (statistics.hits == 1);
+		EXPECT (statistics.bytesMapped == 100 * 4 * 4);
+		// the mapping is private, changing the pixels does not change the cache file
+		cairo_image_surface_get_data (surface)[0] = 0xFF;
+		EXPECT (hasDecodedPixels (guard.cache.load (path.data (), decode), 5, 100));
+	);
+
+	TEST(entriesAreKeyedByContent,
+		CacheGuard guard;
+		auto path1 = guard.writeFile ("a.png", 100);
+		auto path2 = guard.writeFile ("b.png", 100);
+		auto path3 = guard.writeFile ("abc.png", 100);
+		gNumDecoded = 0;
+		EXPECT (hasDecodedPixels (guard.cache.load (path1.data (), decode), 5, 100));
+		EXPECT (hasDecodedPixels (guard.cache.load (path2.data (), decode), 5, 100));
+		EXPECT (gNumDecoded == 1);
+		EXPECT (hasDecodedPixels (guard.cache.load (path3.data (), decode), 7, 100));
+		EXPECT (gNumDecoded == 2);
+		EXPECT (guard.numCacheFiles () == 2);
+	);
+
+	TEST(leastRecentlyUsedEntriesAreEvicted,
+		CacheGuard guard;
+		guard.cache.setSizeLimit (kEntrySize * 2);
+		auto path1 = guard.writeFile ("a.png", 100);
+		auto path2 = guard.writeFile ("ab.png", 100);
+		auto path3 = guard.writeFile ("abc.png", 100);
+		guard.cache.load (path1.data (), decode);
+		guard.cache.load (path2.data (), decode);
+		EXPECT (guard.numCacheFiles () == 2);
+		guard.cache.load (path3.data (), decode);
+		EXPECT (guard.numCacheFiles () == 2);
+		guard.cache.setSizeLimit (kEntrySize);
+		EXPECT (guard.numCacheFiles () == 1);
+		guard.cache.setSizeLimit (0);
+		EXPECT (guard.numCacheFiles () == 0);
+	);
+
+	TEST(newEntryIsKeptWhenLargerThanTheLimit,
+		CacheGuard guard;
+		guard.cache.setSizeLimit (kEntrySize / 2);
+		auto path = guard.writeFile ("a.png", 100);
+		gNumDecoded = 0;
+		guard.cache.load (path.data (), decode);
+		EXPECT (guard.numCacheFiles () == 1);
+		EXPECT (hasDecodedPixels (guard.cache.load (path.data (), decode), 5, 100));
+		EXPECT (gNumDecoded == 1);
+	);
+
+	TEST(concurrentLoads,
+		CacheGuard guard;
+		std::vector<std::string> paths;
+		for (auto i = 0u; i < 4; ++i)
+			paths.emplace_back (guard.writeFile (std::string (i + 1, 'a') + ".png", 100));
+		std::atomic<uint32_t> numFailed {0};
+		std::vector<std::thread> threads;
+		for (auto t = 0u; t < 4; ++t)
+		{
+			threads.emplace_back ([&, t] () {
+				for (auto i = 0u; i < 16; ++i)
+				{
+					auto index = (t + i) % paths.size ();
+					auto value = static_cast<uint8_t> (index + 5);
+					if (!hasDecodedPixels (guard.cache.load (paths[index].data (), decode),
+										   value, 100))
+						++numFailed;
+				}
+			});
+		}
+		for (auto& thread : threads)
+			thread.join ();
+		EXPECT (numFailed == 0);
+		auto statistics = guard.cache.getStatistics ();
+		EXPECT (statistics.hits + statistics.misses == 4 * 16);
+		EXPECT (statistics.misses >= 4);
+		EXPECT (guard.numCacheFiles () == 4);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,65 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairobitmap.h"
+#include "../../../../../lib/cbitmap.h"
+#include "../../../../../lib/coffscreencontext.h"
+#include "../../../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+uint32_t getPixel (COffscreenContext* context, int x, int y)
+{
+	auto bitmap = context->getBitmap ()->getPlatformBitmap ().cast<Cairo::Bitmap> ();
+	if (!bitmap)
+		return 0;
+	const auto& surface = bitmap->getSurface ();
+	cairo_surface_flush (surface);
+	auto data = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	return *reinterpret_cast<const uint32_t*> (data + y * stride + x * 4);
+}
+
+//------------------------------------------------------------------------
+constexpr uint32_t kOpaqueRed = 0xFFFF0000;
+
+} // anonymous
+
+TESTCASE(CairoContextTest,
+
+	TEST(drawEllipseKeepsTransform,
+		auto context = COffscreenContext::create (CPoint (40, 40));
+		EXPECT (context);
+		context->beginDraw ();
+		context->setDrawMode (kAliasing);
+		context->setFillColor (kBlueCColor);
+		context->drawEllipse (CRect (0, 0, 20, 20), kDrawFilled);
+		context->setFillColor (kRedCColor);
+		context->drawRect (CRect (20, 20, 40, 40), kDrawFilled);
+		context->endDraw ();
+		EXPECT (getPixel (context, 21, 21) == kOpaqueRed);
+		EXPECT (getPixel (context, 30, 30) == kOpaqueRed);
+		EXPECT (getPixel (context, 38, 38) == kOpaqueRed);
+	);
+
+	TEST(drawArcKeepsTransform,
+		auto context = COffscreenContext::create (CPoint (40, 40));
+		EXPECT (context);
+		context->beginDraw ();
+		context->setDrawMode (kAliasing);
+		context->setFrameColor (kBlueCColor);
+		context->drawArc (CRect (0, 0, 20, 20), 0.f, 180.f, kDrawStroked);
+		context->setFillColor (kRedCColor);
+		context->drawRect (CRect (20, 20, 40, 40), kDrawFilled);
+		context->endDraw ();
+		EXPECT (getPixel (context, 21, 21) == kOpaqueRed);
+		EXPECT (getPixel (context, 30, 30) == kOpaqueRed);
+		EXPECT (getPixel (context, 38, 38) == kOpaqueRed);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,75 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairogradient.h"
+#include "../../../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+SharedPointer<Cairo::Gradient> createGradient ()
+{
+	auto gradient = owned (CGradient::create (0., 1., kBlackCColor, kWhiteCColor));
+	return gradient.cast<Cairo::Gradient> ();
+}
+
+} // anonymous
+
+TESTCASE(CairoGradientTest,
+
+	TEST(linearPatternIsShared,
+		auto gradient = createGradient ();
+		auto pattern1 = gradient->getLinearGradient ();
+		auto pattern2 = gradient->getLinearGradient ();
+		EXPECT (pattern1);
+		EXPECT (static_cast<cairo_pattern_t*> (pattern1) == pattern2);
+		EXPECT (cairo_pattern_get_type (pattern1) == CAIRO_PATTERN_TYPE_LINEAR);
+	);
+
+	TEST(linearPatternStaysAnalytic,
+		auto gradient = createGradient ();
+		auto pattern = gradient->getLinearGradient ();
+		for (auto i = 0; i < 32; ++i)
+		{
+			auto current = gradient->getLinearGradient ();
+			EXPECT (static_cast<cairo_pattern_t*> (current) == pattern);
+			EXPECT (cairo_pattern_get_type (current) == CAIRO_PATTERN_TYPE_LINEAR);
+		}
+	);
+
+	TEST(addColorStopResetsPatterns,
+		auto gradient = createGradient ();
+		auto linear = gradient->getLinearGradient ();
+		auto radial = gradient->getRadialGradient ();
+		gradient->addColorStop (0.5, kRedCColor);
+		EXPECT (static_cast<cairo_pattern_t*> (linear) != gradient->getLinearGradient ());
+		EXPECT (static_cast<cairo_pattern_t*> (radial) != gradient->getRadialGradient ());
+	);
+
+	TEST(radialPatternPerOriginOffset,
+		auto gradient = createGradient ();
+		auto pattern1 = gradient->getRadialGradient ();
+		EXPECT (static_cast<cairo_pattern_t*> (pattern1) == gradient->getRadialGradient ());
+		EXPECT (cairo_pattern_get_type (pattern1) == CAIRO_PATTERN_TYPE_RADIAL);
+		auto pattern2 = gradient->getRadialGradient (CPoint (0.5, 0.));
+		EXPECT (static_cast<cairo_pattern_t*> (pattern1) != pattern2);
+	);
+
+	TEST(gradientMatrix,
+		cairo_matrix_t matrix;
+		EXPECT (Cairo::Gradient::getLinearGradientMatrix (CPoint (10, 20), CPoint (30, 20),
+														  matrix));
+		EXPECT (matrix.xx == 20. && matrix.yx == 0. && matrix.xy == 0. && matrix.yy == 20.);
+		EXPECT (matrix.x0 == 10. && matrix.y0 == 20.);
+		EXPECT (Cairo::Gradient::getLinearGradientMatrix (CPoint (5, 5), CPoint (5, 5),
+														  matrix) == false);
+		EXPECT (Cairo::Gradient::getRadialGradientMatrix (CPoint (40, 50), 8., matrix));
+		EXPECT (matrix.xx == 8. && matrix.yy == 8. && matrix.x0 == 40. && matrix.y0 == 50.);
+		EXPECT (Cairo::Gradient::getRadialGradientMatrix (CPoint (40, 50), 0., matrix) == false);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,203 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairopath.h"
+#include "../../../../../lib/platform/linux/cairocontext.h"
+#include "../../../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct PathFixture
+{
+	PathFixture ()
+	: surface (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 100, 100))
+	, cr (cairo_create (surface))
+	, path (owned (new Cairo::Path (cr)))
+	{
+	}
+
+	cairo_path_t* getPath (const CGraphicsTransform* alignTransform = nullptr)
+	{
+		return path->getPath (cr, alignTransform);
+	}
+
+	Cairo::SurfaceHandle surface;
+	Cairo::ContextHandle cr;
+	SharedPointer<Cairo::Path> path;
+};
+
+//------------------------------------------------------------------------
+CGraphicsTransform translation (CCoord x, CCoord y)
+{
+	return CGraphicsTransform ().translate (x, y);
+}
+
+//------------------------------------------------------------------------
+CPoint firstPoint (cairo_path_t* path)
+{
+	if (!path || path->num_data < 2 || path->data[0].header.type != CAIRO_PATH_MOVE_TO)
+		return {-1000., -1000.};
+	return {path->data[1].point.x, path->data[1].point.y};
+}
+
+//------------------------------------------------------------------------
+CPoint alignedPoint (const CGraphicsTransform& tm, const CPoint& p)
+{
+	auto result = Cairo::pixelAlign (tm, p);
+	return result.offset (-0.5, -0.5);
+}
+
+//------------------------------------------------------------------------
+const CPoint kStart (10.3, 10.3);
+const CRect kRect (10.3, 10.3, 20.6, 20.6);
+
+} // anonymous
+
+TESTCASE(CairoPathTest,
+
+	TEST(boundingBoxOfLines,
+		PathFixture f;
+		f.path->beginSubpath (10, 20);
+		f.path->addLine (40, 5);
+		f.path->addLine (30, 50);
+		EXPECT (f.path->getBoundingBox () == CRect (10, 5, 40, 50));
+		EXPECT (f.path->getCurrentPosition () == CPoint (30, 50));
+	);
+
+	TEST(currentPositionAfterClose,
+		PathFixture f;
+		f.path->beginSubpath (10, 10);
+		f.path->addLine (20, 10);
+		f.path->addLine (20, 20);
+		f.path->closeSubpath ();
+		EXPECT (f.path->getCurrentPosition () == CPoint (10, 10));
+	);
+
+	TEST(boundingBoxOfArc,
+		PathFixture f;
+		f.path->addArc (CRect (0, 0, 100, 100), 0, 90, true);
+		EXPECT (f.path->getBoundingBox () == CRect (50, 50, 100, 100));
+		EXPECT (f.path->getCurrentPosition () == CPoint (50, 100));
+	);
+
+	TEST(boundingBoxOfEllipse,
+		PathFixture f;
+		f.path->addEllipse (CRect (10, 20, 50, 40));
+		EXPECT (f.path->getBoundingBox () == CRect (10, 20, 50, 40));
+		EXPECT (f.path->getCurrentPosition () == CPoint (50, 30));
+	);
+
+	TEST(boundsAreUpdatedAfterChange,
+		PathFixture f;
+		f.path->addRect (CRect (10, 10, 20, 20));
+		EXPECT (f.path->getBoundingBox () == CRect (10, 10, 20, 20));
+		f.path->addRect (CRect (30, 30, 40, 40));
+		EXPECT (f.path->getBoundingBox () == CRect (10, 10, 40, 40));
+	);
+
+	TEST(unalignedPath,
+		PathFixture f;
+		f.path->addRect (kRect);
+		auto cPath = f.getPath ();
+		EXPECT (cPath == f.getPath ());
+		EXPECT (firstPoint (cPath) == kStart);
+	);
+
+	TEST(alignedPathIsPixelAligned,
+		PathFixture f;
+		f.path->addRect (kRect);
+		auto tm = translation (0.25, 0.25);
+		auto cPath = f.getPath (&tm);
+		EXPECT (cPath != f.getPath ());
+		EXPECT (firstPoint (cPath) == alignedPoint (tm, kStart));
+	);
+
+	TEST(integralTranslationSharesAlignedPath,
+		PathFixture f;
+		f.path->addRect (kRect);
+		auto tm1 = translation (0.25, 0.25);
+		auto tm2 = translation (3.25, -7.75);
+		auto cPath = f.getPath (&tm1);
+		EXPECT (f.getPath (&tm2) == cPath);
+		EXPECT (firstPoint (cPath) == alignedPoint (tm2, kStart));
+		auto tm3 = translation (0.75, 0.25);
+		EXPECT (f.getPath (&tm3) != cPath);
+		EXPECT (firstPoint (f.getPath (&tm3)) == alignedPoint (tm3, kStart));
+	);
+
+	TEST(leastRecentlyUsedAlignedPathIsReplaced,
+		PathFixture f;
+		f.path->addRect (kRect);
+		CGraphicsTransform tm[5];
+		cairo_path_t* cPath[5];
+		for (auto i = 0; i < 5; ++i)
+			tm[i] = translation (0.1 * (i + 1), 0.);
+		for (auto i = 0; i < 4; ++i)
+			cPath[i] = f.getPath (&tm[i]);
+		EXPECT (f.getPath (&tm[0]) == cPath[0]);
+		// replaces the path of tm[1]
+		cPath[4] = f.getPath (&tm[4]);
+		EXPECT (f.getPath (&tm[0]) == cPath[0]);
+		EXPECT (f.getPath (&tm[2]) == cPath[2]);
+		EXPECT (f.getPath (&tm[3]) == cPath[3]);
+		EXPECT (f.getPath (&tm[4]) == cPath[4]);
+		EXPECT (firstPoint (f.getPath (&tm[1])) == alignedPoint (tm[1], kStart));
+	);
+
+	TEST(dirtyRebuildsPaths,
+		PathFixture f;
+		f.path->addRect (kRect);
+		auto tm = translation (0.25, 0.25);
+		f.getPath ();
+		f.getPath (&tm);
+		f.path->addRect (CRect (0, 0, 5, 5));
+		EXPECT (f.path->getBoundingBox () == CRect (0, 0, 20.6, 20.6));
+		auto cPath = f.getPath ();
+		EXPECT (cPath && cPath->num_data > 12);
+		cPath = f.getPath (&tm);
+		EXPECT (cPath && cPath->num_data > 12);
+	);
+
+	TEST(hitTestFilledPath,
+		PathFixture f;
+		f.path->beginSubpath (10, 10);
+		f.path->addLine (50, 10);
+		f.path->addLine (10, 50);
+		f.path->closeSubpath ();
+		EXPECT (f.path->hitTest (CPoint (15, 15)));
+		EXPECT (f.path->hitTest (CPoint (25, 20), true));
+		EXPECT (f.path->hitTest (CPoint (5, 5)) == false);
+		EXPECT (f.path->hitTest (CPoint (40, 40)) == false);
+		EXPECT (f.path->hitTest (CPoint (60, 20)) == false);
+	);
+
+	TEST(hitTestEvenOddPathWithHole,
+		PathFixture f;
+		f.path->addRect (CRect (0, 0, 100, 100));
+		f.path->addRect (CRect (25, 25, 75, 75));
+		EXPECT (f.path->hitTest (CPoint (10, 10), true));
+		EXPECT (f.path->hitTest (CPoint (90, 50), true));
+		EXPECT (f.path->hitTest (CPoint (50, 50), true) == false);
+		EXPECT (f.path->hitTest (CPoint (50, 50), false));
+		EXPECT (f.path->hitTest (CPoint (110, 50), true) == false);
+	);
+
+	TEST(hitTestTransformedPath,
+		PathFixture f;
+		f.path->addRect (CRect (0, 0, 20, 20));
+		auto tm = translation (100, 50);
+		EXPECT (f.path->hitTest (CPoint (110, 60), false, &tm));
+		EXPECT (f.path->hitTest (CPoint (10, 10), false, &tm) == false);
+		EXPECT (f.path->hitTest (CPoint (10, 10)));
+		EXPECT (f.path->hitTest (CPoint (110, 60)) == false);
+		auto scale = CGraphicsTransform ().scale (2., 2.);
+		EXPECT (f.path->hitTest (CPoint (30, 30), false, &scale));
+		EXPECT (f.path->hitTest (CPoint (45, 30), false, &scale) == false);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,87 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairopixelbufferpool.h"
+#include "../../../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** restores the state of the shared pool at the end of a test */
+struct PoolGuard
+{
+	PoolGuard () : pool (Cairo::PixelBufferPool::instance ())
+	{
+		highWaterMark = pool.getHighWaterMark ();
+		pool.trim ();
+	}
+	~PoolGuard ()
+	{
+		pool.setHighWaterMark (highWaterMark);
+		pool.trim ();
+	}
+
+	Cairo::PixelBufferPool& pool;
+	size_t highWaterMark;
+};
+
+} // anonymous
+
+TESTCASE(CairoPixelBufferPoolTest,
+
+	TEST(sizeClass,
+		EXPECT (Cairo::PixelBufferPool::getSizeClass (1) == 1);
+		EXPECT (Cairo::PixelBufferPool::getSizeClass (64) == 64);
+		EXPECT (Cairo::PixelBufferPool::getSizeClass (65) == 80);
+		EXPECT (Cairo::PixelBufferPool::getSizeClass (100) == 112);
+		EXPECT (Cairo::PixelBufferPool::getSizeClass (1000000) == 1048576);
+	);
+
+	TEST(smallSurfacesAreNotPooled,
+		PoolGuard guard;
+		{
+			auto surface = guard.pool.createSurface (16, 16);
+			EXPECT (surface);
+			EXPECT (cairo_image_surface_get_width (surface) == 16);
+		}
+		EXPECT (guard.pool.getPooledBytes () == 0);
+	);
+
+	TEST(buffersAreReused,
+		PoolGuard guard;
+		unsigned char* data = nullptr;
+		{
+			auto surface = guard.pool.createSurface (300, 200);
+			EXPECT (cairo_image_surface_get_width (surface) == 300);
+			EXPECT (cairo_image_surface_get_height (surface) == 200);
+			data = cairo_image_surface_get_data (surface);
+			data[0] = 0xFF;
+		}
+		EXPECT (guard.pool.getPooledBytes () >= 300 * 200 * 4);
+		auto surface = guard.pool.createSurface (300, 195);
+		EXPECT (cairo_image_surface_get_data (surface) == data);
+		EXPECT (cairo_image_surface_get_data (surface)[0] == 0);
+		EXPECT (guard.pool.getPooledBytes () == 0);
+	);
+
+	TEST(highWaterMarkFreesOldestBuffers,
+		PoolGuard guard;
+		guard.pool.setHighWaterMark (300 * 300 * 4);
+		{
+			auto surface1 = guard.pool.createSurface (200, 200);
+			auto surface2 = guard.pool.createSurface (250, 250);
+			surface1.reset ();
+			EXPECT (guard.pool.getPooledBytes () ==
+					Cairo::PixelBufferPool::getSizeClass (200 * 200 * 4));
+		}
+		EXPECT (guard.pool.getPooledBytes () ==
+				Cairo::PixelBufferPool::getSizeClass (250 * 250 * 4));
+		guard.pool.trim ();
+		EXPECT (guard.pool.getPooledBytes () == 0);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,405 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairopngcodec.h"
+#include "../../../unittests.h"
+#include <png.h>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+Cairo::SurfaceHandle createSurface (int width, int height, uint32_t pixelValue)
+{
+	Cairo::SurfaceHandle surface (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+	auto data = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	for (auto y = 0; y < height; ++y)
+	{
+		auto pixel = reinterpret_cast<uint32_t*> (data + y * stride);
+		for (auto x = 0; x < width; ++x)
+			pixel[x] = pixelValue;
+	}
+	cairo_surface_mark_dirty (surface);
+	return surface;
+}
+
+//------------------------------------------------------------------------
+uint32_t getPixel (cairo_surface_t* surface, int x, int y)
+{
+	auto data = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	return reinterpret_cast<const uint32_t*> (data + y * stride)[x];
+}
+
+//------------------------------------------------------------------------
+/** the parameters and the packed rows of a PNG written with libpng */
+struct PNGDescription
+{
+	PNGDescription (uint32_t width, uint32_t height, int colorType, int bitDepth)
+	: width (width), height (height), colorType (colorType), bitDepth (bitDepth)
+	{
+	}
+
+	uint32_t width;
+	uint32_t height;
+	int colorType;
+	int bitDepth;
+	int interlace {PNG_INTERLACE_NONE};
+	std::vector<png_color> palette;
+	std::vector<png_byte> paletteAlpha;
+	bool hasTransparentColor {false};
+	png_color_16 transparentColor {};
+	std::vector<uint8_t> rows;
+};
+
+//------------------------------------------------------------------------
+void appendData (png_structp png, png_bytep data, png_size_t size)
+{
+	auto buffer = static_cast<std::vector<uint8_t>*> (png_get_io_ptr (png));
+	buffer->insert (buffer->end (), data, data + size);
+}
+
+//------------------------------------------------------------------------
+void flushData (png_structp) {}
+
+//------------------------------------------------------------------------
+bool writePNG (png_structp png, png_infop info, const PNGDescription& desc,
+			   std::vector<uint8_t>& buffer)
+{
+	if (setjmp (png_jmpbuf (png)))
+		return false;
+	png_set_write_fn (png, &buffer, appendData, flushData);
+	png_set_IHDR (png, info, desc.width, desc.height, desc.bitDepth, desc.colorType,
+				  desc.interlace, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+	if (!desc.palette.empty ())
+		png_set_PLTE (png, info, desc.palette.data (), static_cast<int> (desc.palette.size ()));
+	if (!desc.paletteAlpha.empty () || desc.hasTransparentColor)
+	{
+		auto transparentColor = desc.transparentColor;
+		png_set_tRNS (png, info, desc.paletteAlpha.data (),
+					  static_cast<int> (desc.paletteAlpha.size ()),
+					  desc.hasTransparentColor ? &transparentColor : nullptr);
+	}
+	png_write_info (png, info);
+	auto rowBytes = desc.rows.size () / desc.height;
+	std::vector<png_bytep> rows (desc.height);
+	for (uint32_t y = 0; y < desc.height; ++y)
+		rows[y] = const_cast<png_bytep> (desc.rows.data () + y * rowBytes);
+	// writes all passes of interlaced images
+	png_write_image (png, rows.data ());
+	png_write_end (png, info);
+	return true;
+}
+
+//------------------------------------------------------------------------
+std::vector<uint8_t> encodePNG (const PNGDescription& desc)
+{
+	std::vector<uint8_t> buffer;
+	auto png = png_create_write_struct (PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	auto info = png ? png_create_info_struct (png) : nullptr;
+	if (!info || !writePNG (png, info, desc, buffer))
+		buffer.clear ();
+	png_destroy_write_struct (&png, &info);
+	return buffer;
+}
+
+//------------------------------------------------------------------------
+Cairo::SurfaceHandle decodePNG (const PNGDescription& desc)
+{
+	auto data = encodePNG (desc);
+	if (data.empty ())
+		return {};
+	auto surface = Cairo::PNGCodec::decode (data.data (), data.size ());
+	if (!surface || cairo_image_surface_get_format (surface) != CAIRO_FORMAT_ARGB32 ||
+		cairo_image_surface_get_width (surface) != static_cast<int> (desc.width) ||
+		cairo_image_surface_get_height (surface) != static_cast<int> (desc.height))
+		return {};
+	return surface;
+}
+
+//------------------------------------------------------------------------
+/** red, green, blue and white pixels, the first two translucent and transparent with tRNS */
+PNGDescription palettePNG (int bitDepth, bool withTRNS)
+{
+	PNGDescription desc (4, 1, PNG_COLOR_TYPE_PALETTE, bitDepth);
+	desc.palette = {{0xFF, 0, 0}, {0, 0xFF, 0}, {0, 0, 0xFF}, {0xFF, 0xFF, 0xFF}};
+	if (withTRNS)
+		desc.paletteAlpha = {0x80, 0};
+	if (bitDepth == 2)
+		desc.rows = {0x1B};
+	else
+		desc.rows = {0, 1, 2, 3};
+	return desc;
+}
+
+//------------------------------------------------------------------------
+PNGDescription grayPNG (int bitDepth)
+{
+	PNGDescription desc (bitDepth == 1 ? 8 : 2, 1, PNG_COLOR_TYPE_GRAY, bitDepth);
+	if (bitDepth == 1)
+		desc.rows = {0xA5};
+	else if (bitDepth == 16)
+		desc.rows = {0x40, 0x40, 0xFF, 0xFF};
+	else
+		desc.rows = {0x40, 0xFF};
+	return desc;
+}
+
+//------------------------------------------------------------------------
+PNGDescription grayAlphaPNG (int bitDepth)
+{
+	PNGDescription desc (2, 1, PNG_COLOR_TYPE_GRAY_ALPHA, bitDepth);
+	if (bitDepth == 16)
+		desc.rows = {0xFF, 0xFF, 0x80, 0x80, 0x40, 0x40, 0xFF, 0xFF};
+	else
+		desc.rows = {0xFF, 0x80, 0x40, 0xFF};
+	return desc;
+}
+
+//------------------------------------------------------------------------
+PNGDescription rgbPNG (int bitDepth)
+{
+	PNGDescription desc (2, 1, PNG_COLOR_TYPE_RGB, bitDepth);
+	if (bitDepth == 16)
+		desc.rows = {0x20, 0x20, 0x40, 0x40, 0x80, 0x80, 1, 1, 2, 2, 3, 3};
+	else
+		desc.rows = {0x20, 0x40, 0x80, 1, 2, 3};
+	return desc;
+}
+
+//------------------------------------------------------------------------
+PNGDescription rgbaPNG (int bitDepth)
+{
+	PNGDescription desc (2, 1, PNG_COLOR_TYPE_RGB_ALPHA, bitDepth);
+	if (bitDepth == 16)
+		desc.rows = {0xFF, 0xFF, 0, 0, 0, 0, 0x80, 0x80, 0x20, 0x20, 0x40, 0x40, 0x80, 0x80,
+					 0xFF, 0xFF};
+	else
+		desc.rows = {0xFF, 0, 0, 0x80, 0x20, 0x40, 0x80, 0xFF};
+	return desc;
+}
+
+//------------------------------------------------------------------------
+/** the second pixel of the gray and RGB descriptions above is transparent */
+PNGDescription withTransparentColor (PNGDescription desc)
+{
+	desc.hasTransparentColor = true;
+	if (desc.colorType == PNG_COLOR_TYPE_GRAY)
+		desc.transparentColor.gray = 0xFF;
+	else
+	{
+		desc.transparentColor.red = 1;
+		desc.transparentColor.green = 2;
+		desc.transparentColor.blue = 3;
+	}
+	return desc;
+}
+
+//------------------------------------------------------------------------
+constexpr uint32_t kInterlacedSize = 11;
+
+//------------------------------------------------------------------------
+uint32_t interlacedPixel (uint32_t x, uint32_t y)
+{
+	return 0xFF000000 | ((x * 20) << 16) | ((y * 20) << 8) | (x + y);
+}
+
+//------------------------------------------------------------------------
+/** large enough for all seven Adam7 passes */
+PNGDescription interlacedPNG ()
+{
+	PNGDescription desc (kInterlacedSize, kInterlacedSize, PNG_COLOR_TYPE_RGB, 8);
+	desc.interlace = PNG_INTERLACE_ADAM7;
+	for (uint32_t y = 0; y < kInterlacedSize; ++y)
+	{
+		for (uint32_t x = 0; x < kInterlacedSize; ++x)
+		{
+			auto pixel = interlacedPixel (x, y);
+			desc.rows.push_back (static_cast<uint8_t> (pixel >> 16));
+			desc.rows.push_back (static_cast<uint8_t> (pixel >> 8));
+			desc.rows.push_back (static_cast<uint8_t> (pixel));
+		}
+	}
+	return desc;
+}
+
+//------------------------------------------------------------------------
+bool hasInterlacedPixels (cairo_surface_t* surface)
+{
+	for (uint32_t y = 0; y < kInterlacedSize; ++y)
+	{
+		for (uint32_t x = 0; x < kInterlacedSize; ++x)
+		{
+			if (getPixel (surface, x, y) != interlacedPixel (x, y))
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+const uint8_t truncatedPNG[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A, 0, 0};
+
+} // anonymous
+
+TESTCASE(CairoPNGCodecTest,
+
+	TEST(roundTripOpaque,
+		auto surface = createSurface (13, 7, 0xFF204080);
+		auto png = Cairo::PNGCodec::encode (surface, 6);
+		EXPECT (png.size () > 8);
+		auto decoded = Cairo::PNGCodec::decode (png.data (), png.size ());
+		EXPECT (decoded);
+		EXPECT (cairo_image_surface_get_format (decoded) == CAIRO_FORMAT_ARGB32);
+		EXPECT (cairo_image_surface_get_width (decoded) == 13);
+		EXPECT (cairo_image_surface_get_height (decoded) == 7);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFF204080);
+		EXPECT (getPixel (decoded, 12, 6) == 0xFF204080);
+	);
+
+	TEST(roundTripPremultiplied,
+		auto surface = createSurface (4, 4, 0x80402010);
+		auto png = Cairo::PNGCodec::encode (surface, 1);
+		auto decoded = Cairo::PNGCodec::decode (png.data (), png.size ());
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 3, 3) == 0x80402010);
+	);
+
+	TEST(transparentPixelsAreCleared,
+		auto surface = createSurface (2, 2, 0x00000000);
+		auto png = Cairo::PNGCodec::encode (surface);
+		auto decoded = Cairo::PNGCodec::decode (png.data (), png.size ());
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 1, 1) == 0);
+	);
+
+	TEST(roundTripLargeImage,
+		auto surface = createSurface (600, 600, 0xC0603000);
+		auto png = Cairo::PNGCodec::encode (surface, 0);
+		auto decoded = Cairo::PNGCodec::decode (png.data (), png.size ());
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xC0603000);
+		EXPECT (getPixel (decoded, 599, 599) == 0xC0603000);
+	);
+
+	TEST(compressionLevel,
+		auto level = Cairo::PNGCodec::getCompressionLevel ();
+		EXPECT (level == 6);
+		Cairo::PNGCodec::setCompressionLevel (12);
+		EXPECT (Cairo::PNGCodec::getCompressionLevel () == 9);
+		Cairo::PNGCodec::setCompressionLevel (level);
+	);
+
+	TEST(palette,
+		auto decoded = decodePNG (palettePNG (8, false));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFFFF0000);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF00FF00);
+		EXPECT (getPixel (decoded, 2, 0) == 0xFF0000FF);
+		EXPECT (getPixel (decoded, 3, 0) == 0xFFFFFFFF);
+	);
+
+	TEST(packedPalette,
+		auto decoded = decodePNG (palettePNG (2, false));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFFFF0000);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF00FF00);
+		EXPECT (getPixel (decoded, 2, 0) == 0xFF0000FF);
+		EXPECT (getPixel (decoded, 3, 0) == 0xFFFFFFFF);
+	);
+
+	TEST(paletteWithTRNS,
+		auto decoded = decodePNG (palettePNG (8, true));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0x80800000);
+		EXPECT (getPixel (decoded, 1, 0) == 0);
+		EXPECT (getPixel (decoded, 2, 0) == 0xFF0000FF);
+		EXPECT (getPixel (decoded, 3, 0) == 0xFFFFFFFF);
+	);
+
+	TEST(gray,
+		auto decoded = decodePNG (grayPNG (8));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFF404040);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFFFFFFFF);
+		decoded = decodePNG (grayPNG (16));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFF404040);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFFFFFFFF);
+	);
+
+	TEST(packedGray,
+		auto decoded = decodePNG (grayPNG (1));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFFFFFFFF);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF000000);
+		EXPECT (getPixel (decoded, 5, 0) == 0xFFFFFFFF);
+		EXPECT (getPixel (decoded, 6, 0) == 0xFF000000);
+		EXPECT (getPixel (decoded, 7, 0) == 0xFFFFFFFF);
+	);
+
+	TEST(grayWithTRNS,
+		auto decoded = decodePNG (withTransparentColor (grayPNG (8)));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFF404040);
+		EXPECT (getPixel (decoded, 1, 0) == 0);
+	);
+
+	TEST(grayAlpha,
+		auto decoded = decodePNG (grayAlphaPNG (8));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0x80808080);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF404040);
+		decoded = decodePNG (grayAlphaPNG (16));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0x80808080);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF404040);
+	);
+
+	TEST(rgb,
+		auto decoded = decodePNG (rgbPNG (8));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFF204080);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF010203);
+		decoded = decodePNG (rgbPNG (16));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFF204080);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF010203);
+	);
+
+	TEST(rgbWithTRNS,
+		auto decoded = decodePNG (withTransparentColor (rgbPNG (8)));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0xFF204080);
+		EXPECT (getPixel (decoded, 1, 0) == 0);
+	);
+
+	TEST(rgba,
+		auto decoded = decodePNG (rgbaPNG (8));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0x80800000);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF204080);
+		decoded = decodePNG (rgbaPNG (16));
+		EXPECT (decoded);
+		EXPECT (getPixel (decoded, 0, 0) == 0x80800000);
+		EXPECT (getPixel (decoded, 1, 0) == 0xFF204080);
+	);
+
+	TEST(interlaced,
+		auto decoded = decodePNG (interlacedPNG ());
+		EXPECT (decoded);
+		EXPECT (hasInterlacedPixels (decoded));
+	);
+
+	TEST(invalidData,
+		EXPECT (!Cairo::PNGCodec::decode (truncatedPNG, sizeof (truncatedPNG)));
+		EXPECT (!Cairo::PNGCodec::decode (truncatedPNG, 4));
+		EXPECT (!Cairo::PNGCodec::decode (nullptr, 0));
+	);
+);
+
+} // VSTGUI
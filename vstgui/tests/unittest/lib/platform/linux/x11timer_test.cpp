@@ -0,0 +1,192 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/x11timer.h"
+#include "../../../unittests.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct TestTimerHandler : X11::ITimerHandler
+{
+	void onTimer () override
+	{
+		++fireCount;
+		if (proc)
+			proc ();
+	}
+
+	uint32_t fireCount {0};
+	std::function<void ()> proc;
+};
+
+//------------------------------------------------------------------------
+struct TestRunLoop : X11::IRunLoop, AtomicReferenceCounted
+{
+	bool registerEventHandler (int fd, X11::IEventHandler* handler) override { return true; }
+	bool unregisterEventHandler (X11::IEventHandler* handler) override { return true; }
+
+	bool registerTimer (uint64_t interval, X11::ITimerHandler* handler) override
+	{
+		timers.push_back (handler);
+		return true;
+	}
+
+	bool unregisterTimer (X11::ITimerHandler* handler) override
+	{
+		auto it = std::find (timers.begin (), timers.end (), handler);
+		if (it == timers.end ())
+			return false;
+		timers.erase (it);
+		return true;
+	}
+
+	std::vector<X11::ITimerHandler*> timers;
+};
+
+} // anonymous
+
+TESTCASE(X11TimerWheelTest,
+
+	TEST(firesAfterPeriod,
+		X11::TimerWheel wheel (4);
+		TestTimerHandler handler;
+		EXPECT (wheel.empty ());
+		EXPECT (wheel.getNextDueTime () == X11::TimerWheel::kNoTimer);
+		wheel.add (&handler, 16, 1000);
+		EXPECT (wheel.empty () == false);
+		EXPECT (wheel.getNextDueTime () <= 1016);
+		wheel.advance (1008);
+		EXPECT (handler.fireCount == 0);
+		wheel.advance (1016);
+		EXPECT (handler.fireCount == 1);
+		wheel.advance (1032);
+		EXPECT (handler.fireCount == 2);
+		EXPECT (wheel.remove (&handler));
+		EXPECT (wheel.remove (&handler) == false);
+		wheel.advance (1100);
+		EXPECT (handler.fireCount == 2);
+	);
+
+	TEST(coalesceWithinSlack,
+		X11::TimerWheel wheel (10);
+		TestTimerHandler handler1;
+		TestTimerHandler handler2;
+		wheel.add (&handler1, 16, 0);
+		wheel.add (&handler2, 20, 0);
+		wheel.advance (15);
+		EXPECT (handler1.fireCount == 1);
+		EXPECT (handler2.fireCount == 1);
+	);
+
+	TEST(statistics,
+		X11::TimerWheel wheel (4);
+		TestTimerHandler handler;
+		X11::TimerWheel::Statistics statistics;
+		EXPECT (wheel.getStatistics (&handler, statistics) == false);
+		wheel.add (&handler, 16, 1000);
+		wheel.advance (1030);
+		EXPECT (wheel.getStatistics (&handler, statistics));
+		EXPECT (statistics.fireCount == 1);
+		EXPECT (statistics.totalLatenessMs == 14);
+		EXPECT (statistics.maxLatenessMs == 14);
+		wheel.advance (1040);
+		EXPECT (wheel.getStatistics (&handler, statistics));
+		EXPECT (statistics.fireCount == 2);
+		EXPECT (statistics.totalLatenessMs == 22);
+		EXPECT (statistics.maxLatenessMs == 14);
+	);
+
+	TEST(dropMissedPeriods,
+		X11::TimerWheel wheel (4);
+		TestTimerHandler handler;
+		wheel.add (&handler, 10, 0);
+		wheel.advance (100000);
+		EXPECT (handler.fireCount == 1);
+		wheel.advance (100010);
+		EXPECT (handler.fireCount == 2);
+	);
+
+	TEST(removeFromCallback,
+		X11::TimerWheel wheel (4);
+		TestTimerHandler handler1;
+		TestTimerHandler handler2;
+		handler1.proc = [&] () { wheel.remove (&handler2); };
+		handler2.proc = [&] () { wheel.remove (&handler1); };
+		wheel.add (&handler1, 8, 0);
+		wheel.add (&handler2, 8, 0);
+		wheel.advance (8);
+		EXPECT (handler1.fireCount + handler2.fireCount == 1);
+		EXPECT (wheel.empty () == false);
+	);
+
+	TEST(restartFromCallback,
+		X11::TimerWheel wheel (4);
+		TestTimerHandler handler;
+		handler.proc = [&] () { wheel.add (&handler, 100, 8); };
+		wheel.add (&handler, 8, 0);
+		wheel.advance (8);
+		EXPECT (handler.fireCount == 1);
+		wheel.advance (16);
+		EXPECT (handler.fireCount == 1);
+		wheel.advance (108);
+		EXPECT (handler.fireCount == 2);
+	);
+
+	TEST(changeSlack,
+		X11::TimerWheel wheel (4);
+		TestTimerHandler handler;
+		wheel.add (&handler, 100, 0);
+		wheel.setSlack (50);
+		EXPECT (wheel.getSlack () == 50);
+		wheel.advance (60);
+		EXPECT (handler.fireCount == 0);
+		wheel.advance (80);
+		EXPECT (handler.fireCount == 1);
+	);
+);
+
+TESTCASE(X11RunLoopTimerWheelTest,
+
+	TEST(registerAtNewRunLoopAfterExit,
+		SharedPointer<TestRunLoop> runLoop = makeOwned<TestRunLoop> ();
+		X11::RunLoopTimerWheel timerWheel ([&] () { return runLoop; });
+		TestTimerHandler handler;
+		EXPECT (timerWheel.add (&handler, 16));
+		EXPECT (runLoop->timers.size () == 1);
+		auto exitedRunLoop = runLoop;
+		runLoop = nullptr;
+		EXPECT (timerWheel.remove (&handler));
+		EXPECT (exitedRunLoop->timers.empty ());
+		runLoop = makeOwned<TestRunLoop> ();
+		EXPECT (timerWheel.add (&handler, 16));
+		EXPECT (runLoop->timers.size () == 1);
+		EXPECT (exitedRunLoop->timers.empty ());
+		EXPECT (timerWheel.remove (&handler));
+		EXPECT (runLoop->timers.empty ());
+	);
+
+	TEST(registerAtReplacedRunLoop,
+		SharedPointer<TestRunLoop> runLoop = makeOwned<TestRunLoop> ();
+		X11::RunLoopTimerWheel timerWheel ([&] () { return runLoop; });
+		TestTimerHandler handler1;
+		TestTimerHandler handler2;
+		EXPECT (timerWheel.add (&handler1, 16));
+		auto oldRunLoop = runLoop;
+		runLoop = makeOwned<TestRunLoop> ();
+		EXPECT (timerWheel.add (&handler2, 16));
+		EXPECT (oldRunLoop->timers.empty ());
+		EXPECT (runLoop->timers.size () == 1);
+		EXPECT (timerWheel.remove (&handler1));
+		EXPECT (timerWheel.remove (&handler2));
+		EXPECT (runLoop->timers.empty ());
+	);
+);
+
+} // VSTGUI
@@ -7,6 +7,8 @@
 
 #if MAC
 #include "../../../lib/platform/mac/macstring.h"
+#elif LINUX
+#include "../../../lib/platform/linux/linuxstring.h"
 #endif
 
 namespace VSTGUI {
@@ -69,6 +71,43 @@ TESTCASE(UTF8StringTest,
 		 }
 		 EXPECT(charCount == 3);
 	);
+
+	TEST(unchangedAssignKeepsPlatformString,
+		UTF8String str ("Test");
+		SharedPointer<IPlatformString> platformStr = str.getPlatformString ();
+		str = "Test";
+		EXPECT (str.getPlatformString () == platformStr);
+		str = "Other";
+		EXPECT (str.getPlatformString () != platformStr);
+	);
+
+	TEST(copyDoesNotSharePlatformString,
+		UTF8String str1 ("Test");
+		auto platformStr = str1.getPlatformString ();
+		UTF8String str2 (str1);
+		EXPECT (str2.getPlatformString () != platformStr);
+		UTF8String str3;
+		str3 = str1;
+		EXPECT (str3.getPlatformString () != platformStr);
+		EXPECT (str1.getPlatformString () == platformStr);
+	);
+
+	TEST(formatFixed,
+		char buffer[16];
+		EXPECT (formatFixed (buffer, sizeof (buffer), 0.5, 2) == 4);
+		EXPECT (UTF8String (buffer) == "0.50");
+		EXPECT (formatFixed (buffer, sizeof (buffer), -12.345, 1) == 5);
+		EXPECT (UTF8String (buffer) == "-12.3");
+		EXPECT (formatFixed (buffer, sizeof (buffer), 3.7, 0) == 1);
+		EXPECT (UTF8String (buffer) == "4");
+	);
+
+	TEST(formatFixedTruncates,
+		char buffer[4];
+		EXPECT (formatFixed (buffer, sizeof (buffer), 123456., 0) == 3);
+		EXPECT (UTF8String (buffer) == "123");
+		EXPECT (formatFixed (buffer, 0, 1., 0) == 0);
+	);
 );
 
 #if MAC
@@ -85,6 +124,52 @@ TESTCASE(UTF8StringMacTest,
 		CFRelease (cfStr2);
 	);
 
+);
+#elif LINUX
+TESTCASE(UTF8StringLinuxTest,
+
+	TEST(platformStringReferencesStorage,
+		UTF8String str1 ("A string too long for the small string buffer");
+		auto linuxStr = dynamic_cast<LinuxString*> (str1.getPlatformString ());
+		EXPECT (linuxStr);
+		EXPECT (linuxStr->isReference ());
+		EXPECT (linuxStr->data () == str1.data ());
+		EXPECT (linuxStr->length () == str1.length ());
+	);
+
+	TEST(platformStringFollowsStorage,
+		UTF8String str1 ("Test");
+		auto platformStr = str1.getPlatformString ();
+		UTF8String str2 (std::move (str1));
+		EXPECT (str2.getPlatformString () == platformStr);
+		auto linuxStr = dynamic_cast<LinuxString*> (platformStr);
+		EXPECT (linuxStr->data () == str2.data ());
+
+		UTF8String str3;
+		{
+			UTF8String str4 ("Shared");
+			str4.getPlatformString ();
+			str3 = str4;
+		}
+		linuxStr = dynamic_cast<LinuxString*> (str3.getPlatformString ());
+		EXPECT (linuxStr->data () == str3.data ());
+		EXPECT (std::string (linuxStr->data ()) == "Shared");
+	);
+
+	TEST(setUTF8StringCopies,
+		auto platformStr = IPlatformString::createWithUTF8String ("Test");
+		auto linuxStr = platformStr.cast<LinuxString> ();
+		EXPECT (linuxStr->isReference () == false);
+		EXPECT (std::string (linuxStr->data ()) == "Test");
+		linuxStr->getShaping ().fontID = 1;
+		platformStr->updateUTF8StringReference ("Other", 5);
+		EXPECT (std::string (linuxStr->data ()) == "Test");
+		EXPECT (linuxStr->getShaping ().fontID == 1);
+		platformStr->setUTF8String ("Other");
+		EXPECT (std::string (linuxStr->data ()) == "Other");
+		EXPECT (linuxStr->getShaping ().fontID == 0);
+	);
+
 );
 #endif
 
@@ -0,0 +1,223 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../tools/imagestitcher/source/stitcher.h"
+#include "../../unittests.h"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace VSTGUI {
+namespace ImageStitcher {
+
+namespace {
+
+#define MINIZ_NO_STDIO
+#define MINIZ_NO_ARCHIVE_APIS
+#define MINIZ_NO_ARCHIVE_WRITING_APIS
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "../../../../uidescription/miniz/miniz.c"
+
+//------------------------------------------------------------------------
+struct TempFile
+{
+	TempFile ()
+	{
+		char tmpl[] = "/tmp/vstgui_stitcher_XXXXXX";
+		auto fd = mkstemp (tmpl);
+		if (fd != -1)
+		{
+			close (fd);
+			path = tmpl;
+		}
+	}
+	~TempFile ()
+	{
+		if (!path.empty ())
+			unlink (path.data ());
+	}
+
+	Path path;
+};
+
+//------------------------------------------------------------------------
+StripBuffer makeStrip (uint32_t width, uint32_t height)
+{
+	StripBuffer strip;
+	strip.width = width;
+	strip.height = strip.frameHeight = height;
+	strip.pixels.resize (static_cast<size_t> (strip.getBytesPerRow ()) * height);
+	// gradients compress well, the noise in the lower half makes the filters differ per row
+	uint32_t seed = 1;
+	for (size_t i = 0; i < strip.pixels.size (); ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		auto noise = i > strip.pixels.size () / 2 ? (seed >> 16) : 0;
+		strip.pixels[i] = static_cast<uint8_t> (i / 4 + (i % 4) * 64 + noise);
+	}
+	return strip;
+}
+
+//------------------------------------------------------------------------
+uint32_t loadBigEndian (const uint8_t* src)
+{
+	return (static_cast<uint32_t> (src[0]) << 24) | (static_cast<uint32_t> (src[1]) << 16) |
+		   (static_cast<uint32_t> (src[2]) << 8) | src[3];
+}
+
+//------------------------------------------------------------------------
+uint8_t paethPredictor (uint8_t a, uint8_t b, uint8_t c)
+{
+	auto p = a + b - c;
+	auto pa = std::abs (p - a);
+	auto pb = std::abs (p - b);
+	auto pc = std::abs (p - c);
+	if (pa <= pb && pa <= pc)
+		return a;
+	return pb <= pc ? b : c;
+}
+
+//------------------------------------------------------------------------
+/** decodes the 8 bit RGBA PNGs writePNG produces, checking the chunk CRCs and the adler32 */
+bool decodePNG (const Path& path, StripBuffer& strip)
+{
+	std::ifstream stream (path, std::ios::binary);
+	std::vector<uint8_t> data ((std::istreambuf_iterator<char> (stream)),
+							   std::istreambuf_iterator<char> ());
+	static constexpr uint8_t signature[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+	if (data.size () < 8 || memcmp (data.data (), signature, 8) != 0)
+		return false;
+
+	std::vector<uint8_t> zlibStream;
+	bool hasEnd = false;
+	size_t pos = 8;
+	while (!hasEnd && pos + 12 <= data.size ())
+	{
+		auto size = loadBigEndian (data.data () + pos);
+		if (pos + 12 + size > data.size ())
+			return false;
+		auto chunk = data.data () + pos + 4;
+		auto crc = mz_crc32 (MZ_CRC32_INIT, chunk, size + 4);
+		if (crc != loadBigEndian (chunk + 4 + size))
+			return false;
+		if (memcmp (chunk, "IHDR", 4) == 0)
+		{
+			if (size != 13 || chunk[12] != 8 || chunk[13] != 6)
+				return false;
+			strip.width = loadBigEndian (chunk + 4);
+			strip.height = strip.frameHeight = loadBigEndian (chunk + 8);
+		}
+		else if (memcmp (chunk, "IDAT", 4) == 0)
+			zlibStream.insert (zlibStream.end (), chunk + 4, chunk + 4 + size);
+		else if (memcmp (chunk, "IEND", 4) == 0)
+			hasEnd = true;
+		pos += 12 + size;
+	}
+	if (!hasEnd || pos != data.size ())
+		return false;
+
+	size_t filteredSize = 0;
+	auto filtered = static_cast<uint8_t*> (tinfl_decompress_mem_to_heap (
+		zlibStream.data (), zlibStream.size (), &filteredSize,
+		TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_COMPUTE_ADLER32));
+	if (!filtered)
+		return false;
+	auto bytesPerRow = strip.getBytesPerRow ();
+	bool result = filteredSize == (bytesPerRow + 1u) * strip.height;
+	strip.pixels.resize (static_cast<size_t> (bytesPerRow) * strip.height);
+	for (uint32_t y = 0; result && y < strip.height; ++y)
+	{
+		const auto* src = filtered + y * (bytesPerRow + 1u);
+		auto* row = strip.pixels.data () + y * bytesPerRow;
+		const auto* prior = y ? row - bytesPerRow : nullptr;
+		for (uint32_t x = 0; x < bytesPerRow; ++x)
+		{
+			uint8_t left = x >= 4 ? row[x - 4] : 0;
+			uint8_t up = prior ? prior[x] : 0;
+			uint8_t upLeft = prior && x >= 4 ? prior[x - 4] : 0;
+			switch (src[0])
+			{
+				case 0: row[x] = src[x + 1]; break;
+				case 1: row[x] = src[x + 1] + left; break;
+				case 2: row[x] = src[x + 1] + up; break;
+				case 3: row[x] = src[x + 1] + (left + up) / 2; break;
+				case 4: row[x] = src[x + 1] + paethPredictor (left, up, upLeft); break;
+				default: result = false; break;
+			}
+		}
+	}
+	mz_free (filtered);
+	return result;
+}
+
+//------------------------------------------------------------------------
+bool roundTrip (const StripBuffer& strip, uint32_t compressionLevel, uint32_t numThreads)
+{
+	TempFile file;
+	StripBuffer decoded;
+	return writePNG (strip, file.path, compressionLevel, numThreads) &&
+		   decodePNG (file.path, decoded) && decoded.width == strip.width &&
+		   decoded.height == strip.height && decoded.pixels == strip.pixels;
+}
+
+//------------------------------------------------------------------------
+/** 4 x 4 pixels with straight alpha, the platform decoders premultiply them */
+StripBuffer makeTranslucentFrame ()
+{
+	StripBuffer frame;
+	frame.width = frame.height = frame.frameHeight = 4;
+	const uint8_t alphas[] = {255, 200, 128, 0};
+	for (auto i = 0u; i < 16; ++i)
+	{
+		uint8_t alpha = alphas[i % 4];
+		uint8_t pixel[] = {200, 100, static_cast<uint8_t> (i * 16), alpha};
+		if (alpha == 0)
+			pixel[0] = pixel[1] = pixel[2] = 0;
+		frame.pixels.insert (frame.pixels.end (), pixel, pixel + 4);
+	}
+	return frame;
+}
+
+} // anonymous
+
+TESTCASE(ImageStitcherTest,
+
+	TEST(writePNGSingleBand,
+		EXPECT (roundTrip (makeStrip (7, 5), 6, 1));
+	);
+
+	TEST(writePNGJoinsBands,
+		// a filtered row is 4001 bytes, the 1 MB bands hold 262 rows
+		auto strip = makeStrip (1000, 600);
+		EXPECT (roundTrip (strip, 6, 1));
+		EXPECT (roundTrip (strip, 6, 4));
+		EXPECT (roundTrip (strip, 1, 3));
+	);
+
+	TEST(writePNGStoredBlocks,
+		EXPECT (roundTrip (makeStrip (1000, 300), 0, 2));
+	);
+
+	TEST(stitchImagesUsesStraightAlpha,
+		auto frame = makeTranslucentFrame ();
+		TempFile file;
+		EXPECT (writePNG (frame, file.path, 6, 1));
+		Document doc;
+		doc.imagePaths.assign (2, file.path);
+		doc.width = doc.height = 4;
+		StripBuffer strip;
+		EXPECT (stitchImages (doc, strip, 2));
+		EXPECT (strip.getNumFrames () == 2);
+		EXPECT (strip.pixels.size () == frame.pixels.size () * 2);
+		for (size_t i = 0; i < strip.pixels.size (); ++i)
+		{
+			auto expected = frame.pixels[i % frame.pixels.size ()];
+			EXPECT (std::abs (strip.pixels[i] - expected) <= 1);
+		}
+	);
+);
+
+} // ImageStitcher
+} // VSTGUI
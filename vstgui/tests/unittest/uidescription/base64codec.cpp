@@ -4,6 +4,8 @@
 
 #include "../unittests.h"
 #include "../../../uidescription/base64codec.h"
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 namespace VSTGUI {
@@ -69,6 +71,43 @@ TESTCASE(Base64CodecTest,
 		 EXPECT (ptr[4] == 0x0D);
 		 EXPECT (ptr[5] == 0x0A);
 	);
+
+	TEST(encodeShortInput,
+		 auto result = Base64Codec::encode ("A", 1);
+		 EXPECT (result.dataSize == 4);
+		 EXPECT (std::string (reinterpret_cast<const char*> (result.data.get ()), 4) == "QQ==");
+		 result = Base64Codec::encode ("AB", 2);
+		 EXPECT (result.dataSize == 4);
+		 EXPECT (std::string (reinterpret_cast<const char*> (result.data.get ()), 4) == "QUI=");
+	);
+
+	TEST(encoderChunksMatchSingleEncode,
+		 std::string binary;
+		 for (auto i = 0; i < 10000; ++i)
+			 binary.push_back (static_cast<char> (i * 7));
+		 auto expected = Base64Codec::encode (binary.data (), binary.size ());
+
+		 std::string streamed;
+		 auto writeProc = [&] (const uint8_t* data, size_t size) {
+			 streamed.append (reinterpret_cast<const char*> (data), size);
+		 };
+		 Base64Codec::Encoder encoder;
+		 size_t pos = 0;
+		 size_t chunkSize = 1;
+		 while (pos < binary.size ())
+		 {
+			 auto size = std::min (chunkSize++, binary.size () - pos);
+			 encoder.add (binary.data () + pos, size, writeProc);
+			 pos += size;
+		 }
+		 encoder.finish (writeProc);
+		 EXPECT (streamed.size () == expected.dataSize);
+		 EXPECT (streamed == std::string (reinterpret_cast<const char*> (expected.data.get ()),
+										  expected.dataSize));
+		 auto decoded = Base64Codec::decode (streamed);
+		 EXPECT (decoded.dataSize == binary.size ());
+		 EXPECT (memcmp (decoded.data.get (), binary.data (), binary.size ()) == 0);
+	);
 );
 
 }
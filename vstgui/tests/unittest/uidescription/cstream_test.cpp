@@ -4,6 +4,16 @@
 
 #include "../unittests.h"
 #include "../../../uidescription/cstream.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if WINDOWS
+#include <windows.h>
+#else
+#include <cstdlib>
+#include <unistd.h>
+#endif
 
 namespace VSTGUI {
 
@@ -133,7 +143,146 @@ TESTCASE(CMemoryStreamTests,
 		EXPECT(is >> str);
 		EXPECT(str == "Test");
 	);
-	
+
+	TEST(readWriteArrayLittleEndian,
+		CMemoryStream s;
+		s.OutputStream::setByteOrder (kLittleEndianByteOrder);
+		s.InputStream::setByteOrder (kLittleEndianByteOrder);
+		std::vector<int32_t> values (5000);
+		for (auto i = 0u; i < values.size (); ++i)
+			values[i] = static_cast<int32_t> (i) - 100;
+		EXPECT(s.write (values.data (), values.size ()));
+		s.rewind ();
+		int32_t first;
+		EXPECT(s >> first);
+		EXPECT(first == -100);
+		s.rewind ();
+		std::vector<int32_t> result (values.size ());
+		EXPECT(s.read (result.data (), result.size ()));
+		EXPECT(result == values);
+		EXPECT(s.read (result.data (), 1) == false);
+	);
+
+	TEST(readWriteArrayBigEndian,
+		CMemoryStream s;
+		s.OutputStream::setByteOrder (kBigEndianByteOrder);
+		s.InputStream::setByteOrder (kBigEndianByteOrder);
+		std::vector<double> values (3000);
+		for (auto i = 0u; i < values.size (); ++i)
+			values[i] = i * 0.5;
+		EXPECT(s.write (values.data (), values.size ()));
+		s.rewind ();
+		double first;
+		double second;
+		EXPECT(s >> first);
+		EXPECT(s >> second);
+		EXPECT(first == 0.);
+		EXPECT(second == 0.5);
+		s.rewind ();
+		std::vector<double> result (values.size ());
+		EXPECT(s.read (result.data (), result.size ()));
+		EXPECT(result == values);
+	);
+
+	TEST(growLargeBuffer,
+		CMemoryStream s (16, 16, false);
+		std::string line ("0123456789abcdef");
+		for (auto i = 0; i < 10000; ++i)
+			EXPECT(s << line);
+		EXPECT(s.tell () == 160000);
+		EXPECT(memcmp (s.getBuffer () + 159984, line.data (), line.size ()) == 0);
+	);
+);
+
+TESTCASE(BufferedOutputStreamTests,
+
+	TEST(smallAndLargeWrites,
+		CMemoryStream s (1024, 1024, false);
+		{
+			BufferedOutputStream bs (s, 16);
+			EXPECT(bs << std::string ("abc"));
+			EXPECT(s.tell () == 0);
+			std::string large (100, 'x');
+			EXPECT(bs.writeRaw (large.data (), 100) == 100);
+			EXPECT(s.tell () == 103);
+			EXPECT(bs << std::string ("def"));
+		}
+		EXPECT(s.tell () == 106);
+		std::string result (reinterpret_cast<const char*> (s.getBuffer ()), 106);
+		EXPECT(result == "abc" + std::string (100, 'x') + "def");
+	);
+
+	TEST(byteOrder,
+		CMemoryStream s;
+		s.OutputStream::setByteOrder (kBigEndianByteOrder);
+		BufferedOutputStream bs (s);
+		EXPECT(bs.getByteOrder () == kBigEndianByteOrder);
+	);
+);
+
+namespace {
+
+//------------------------------------------------------------------------
+/** creates an empty file with a unique name, unlike tmpnam this cannot race with other processes */
+std::string createTemporaryFile ()
+{
+#if WINDOWS
+	char directory[MAX_PATH];
+	char path[MAX_PATH];
+	if (GetTempPathA (MAX_PATH, directory) && GetTempFileNameA (directory, "vgs", 0, path))
+		return path;
+#else
+	char path[] = "/tmp/vstgui_cstream_XXXXXX";
+	auto fd = mkstemp (path);
+	if (fd != -1)
+	{
+		close (fd);
+		return path;
+	}
+#endif
+	return {};
+}
+
+} // anonymous
+
+TESTCASE(CFileStreamTests,
+
+	TEST(readMappedFile,
+		auto path = createTemporaryFile ();
+		EXPECT(!path.empty ());
+		{
+			CFileStream s;
+			EXPECT(s.open (path.data (), CFileStream::kWriteMode | CFileStream::kTruncateMode |
+											 CFileStream::kBinaryMode));
+			EXPECT(s << std::string ("first"));
+			EXPECT(s << std::string ("second"));
+			uint32_t values[3];
+			for (auto i = 0u; i < 3; ++i)
+				values[i] = i + 1;
+			EXPECT(s.write (values, 3));
+		}
+		{
+			CFileStream s;
+			EXPECT(s.open (path.data (), CFileStream::kReadMode | CFileStream::kBinaryMode));
+			std::string str;
+			EXPECT(s >> str);
+			EXPECT(str == "first");
+			EXPECT(s >> str);
+			EXPECT(str == "second");
+			EXPECT(s.tell () == 13);
+			uint32_t values[3];
+			EXPECT(s.read (values, 3));
+			EXPECT(values[0] == 1 && values[1] == 2 && values[2] == 3);
+			EXPECT(s.readRaw (values, 4) == 0);
+			EXPECT(s.seek (-4, CFileStream::kSeekEnd) == 21);
+			EXPECT(s >> values[0]);
+			EXPECT(values[0] == 3);
+			s.rewind ();
+			EXPECT(s >> str);
+			EXPECT(str == "first");
+		}
+		std::remove (path.data ());
+	);
 );
 
 } // VSTGUI
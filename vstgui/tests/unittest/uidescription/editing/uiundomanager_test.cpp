@@ -0,0 +1,160 @@
+// This file is part of VSTGUI. It is subject to the license terms 
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../unittests.h"
+#include "../../../../uidescription/editing/uiundomanager.h"
+
+#if VSTGUI_LIVE_EDITING
+
+#include "../../../../uidescription/editing/iaction.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class TestAction : public IAction
+{
+public:
+	TestAction (int& value, int delta, bool mergeable = false, size_t memoryUsage = 0)
+	: value (value), delta (delta), mergeable (mergeable), memoryUsage (memoryUsage)
+	{
+	}
+
+	UTF8StringPtr getName () override { return "Test"; }
+	void perform () override { value += delta; }
+	void undo () override { value -= delta; }
+	size_t getMemoryUsage () const override { return memoryUsage; }
+	bool merge (IAction* nextAction) override
+	{
+		auto next = dynamic_cast<TestAction*> (nextAction);
+		if (!mergeable || !next || !next->mergeable)
+			return false;
+		delta += next->delta;
+		return true;
+	}
+
+private:
+	int& value;
+	int delta;
+	bool mergeable;
+	size_t memoryUsage;
+};
+
+} // anonymous
+
+TESTCASE(UIUndoManagerTest,
+
+	TEST(historyLimitedByCount,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		undoManager->setHistoryLimits (3, 0);
+		for (auto i = 0; i < 5; ++i)
+			undoManager->pushAndPerform (new TestAction (value, 1));
+		EXPECT(value == 5);
+		EXPECT(undoManager->getNumActions () == 3);
+		while (undoManager->canUndo ())
+			undoManager->performUndo ();
+		EXPECT(value == 2);
+		undoManager->performRedo ();
+		EXPECT(value == 3);
+	);
+
+	TEST(historyLimitedByMemory,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		undoManager->setHistoryLimits (0, 250);
+		for (auto i = 0; i < 4; ++i)
+			undoManager->pushAndPerform (new TestAction (value, 1, false, 100));
+		EXPECT(undoManager->getNumActions () == 2);
+		EXPECT(undoManager->getMemoryUsage () == 200);
+	);
+
+	TEST(reducingLimitsKeepsRedoableActions,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		for (auto i = 0; i < 4; ++i)
+			undoManager->pushAndPerform (new TestAction (value, 1));
+		undoManager->performUndo ();
+		undoManager->performUndo ();
+		undoManager->setHistoryLimits (1, 0);
+		EXPECT(undoManager->getNumActions () == 2);
+		EXPECT(undoManager->canUndo () == false);
+		EXPECT(undoManager->canRedo ());
+		undoManager->performRedo ();
+		undoManager->performRedo ();
+		EXPECT(value == 4);
+	);
+
+	TEST(trimmedSavePosition,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		undoManager->setHistoryLimits (2, 0);
+		undoManager->pushAndPerform (new TestAction (value, 1));
+		undoManager->markSavePosition ();
+		undoManager->pushAndPerform (new TestAction (value, 1));
+		undoManager->pushAndPerform (new TestAction (value, 1));
+		undoManager->performUndo ();
+		undoManager->performUndo ();
+		EXPECT(undoManager->isSavePosition ());
+		EXPECT(value == 1);
+		undoManager->pushAndPerform (new TestAction (value, 1));
+		undoManager->pushAndPerform (new TestAction (value, 1));
+		undoManager->pushAndPerform (new TestAction (value, 1));
+		while (undoManager->canUndo ())
+			undoManager->performUndo ();
+		EXPECT(undoManager->isSavePosition () == false);
+	);
+
+	TEST(mergeConsecutiveActions,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		undoManager->setMergeInterval (60000);
+		undoManager->pushAndPerform (new TestAction (value, 1, true));
+		undoManager->pushAndPerform (new TestAction (value, 2, true));
+		undoManager->pushAndPerform (new TestAction (value, 3, true));
+		EXPECT(value == 6);
+		EXPECT(undoManager->getNumActions () == 1);
+		undoManager->performUndo ();
+		EXPECT(value == 0);
+		undoManager->performRedo ();
+		EXPECT(value == 6);
+	);
+
+	TEST(noMergeWhenDisabled,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		undoManager->setMergeInterval (0);
+		undoManager->pushAndPerform (new TestAction (value, 1, true));
+		undoManager->pushAndPerform (new TestAction (value, 1, true));
+		EXPECT(undoManager->getNumActions () == 2);
+	);
+
+	TEST(noMergeIntoSavePosition,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		undoManager->setMergeInterval (60000);
+		undoManager->pushAndPerform (new TestAction (value, 1, true));
+		undoManager->markSavePosition ();
+		undoManager->pushAndPerform (new TestAction (value, 1, true));
+		EXPECT(undoManager->getNumActions () == 2);
+		EXPECT(undoManager->isSavePosition () == false);
+	);
+
+	TEST(noMergeAfterUndo,
+		int value = 0;
+		auto undoManager = makeOwned<UIUndoManager> ();
+		undoManager->setMergeInterval (60000);
+		undoManager->pushAndPerform (new TestAction (value, 1));
+		undoManager->pushAndPerform (new TestAction (value, 1, true));
+		undoManager->performUndo ();
+		undoManager->pushAndPerform (new TestAction (value, 5, true));
+		EXPECT(value == 6);
+		EXPECT(undoManager->getNumActions () == 2);
+	);
+);
+
+} // VSTGUI
+
+#endif // VSTGUI_LIVE_EDITING
@@ -5,13 +5,37 @@
 #include "../unittests.h"
 #include "../../../uidescription/uiattributes.h"
 #include "../../../uidescription/cstream.h"
+#include "../../../uidescription/uiviewcreator.h"
+#include "uidescriptionadapter.h"
 #include "../../../lib/cpoint.h"
 #include "../../../lib/crect.h"
+#include "../../../lib/ccolor.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace VSTGUI {
 
 static UTF8StringPtr attributes [] = {"K1", "V1", "K2", "V2", nullptr};
 
+namespace {
+
+//-----------------------------------------------------------------------------
+/** defines a named color spelled like a literal */
+class HexNamedColorDescription : public UIDescriptionAdapter
+{
+public:
+	bool getColor (UTF8StringPtr name, CColor& color) const override
+	{
+		if (UTF8StringView (name) != "#000000")
+			return false;
+		color = kRedCColor;
+		return true;
+	}
+};
+
+} // anonymous
+
 TESTCASE(UIAttributesTest,
 
 	TEST(arrayConstructor,
@@ -84,6 +108,120 @@ TESTCASE(UIAttributesTest,
 		EXPECT(value == CRect (10, 20, 30, 40));
 	);
 
+	TEST(parseNumbersFromStrings,
+		UIAttributes a;
+		a.setAttribute ("Double", " -1.5e2 ");
+		a.setAttribute ("Point", "1.5, -2");
+		a.setAttribute ("Rect", "0,1 , 2.25,3");
+		double d = 0.;
+		EXPECT(a.getDoubleAttribute ("Double", d));
+		EXPECT(d == -150.);
+		CPoint p;
+		EXPECT(a.getPointAttribute ("Point", p));
+		EXPECT(p == CPoint (1.5, -2));
+		CRect r;
+		EXPECT(a.getRectAttribute ("Rect", r));
+		EXPECT(r == CRect (0, 1, 2.25, 3));
+	);
+
+	TEST(wrongNumberOfComponents,
+		UIAttributes a;
+		a.setAttribute ("Key", "1, 2, 3");
+		CPoint p;
+		CRect r;
+		EXPECT(a.getPointAttribute ("Key", p) == false);
+		EXPECT(a.getRectAttribute ("Key", r) == false);
+		a.setAttribute ("Key", "1, 2, 3, 4, 5");
+		EXPECT(a.getRectAttribute ("Key", r) == false);
+	);
+
+	TEST(colorAttribute,
+		UIAttributes a;
+		CColor c;
+		EXPECT(a.getColorAttribute ("Key", c) == false);
+		a.setAttribute ("Key", "#ff8000");
+		EXPECT(a.getColorAttribute ("Key", c));
+		EXPECT(c == CColor (255, 128, 0, 255));
+		a.setAttribute ("Key", "#0A0b0C80");
+		EXPECT(a.getColorAttribute ("Key", c));
+		EXPECT(c == CColor (10, 11, 12, 128));
+		a.setAttribute ("Key", "red");
+		EXPECT(a.getColorAttribute ("Key", c) == false);
+		a.setAttribute ("Key", "#ff80zz");
+		EXPECT(a.getColorAttribute ("Key", c) == false);
+	);
+
+	TEST(namedColorBeforeLiteral,
+		UIAttributes a;
+		a.setAttribute ("Named", "#000000");
+		a.setAttribute ("Literal", "#0000ff");
+		HexNamedColorDescription desc;
+		CColor c;
+		EXPECT(UIViewCreator::getColorAttribute (a, "Named", c, &desc));
+		EXPECT(c == kRedCColor);
+		EXPECT(UIViewCreator::getColorAttribute (a, "Literal", c, &desc));
+		EXPECT(c == kBlueCColor);
+	);
+
+	TEST(copyKeepsTypedValue,
+		UIAttributes a;
+		a.setAttribute ("Key", "1, 2");
+		CPoint p;
+		EXPECT(a.getPointAttribute ("Key", p));
+		UIAttributes b (a);
+		EXPECT(b.getPointAttribute ("Key", p));
+		EXPECT(p == CPoint (1, 2));
+		b.setAttribute ("Key", "3, 4");
+		EXPECT(b.getPointAttribute ("Key", p));
+		EXPECT(p == CPoint (3, 4));
+		EXPECT(a.getPointAttribute ("Key", p));
+		EXPECT(p == CPoint (1, 2));
+	);
+
+	TEST(concurrentTypedQueries,
+		UIAttributes a;
+		a.setAttribute ("Key", "10, 20, 30, 40");
+		std::atomic<uint32_t> numFailed {0};
+		std::vector<std::thread> threads;
+		for (auto i = 0; i < 4; ++i)
+		{
+			threads.emplace_back ([&] () {
+				for (auto j = 0; j < 1000; ++j)
+				{
+					CRect r;
+					CPoint p;
+					if (!a.getRectAttribute ("Key", r) || r != CRect (10, 20, 30, 40))
+						++numFailed;
+					if (a.getPointAttribute ("Key", p))
+						++numFailed;
+				}
+			});
+		}
+		for (auto& thread : threads)
+			thread.join ();
+		EXPECT(numFailed == 0);
+	);
+
+	TEST(typedValueFollowsStringChanges,
+		UIAttributes a;
+		a.setAttribute ("Key", "1, 2");
+		CPoint p;
+		EXPECT(a.getPointAttribute ("Key", p));
+		EXPECT(p == CPoint (1, 2));
+		a.setAttribute ("Key", "3, 4");
+		EXPECT(a.getPointAttribute ("Key", p));
+		EXPECT(p == CPoint (3, 4));
+		double d;
+		EXPECT(a.getDoubleAttribute ("Key", d));
+		EXPECT(d == 3.);
+		bool b;
+		EXPECT(a.getBooleanAttribute ("Key", b) == false);
+		a.setBooleanAttribute ("Key", true);
+		EXPECT(a.getBooleanAttribute ("Key", b));
+		EXPECT(b == true);
+		EXPECT(*a.getAttributeValue ("Key") == "true");
+	);
+
 	TEST(stringArrayAttribute,
 		UIAttributes a;
 		UIAttributes::StringArray array;
@@ -5,6 +5,7 @@
 #include "../unittests.h"
 #include "../../../uidescription/uidescription.h"
 #include "../../../uidescription/uiattributes.h"
+#include "../../../uidescription/uiviewcreator.h"
 #include "../../../uidescription/icontroller.h"
 #include "../../../uidescription/xmlparser.h"
 #include "../../../uidescription/detail/uiviewcreatorattributes.h"
@@ -34,6 +35,22 @@ constexpr auto colorNodesUIDesc = R"(
 </vstgui-ui-description>
 )";
 
+constexpr auto hexNamedColorNodesUIDesc = R"(
+<vstgui-ui-description version="1">
+	<colors>
+		<color name="#000000" rgba="#ff0000ff"/>
+	</colors>
+</vstgui-ui-description>
+)";
+
+constexpr auto customNodesUIDesc = R"(
+<vstgui-ui-description version="1">
+	<custom>
+		<attributes name="VST3Editor" Path="/path/to/file.uidesc"/>
+	</custom>
+</vstgui-ui-description>
+)";
+
 constexpr auto fontNodesUIDesc = R"(
 <vstgui-ui-description version="1">
 	<fonts>
@@ -187,6 +204,41 @@ constexpr auto restoreViewUIDesc = R"(
 </vstgui-ui-description>
 )";
 
+//------------------------------------------------------------------------
+std::string createManyViewsUIDesc (uint32_t numViews)
+{
+	std::string desc = R"(
+<vstgui-ui-description version="1">
+	<template class="CViewContainer" name="sub" origin="0, 0" size="10, 10">
+		<view class="CView" origin="1, 1" size="5, 5" transparent="true"/>
+	</template>
+	<template class="CViewContainer" name="view" origin="0, 0" size="1000, 1000">
+)";
+	for (uint32_t i = 0; i < numViews; ++i)
+	{
+		auto pos = std::to_string (i);
+		if (i % 10 == 0)
+			desc += "\t\t<view template=\"sub\" origin=\"" + pos + ", " + pos + "\"/>\n";
+		else
+			desc += "\t\t<view class=\"CView\" origin=\"" + pos + ", " + pos +
+			        "\" size=\"2, 3\" transparent=\"true\"/>\n";
+	}
+	desc += "\t</template>\n</vstgui-ui-description>\n";
+	return desc;
+}
+
+//------------------------------------------------------------------------
+struct VerifyOrderController : public Controller
+{
+	std::vector<CView*> verifiedViews;
+
+	CView* verifyView (CView* view, const UIAttributes& attributes, const IUIDescription* description) override
+	{
+		verifiedViews.emplace_back (view);
+		return view;
+	}
+};
+
 #if 0
 constexpr auto completeExample = R"(
 <vstgui-ui-description version="1">
@@ -332,6 +384,30 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(desc.getColor ("new color", c) == false);
 	);
 
+	TEST(colorAttributeLiteralsAndNames,
+		Xml::MemoryContentProvider provider (hexNamedColorNodesUIDesc, static_cast<uint32_t> (strlen(hexNamedColorNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		UIAttributes a;
+		a.setAttribute ("Named", "#000000");
+		a.setAttribute ("Literal", "#0000ff");
+		CColor c;
+		for (auto i = 0; i < 2; ++i)
+		{
+			EXPECT(UIViewCreator::getColorAttribute (a, "Named", c, &desc));
+			EXPECT(c == kRedCColor);
+			EXPECT(UIViewCreator::getColorAttribute (a, "Literal", c, &desc));
+			EXPECT(c == kBlueCColor);
+		}
+		// the literal is cached now, a color named like it must still take precedence
+		desc.changeColor ("#0000ff", kGreenCColor);
+		EXPECT(UIViewCreator::getColorAttribute (a, "Literal", c, &desc));
+		EXPECT(c == kGreenCColor);
+		desc.removeColor ("#0000ff");
+		EXPECT(UIViewCreator::getColorAttribute (a, "Literal", c, &desc));
+		EXPECT(c == kBlueCColor);
+	);
+
 	TEST(fonts,
 		Xml::MemoryContentProvider provider (fontNodesUIDesc, static_cast<uint32_t> (strlen(fontNodesUIDesc)));
 		UIDescription desc (&provider);
@@ -628,6 +704,40 @@ TESTCASE(UIDescriptionTests,
 		 EXPECT(*names.back () == std::string ("addNewTemplate"));
 	);
 	
+	TEST(createManyViews,
+		auto uiDesc = createManyViewsUIDesc (300);
+		Xml::MemoryContentProvider provider (uiDesc.data (), static_cast<uint32_t> (uiDesc.size ()));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+
+		VerifyOrderController controller;
+		auto view = owned (desc.createView ("view", &controller));
+		EXPECT(view);
+		auto container = view.cast<CViewContainer> ();
+		EXPECT(container->getNbViews () == 300);
+		for (uint32_t i = 0; i < 300; ++i)
+		{
+			auto child = container->getView (i);
+			EXPECT(child->getViewSize ().getTopLeft () == CPoint (i, i));
+			if (i % 10 == 0)
+			{
+				EXPECT(child->getViewSize ().getSize () == CPoint (10, 10));
+				EXPECT(child->asViewContainer ()->getNbViews () == 1);
+			}
+			else
+			{
+				EXPECT(child->getViewSize ().getSize () == CPoint (2, 3));
+				EXPECT(child->getTransparency ());
+			}
+		}
+		// children are verified before their parent in document order
+		EXPECT(controller.verifiedViews.size () == 300 + 30 + 1);
+		EXPECT(controller.verifiedViews.back () == view);
+		EXPECT(controller.verifiedViews[0] == container->getView (0)->asViewContainer ()->getView (0));
+		EXPECT(controller.verifiedViews[1] == container->getView (0));
+		EXPECT(controller.verifiedViews[2] == container->getView (1));
+	);
+
 	TEST(storeRestoreViews,
 		Xml::MemoryContentProvider provider (createViewUIDesc, static_cast<uint32_t> (strlen(createViewUIDesc)));
 		UIDescription desc (&provider);
@@ -705,6 +815,81 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(desc.setCustomAttributes("Test", nullptr) == false);
 	);
 
+	TEST(shareParsedTree,
+		Xml::MemoryContentProvider provider1 (fontNodesUIDesc, static_cast<uint32_t> (strlen(fontNodesUIDesc)));
+		Xml::MemoryContentProvider provider2 (fontNodesUIDesc, static_cast<uint32_t> (strlen(fontNodesUIDesc)));
+		UIDescription desc1 (&provider1);
+		UIDescription desc2 (&provider2);
+		EXPECT(desc1.parse () == true);
+		EXPECT(desc2.parse () == true);
+		EXPECT(desc1.getFont ("f1"));
+		EXPECT(desc1.getFont ("f1") == desc2.getFont ("f1"));
+	);
+
+	TEST(differentContentIsNotShared,
+		Xml::MemoryContentProvider provider1 (fontNodesUIDesc, static_cast<uint32_t> (strlen(fontNodesUIDesc)));
+		std::string otherContent (fontNodesUIDesc);
+		otherContent += " ";
+		Xml::MemoryContentProvider provider2 (otherContent.data (), static_cast<uint32_t> (otherContent.size ()));
+		UIDescription desc1 (&provider1);
+		UIDescription desc2 (&provider2);
+		EXPECT(desc1.parse () == true);
+		EXPECT(desc2.parse () == true);
+		EXPECT(desc1.getFont ("f1") != desc2.getFont ("f1"));
+	);
+
+	TEST(copyOnWriteCustomAttributes,
+		Xml::MemoryContentProvider provider1 (customNodesUIDesc, static_cast<uint32_t> (strlen(customNodesUIDesc)));
+		Xml::MemoryContentProvider provider2 (customNodesUIDesc, static_cast<uint32_t> (strlen(customNodesUIDesc)));
+		UIDescription desc1 (&provider1);
+		UIDescription desc2 (&provider2);
+		EXPECT(desc1.parse () == true);
+		EXPECT(desc2.parse () == true);
+		auto attr2 = desc2.getCustomAttributes ("VST3Editor", true);
+		EXPECT(attr2);
+		attr2->removeAttribute ("Path");
+		auto attr1 = desc1.getCustomAttributes ("VST3Editor");
+		EXPECT(attr1);
+		EXPECT(attr1 != attr2);
+		auto path = attr1->getAttributeValue ("Path");
+		EXPECT(path);
+		EXPECT(*path == "/path/to/file.uidesc");
+		EXPECT(desc2.getCustomAttributes ("VST3Editor")->hasAttribute ("Path") == false);
+	);
+
+	TEST(copyOnWrite,
+		Xml::MemoryContentProvider provider1 (colorNodesUIDesc, static_cast<uint32_t> (strlen(colorNodesUIDesc)));
+		Xml::MemoryContentProvider provider2 (colorNodesUIDesc, static_cast<uint32_t> (strlen(colorNodesUIDesc)));
+		UIDescription desc1 (&provider1);
+		UIDescription desc2 (&provider2);
+		EXPECT(desc1.parse () == true);
+		EXPECT(desc2.parse () == true);
+		desc2.changeColor ("c1", kRedCColor);
+		desc2.removeColor ("c2");
+		CColor c;
+		EXPECT(desc1.getColor ("c1", c));
+		EXPECT(c == CColor (0, 0, 0, 255));
+		EXPECT(desc1.hasColorName ("c2"));
+		EXPECT(desc2.getColor ("c1", c));
+		EXPECT(c == kRedCColor);
+		EXPECT(desc2.hasColorName ("c2") == false);
+		EXPECT(desc2.hasColorName ("c3"));
+	);
+
+	TEST(lastUserKeepsTreeOnModification,
+		Xml::MemoryContentProvider provider1 (fontNodesUIDesc, static_cast<uint32_t> (strlen(fontNodesUIDesc)));
+		Xml::MemoryContentProvider provider2 (fontNodesUIDesc, static_cast<uint32_t> (strlen(fontNodesUIDesc)));
+		auto desc1 = makeOwned<UIDescription> (&provider1);
+		EXPECT(desc1->parse () == true);
+		auto font = desc1->getFont ("f1");
+		desc1->changeFontName ("f1", "renamed");
+		EXPECT(desc1->getFont ("renamed") == font);
+		UIDescription desc2 (&provider2);
+		EXPECT(desc2.parse () == true);
+		EXPECT(desc2.hasFontName ("f1"));
+		EXPECT(desc2.hasFontName ("renamed") == false);
+	);
+
 );
 
 #if 0
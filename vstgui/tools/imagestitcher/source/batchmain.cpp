@@ -0,0 +1,135 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "document.h"
+#include "stitcher.h"
+#include "vstgui/lib/cstring.h"
+#include <cstdio>
+#include <string>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+namespace VSTGUI { void* gBundleRef = CFBundleGetMainBundle (); }
+#elif WINDOWS
+#include <windows.h>
+void* hInstance = nullptr;
+#elif LINUX
+namespace VSTGUI { void* soHandle = nullptr; }
+#endif
+
+using namespace VSTGUI;
+using namespace VSTGUI::ImageStitcher;
+
+//------------------------------------------------------------------------
+void printUsageAndTerminate (const char* msg)
+{
+	if (msg)
+		printf ("%s\n", msg);
+	printf ("usage: imagestitcher_batch [options] input...\n"
+	        "  input       .imagestitch document or text file with one image path per line\n"
+	        "  -o <dir>    output directory, defaults to the directory of each input\n"
+	        "  -j <n>      number of threads, defaults to the number of hardware threads\n"
+	        "  -c <level>  PNG compression level from 0 to 10, defaults to 6\n"
+	        "  --raw       write the uncompressed memory mappable format instead of PNG\n");
+	exit (-1);
+}
+
+//------------------------------------------------------------------------
+Path makeOutputPath (const Path& inputPath, const Path& outputDir, bool raw)
+{
+	auto separatorPos = inputPath.find_last_of (PathSeparator);
+	auto nameStart = separatorPos == Path::npos ? 0 : separatorPos + 1;
+	auto name = inputPath.substr (nameStart);
+	auto extensionPos = name.find_last_of ('.');
+	if (extensionPos != Path::npos && extensionPos != 0)
+		name.erase (extensionPos);
+	name += raw ? ".raw" : ".png";
+	if (outputDir.empty ())
+		return inputPath.substr (0, nameStart) + name;
+	auto result = outputDir;
+	if (result.back () != PathSeparator[0])
+		result += PathSeparator;
+	return result + name;
+}
+
+//------------------------------------------------------------------------
+int main (int argv, char* argc[])
+{
+#if WINDOWS
+	CoInitialize (nullptr);
+#endif
+	PathList inputPaths;
+	Path outputDir;
+	uint32_t numThreads = 0;
+	uint32_t compressionLevel = 6;
+	bool raw = false;
+	for (auto i = 1; i < argv; ++i)
+	{
+		UTF8StringView arg (argc[i]);
+		if (arg == "-o")
+		{
+			if (++i >= argv)
+				printUsageAndTerminate ("Missing output directory!");
+			outputDir = argc[i];
+		}
+		else if (arg == "-j")
+		{
+			if (++i >= argv)
+				printUsageAndTerminate ("Missing number of threads!");
+			numThreads = static_cast<uint32_t> (UTF8StringView (argc[i]).toInteger ());
+		}
+		else if (arg == "-c")
+		{
+			if (++i >= argv)
+				printUsageAndTerminate ("Missing compression level!");
+			compressionLevel = static_cast<uint32_t> (UTF8StringView (argc[i]).toInteger ());
+		}
+		else if (arg == "--raw")
+		{
+			raw = true;
+		}
+		else
+		{
+			inputPaths.emplace_back (argc[i]);
+		}
+	}
+	if (inputPaths.empty ())
+		printUsageAndTerminate ("No input specified!");
+
+	// the inputs are processed one after the other, each one uses all threads
+	int result = 0;
+	StripBuffer strip;
+	for (auto& inputPath : inputPaths)
+	{
+		UTF8StringView path (inputPath.data ());
+		auto docContext = path.endsWith (".imagestitch") ?
+		                      DocumentContext::loadDocument (inputPath) :
+		                      DocumentContext::loadImageList (inputPath);
+		if (!docContext)
+		{
+			printf ("Loading %s failed!\n", inputPath.data ());
+			result = -1;
+			continue;
+		}
+		if (!stitchImages (*docContext->getDocument (), strip, numThreads))
+		{
+			printf ("Decoding the images of %s failed!\n", inputPath.data ());
+			result = -1;
+			continue;
+		}
+		auto outputPath = makeOutputPath (inputPath, outputDir, raw);
+		auto written = raw ? writeRaw (strip, outputPath) :
+		                     writePNG (strip, outputPath, compressionLevel, numThreads);
+		if (!written)
+		{
+			printf ("Writing %s failed!\n", outputPath.data ());
+			result = -1;
+			continue;
+		}
+		printf ("Stitched %u images of %s to %s\n", strip.getNumFrames (), inputPath.data (),
+		        outputPath.data ());
+	}
+	return result;
+}
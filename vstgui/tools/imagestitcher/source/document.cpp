@@ -5,6 +5,7 @@
 #include "document.h"
 #include "vstgui/lib/cpoint.h"
 #include "vstgui/uidescription/cstream.h"
+#include <fstream>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -114,6 +115,38 @@ DocumentContextPtr DocumentContext::loadDocument (const Path& path)
 	return docContext;
 }
 
+//------------------------------------------------------------------------
+DocumentContextPtr DocumentContext::loadImageList (const Path& path)
+{
+	// a list without directory is relative to the working directory
+	auto rootPath = getDirectoryName (path);
+
+	std::ifstream stream (path);
+	if (!stream)
+		return nullptr;
+
+	auto doc = std::make_shared<Document> ();
+	doc->path = path;
+	auto docContext = std::make_shared<DocumentContext> (doc);
+
+	Path line;
+	while (std::getline (stream, line))
+	{
+		if (!line.empty () && line.back () == '\r')
+			line.pop_back ();
+		if (line.empty () || line[0] == '#')
+			continue;
+		Path fullPath;
+		if (rootPath && !pathIsAbsolute (line))
+			fullPath += *rootPath;
+		fullPath += line;
+		if (docContext->insertImagePathAtIndex (doc->imagePaths.size (), fullPath) !=
+		    Result::Success)
+			return nullptr;
+	}
+	return docContext;
+}
+
 //------------------------------------------------------------------------
 bool DocumentContext::save ()
 {
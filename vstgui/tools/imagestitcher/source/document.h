@@ -64,6 +64,8 @@ struct DocumentContext
 
 	static DocumentContextPtr makeEmptyDocument ();
 	static DocumentContextPtr loadDocument (const Path& path);
+	/** text file with one image path per line, relative paths are relative to the file */
+	static DocumentContextPtr loadImageList (const Path& path);
 
 	DocumentContext (const DocumentPtr& doc);
 
@@ -0,0 +1,413 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "stitcher.h"
+#include "vstgui/lib/cpoint.h"
+#include "vstgui/lib/platform/iplatformbitmap.h"
+#include "vstgui/uidescription/cstream.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if WINDOWS
+#include <objbase.h>
+#endif
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace ImageStitcher {
+namespace {
+
+// the miniz copy of the uidescription library is private to it, so compile our own
+#define MINIZ_NO_STDIO
+#define MINIZ_NO_ARCHIVE_APIS
+#define MINIZ_NO_ARCHIVE_WRITING_APIS
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "vstgui/uidescription/miniz/miniz.c"
+
+//------------------------------------------------------------------------
+uint32_t resolveNumThreads (uint32_t numThreads)
+{
+	if (numThreads == 0)
+		numThreads = std::thread::hardware_concurrency ();
+	return std::max (numThreads, 1u);
+}
+
+//------------------------------------------------------------------------
+/** calls proc for every index in [0, count) on up to numThreads threads, including the caller */
+template <typename Proc>
+void parallelFor (size_t count, uint32_t numThreads, Proc proc)
+{
+	auto threadCount = std::min<size_t> (resolveNumThreads (numThreads), count);
+	if (threadCount <= 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+			proc (index);
+		return;
+	}
+	std::atomic<size_t> next {0};
+	auto worker = [&] () {
+		for (auto index = next++; index < count; index = next++)
+			proc (index);
+	};
+	std::vector<std::thread> threads;
+	threads.reserve (threadCount - 1);
+	for (size_t i = 1; i < threadCount; ++i)
+		threads.emplace_back (worker);
+	worker ();
+	for (auto& thread : threads)
+		thread.join ();
+}
+
+#if WINDOWS
+//------------------------------------------------------------------------
+/** the image decoder needs COM on the worker threads */
+struct COMScope
+{
+	COMScope () : result (CoInitializeEx (nullptr, COINIT_MULTITHREADED)) {}
+	~COMScope () noexcept
+	{
+		if (SUCCEEDED (result))
+			CoUninitialize ();
+	}
+	HRESULT result;
+};
+#endif
+
+//------------------------------------------------------------------------
+#if LINUX
+/** the cairo bitmap ignores the alphaPremultiplied flag of lockPixels */
+static constexpr bool lockedPixelsArePremultiplied = true;
+#else
+static constexpr bool lockedPixelsArePremultiplied = false;
+#endif
+
+//------------------------------------------------------------------------
+inline uint8_t unpremultiply (uint8_t value, uint8_t alpha)
+{
+	if (alpha == 255)
+		return value;
+	if (alpha == 0)
+		return 0;
+	return static_cast<uint8_t> (std::min (255u, (value * 255u + alpha / 2u) / alpha));
+}
+
+//------------------------------------------------------------------------
+bool copyFrame (const Path& path, StripBuffer& strip, size_t frameIndex)
+{
+#if WINDOWS
+	COMScope comScope;
+#endif
+	auto bitmap = IPlatformBitmap::createFromPath (path.data ());
+	if (!bitmap)
+		return false;
+	const auto& size = bitmap->getSize ();
+	if (static_cast<uint32_t> (size.x) != strip.width ||
+	    static_cast<uint32_t> (size.y) != strip.frameHeight)
+		return false;
+	auto pixelAccess = bitmap->lockPixels (false);
+	if (!pixelAccess)
+		return false;
+
+	uint32_t r, g, b, a;
+	switch (pixelAccess->getPixelFormat ())
+	{
+		case IPlatformBitmapPixelAccess::kARGB: a = 0; r = 1; g = 2; b = 3; break;
+		case IPlatformBitmapPixelAccess::kRGBA: r = 0; g = 1; b = 2; a = 3; break;
+		case IPlatformBitmapPixelAccess::kABGR: a = 0; b = 1; g = 2; r = 3; break;
+		case IPlatformBitmapPixelAccess::kBGRA: b = 0; g = 1; r = 2; a = 3; break;
+		default: return false;
+	}
+
+	auto bytesPerRow = strip.getBytesPerRow ();
+	auto srcBytesPerRow = pixelAccess->getBytesPerRow ();
+	const auto* src = pixelAccess->getAddress ();
+	auto* dst = strip.pixels.data () + frameIndex * strip.frameHeight * bytesPerRow;
+	for (uint32_t y = 0; y < strip.frameHeight; ++y, src += srcBytesPerRow, dst += bytesPerRow)
+	{
+		if (lockedPixelsArePremultiplied)
+		{
+			for (uint32_t x = 0; x < bytesPerRow; x += 4)
+			{
+				auto alpha = src[x + a];
+				dst[x] = unpremultiply (src[x + r], alpha);
+				dst[x + 1] = unpremultiply (src[x + g], alpha);
+				dst[x + 2] = unpremultiply (src[x + b], alpha);
+				dst[x + 3] = alpha;
+			}
+			continue;
+		}
+		if (r == 0 && g == 1)
+		{
+			memcpy (dst, src, bytesPerRow);
+			continue;
+		}
+		for (uint32_t x = 0; x < bytesPerRow; x += 4)
+		{
+			dst[x] = src[x + r];
+			dst[x + 1] = src[x + g];
+			dst[x + 2] = src[x + b];
+			dst[x + 3] = src[x + a];
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool writeAll (CFileStream& stream, const uint8_t* data, size_t size)
+{
+	static constexpr size_t maxChunkSize = 1u << 30;
+	while (size)
+	{
+		auto chunkSize = static_cast<uint32_t> (std::min (size, maxChunkSize));
+		if (stream.writeRaw (data, chunkSize) != chunkSize)
+			return false;
+		data += chunkSize;
+		size -= chunkSize;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+inline uint32_t filterCost (uint8_t value)
+{
+	return value < 128 ? value : 256u - value;
+}
+
+//------------------------------------------------------------------------
+inline uint8_t paethPredictor (uint8_t a, uint8_t b, uint8_t c)
+{
+	auto p = a + b - c;
+	auto pa = std::abs (p - a);
+	auto pb = std::abs (p - b);
+	auto pc = std::abs (p - c);
+	if (pa <= pb && pa <= pc)
+		return a;
+	if (pb <= pc)
+		return b;
+	return c;
+}
+
+//------------------------------------------------------------------------
+/** writes the filter type followed by the filtered row, choosing the filter with the smallest
+ *	sum of absolute differences like libpng does */
+void filterRow (const uint8_t* row, const uint8_t* prior, uint32_t bytesPerRow, uint8_t* out)
+{
+	enum Filter : uint8_t { None = 0, Sub = 1, Up = 2, Paeth = 4 };
+	static constexpr uint32_t bpp = 4;
+
+	auto predict = [&] (uint32_t i, uint8_t& a, uint8_t& b, uint8_t& c) {
+		a = i >= bpp ? row[i - bpp] : 0;
+		b = prior ? prior[i] : 0;
+		c = (prior && i >= bpp) ? prior[i - bpp] : 0;
+	};
+
+	uint32_t costNone = 0, costSub = 0, costUp = 0, costPaeth = 0;
+	for (uint32_t i = 0; i < bytesPerRow; ++i)
+	{
+		uint8_t a, b, c;
+		predict (i, a, b, c);
+		costNone += filterCost (row[i]);
+		costSub += filterCost (static_cast<uint8_t> (row[i] - a));
+		costUp += filterCost (static_cast<uint8_t> (row[i] - b));
+		costPaeth += filterCost (static_cast<uint8_t> (row[i] - paethPredictor (a, b, c)));
+	}
+	auto filter = None;
+	auto cost = costNone;
+	if (costSub < cost)
+	{
+		filter = Sub;
+		cost = costSub;
+	}
+	if (costUp < cost)
+	{
+		filter = Up;
+		cost = costUp;
+	}
+	if (costPaeth < cost)
+		filter = Paeth;
+
+	*out++ = filter;
+	for (uint32_t i = 0; i < bytesPerRow; ++i)
+	{
+		uint8_t a, b, c;
+		predict (i, a, b, c);
+		switch (filter)
+		{
+			case None: out[i] = row[i]; break;
+			case Sub: out[i] = static_cast<uint8_t> (row[i] - a); break;
+			case Up: out[i] = static_cast<uint8_t> (row[i] - b); break;
+			case Paeth: out[i] = static_cast<uint8_t> (row[i] - paethPredictor (a, b, c)); break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+mz_bool appendToBuffer (const void* data, int size, void* user)
+{
+	auto buffer = static_cast<std::vector<uint8_t>*> (user);
+	auto bytes = static_cast<const uint8_t*> (data);
+	buffer->insert (buffer->end (), bytes, bytes + size);
+	return MZ_TRUE;
+}
+
+//------------------------------------------------------------------------
+/** the stream byte order depends on the compiler defining __LITTLE_ENDIAN__, so the file formats
+ *	store their integers explicitly */
+inline void storeBigEndian (uint8_t* dst, uint32_t value)
+{
+	for (auto i = 0; i < 4; ++i)
+		dst[i] = static_cast<uint8_t> (value >> (24 - i * 8));
+}
+
+//------------------------------------------------------------------------
+inline void storeLittleEndian (uint8_t* dst, uint32_t value)
+{
+	for (auto i = 0; i < 4; ++i)
+		dst[i] = static_cast<uint8_t> (value >> (i * 8));
+}
+
+//------------------------------------------------------------------------
+bool writePNGChunk (CFileStream& stream, uint32_t type, const uint8_t* data, size_t size)
+{
+	uint8_t prefix[8];
+	storeBigEndian (prefix, static_cast<uint32_t> (size));
+	storeBigEndian (prefix + 4, type);
+	auto crc = mz_crc32 (MZ_CRC32_INIT, prefix + 4, 4);
+	if (size)
+		crc = mz_crc32 (crc, data, size);
+	uint8_t suffix[4];
+	storeBigEndian (suffix, static_cast<uint32_t> (crc));
+	return writeAll (stream, prefix, sizeof (prefix)) && writeAll (stream, data, size) &&
+	       writeAll (stream, suffix, sizeof (suffix));
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+bool stitchImages (const Document& doc, StripBuffer& strip, uint32_t numThreads)
+{
+	if (doc.imagePaths.empty () || doc.width == 0 || doc.height == 0)
+		return false;
+	strip.width = doc.width;
+	strip.frameHeight = doc.height;
+	strip.height = doc.height * static_cast<uint32_t> (doc.imagePaths.size ());
+	strip.pixels.resize (static_cast<size_t> (strip.getBytesPerRow ()) * strip.height);
+
+	std::atomic<bool> failed {false};
+	parallelFor (doc.imagePaths.size (), numThreads, [&] (size_t index) {
+		if (!failed && !copyFrame (doc.imagePaths[index], strip, index))
+			failed = true;
+	});
+	return !failed;
+}
+
+//------------------------------------------------------------------------
+bool writePNG (const StripBuffer& strip, const Path& path, uint32_t compressionLevel,
+               uint32_t numThreads)
+{
+	if (strip.width == 0 || strip.height == 0)
+		return false;
+
+	auto bytesPerRow = strip.getBytesPerRow ();
+	auto filteredRowSize = static_cast<size_t> (bytesPerRow) + 1;
+	std::vector<uint8_t> filtered (filteredRowSize * strip.height);
+	parallelFor (strip.height, numThreads, [&] (size_t y) {
+		auto row = strip.pixels.data () + y * bytesPerRow;
+		filterRow (row, y ? row - bytesPerRow : nullptr, bytesPerRow,
+		           filtered.data () + y * filteredRowSize);
+	});
+
+	// every band is a run of non-final deflate blocks ending on a byte boundary, so the bands can
+	// be concatenated into one stream which a final empty block terminates
+	static constexpr size_t targetBandSize = 1u << 20;
+	auto rowsPerBand = std::max<size_t> (1, targetBandSize / filteredRowSize);
+	auto numBands = (strip.height + rowsPerBand - 1) / rowsPerBand;
+	auto flags = tdefl_create_comp_flags_from_zip_params (
+	    static_cast<int> (std::min (compressionLevel, 10u)), -MZ_DEFAULT_WINDOW_BITS,
+	    MZ_DEFAULT_STRATEGY);
+	std::vector<std::vector<uint8_t>> bands (numBands);
+	std::atomic<bool> failed {false};
+	parallelFor (numBands, numThreads, [&] (size_t index) {
+		auto offset = index * rowsPerBand * filteredRowSize;
+		auto size = std::min (rowsPerBand * filteredRowSize, filtered.size () - offset);
+		auto compressor = tdefl_compressor_alloc ();
+		if (!compressor)
+		{
+			failed = true;
+			return;
+		}
+		bands[index].reserve (size / 2);
+		if (tdefl_init (compressor, appendToBuffer, &bands[index], static_cast<int> (flags)) !=
+		        TDEFL_STATUS_OKAY ||
+		    tdefl_compress_buffer (compressor, filtered.data () + offset, size,
+		                           TDEFL_FULL_FLUSH) != TDEFL_STATUS_OKAY)
+			failed = true;
+		tdefl_compressor_free (compressor);
+	});
+	if (failed)
+		return false;
+	auto adler = mz_adler32 (MZ_ADLER32_INIT, filtered.data (), filtered.size ());
+
+	CFileStream stream;
+	if (!stream.open (path.data (), CFileStream::kWriteMode | CFileStream::kBinaryMode |
+	                                    CFileStream::kTruncateMode))
+		return false;
+
+	static constexpr uint8_t signature[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+	if (!writeAll (stream, signature, sizeof (signature)))
+		return false;
+
+	uint8_t header[13] = {};
+	storeBigEndian (header, strip.width);
+	storeBigEndian (header + 4, strip.height);
+	header[8] = 8; // bit depth
+	header[9] = 6; // color type RGBA
+	if (!writePNGChunk (stream, 'IHDR', header, sizeof (header)))
+		return false;
+
+	static constexpr uint8_t zlibHeader[] = {0x78, 0x9C};
+	if (!writePNGChunk (stream, 'IDAT', zlibHeader, sizeof (zlibHeader)))
+		return false;
+	for (auto& band : bands)
+	{
+		if (!writePNGChunk (stream, 'IDAT', band.data (), band.size ()))
+			return false;
+	}
+	uint8_t trailer[6] = {0x03, 0x00}; // final empty fixed huffman block
+	storeBigEndian (trailer + 2, static_cast<uint32_t> (adler));
+	if (!writePNGChunk (stream, 'IDAT', trailer, sizeof (trailer)))
+		return false;
+	return writePNGChunk (stream, 'IEND', nullptr, 0);
+}
+
+//------------------------------------------------------------------------
+bool writeRaw (const StripBuffer& strip, const Path& path)
+{
+	if (strip.width == 0 || strip.height == 0)
+		return false;
+
+	CFileStream stream;
+	if (!stream.open (path.data (), CFileStream::kWriteMode | CFileStream::kBinaryMode |
+	                                    CFileStream::kTruncateMode))
+		return false;
+
+	const uint32_t values[] = {RawIdentifier,     RawVersion,
+	                           strip.width,       strip.height,
+	                           strip.frameHeight, strip.getNumFrames (),
+	                           strip.getBytesPerRow (), RawHeaderSize};
+	uint8_t header[RawHeaderSize] = {};
+	for (size_t i = 0; i < 8; ++i)
+		storeLittleEndian (header + i * 4, values[i]);
+	if (!writeAll (stream, header, sizeof (header)))
+		return false;
+	return writeAll (stream, strip.pixels.data (), strip.pixels.size ());
+}
+
+//------------------------------------------------------------------------
+} // ImageStitcher
+} // VSTGUI
@@ -0,0 +1,59 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "document.h"
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace ImageStitcher {
+
+//------------------------------------------------------------------------
+/** RGBA pixels with straight alpha, the frames of a document stacked from top to bottom */
+struct StripBuffer
+{
+	uint32_t width {0};
+	uint32_t height {0};
+	uint32_t frameHeight {0};
+	std::vector<uint8_t> pixels;
+
+	uint32_t getBytesPerRow () const noexcept { return width * 4; }
+	uint32_t getNumFrames () const noexcept { return frameHeight ? height / frameHeight : 0; }
+};
+
+//------------------------------------------------------------------------
+/** Decode the images of the document on numThreads threads and copy their pixels into the strip.
+ *
+ *	A numThreads of zero uses one thread per hardware thread.
+ */
+bool stitchImages (const Document& doc, StripBuffer& strip, uint32_t numThreads = 0);
+
+//------------------------------------------------------------------------
+/** Write the strip as PNG.
+ *
+ *	The rows are filtered and deflated in independent bands on numThreads threads. The bands
+ *	are joined into one zlib stream.
+ */
+bool writePNG (const StripBuffer& strip, const Path& path, uint32_t compressionLevel = 6,
+               uint32_t numThreads = 0);
+
+//------------------------------------------------------------------------
+/** Write the strip uncompressed, so that it can be memory mapped.
+ *
+ *	The file starts with a header of eight little endian uint32_t values, padded to
+ *	RawHeaderSize bytes: 'VSTS', version, width, height, frameHeight, numFrames, bytesPerRow and
+ *	the offset of the pixels. The RGBA rows follow without padding.
+ */
+bool writeRaw (const StripBuffer& strip, const Path& path);
+
+static constexpr uint32_t RawIdentifier = 'VSTS';
+static constexpr uint32_t RawVersion = 1;
+static constexpr uint32_t RawHeaderSize = 64;
+
+//------------------------------------------------------------------------
+} // ImageStitcher
+} // VSTGUI
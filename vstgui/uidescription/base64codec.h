@@ -6,6 +6,7 @@
 #define __base64codec__
 
 #include "../lib/malloc.h"
+#include <cstring>
 
 namespace VSTGUI {
 
@@ -66,31 +67,82 @@ public:
 	static inline Result encode (const void* binaryData, size_t binaryDataSize)
 	{
 		Result r;
-		r.data.allocate ((binaryDataSize * 4) / 3 + 4);
-		auto ptr = reinterpret_cast<const uint8_t*> (binaryData);
-		uint8_t input[3];
-		uint32_t i;
-		for (i = 0; i < (binaryDataSize - 3); i += 3)
-		{
-			input[0] = *ptr++;
-			input[1] = *ptr++;
-			input[2] = *ptr++;
-			encodeblock (input, r.data.get () + r.dataSize, 3);
-			r.dataSize += 4;
-		}
-		if (i < binaryDataSize)
+		r.data.allocate (encodedSize (binaryDataSize));
+		auto writeProc = [&] (const uint8_t* encoded, size_t size) {
+			memcpy (r.data.get () + r.dataSize, encoded, size);
+			r.dataSize += static_cast<uint32_t> (size);
+		};
+		Encoder encoder;
+		encoder.add (binaryData, binaryDataSize, writeProc);
+		encoder.finish (writeProc);
+		return r;
+	}
+
+	static constexpr size_t encodedSize (size_t binaryDataSize)
+	{
+		return ((binaryDataSize + 2) / 3) * 4;
+	}
+
+	/** Incremental encoder
+	 *
+	 *	The binary data can be passed in chunks of any size. The encoded output is passed in
+	 *	blocks to the write procedure with the signature void (const uint8_t* data, size_t size).
+	 */
+	class Encoder
+	{
+	public:
+		template<typename WriteProc>
+		void add (const void* binaryData, size_t binaryDataSize, WriteProc&& writeProc)
 		{
-			input[0] = input[1] = input[2] = 0;
-			uint32_t j;
-			for (j = 0; i < binaryDataSize; i++, j++)
+			auto ptr = reinterpret_cast<const uint8_t*> (binaryData);
+			auto end = ptr + binaryDataSize;
+			while (numPending && numPending < 3 && ptr != end)
+				pending[numPending++] = *ptr++;
+			uint8_t output[kOutputBlockSize];
+			size_t outputSize = 0;
+			if (numPending == 3)
 			{
-				input[j] = *ptr++;
+				encodeblock (pending, output, 3);
+				outputSize += 4;
+				numPending = 0;
 			}
-			encodeblock (input, r.data.get () + r.dataSize, j);
-			r.dataSize += 4;
+			while (end - ptr >= 3)
+			{
+				uint8_t input[3] = {ptr[0], ptr[1], ptr[2]};
+				encodeblock (input, output + outputSize, 3);
+				outputSize += 4;
+				ptr += 3;
+				if (outputSize == kOutputBlockSize)
+				{
+					writeProc (output, outputSize);
+					outputSize = 0;
+				}
+			}
+			while (ptr != end)
+				pending[numPending++] = *ptr++;
+			if (outputSize)
+				writeProc (output, outputSize);
 		}
-		return r;
-	}
+
+		template<typename WriteProc>
+		void finish (WriteProc&& writeProc)
+		{
+			if (numPending == 0)
+				return;
+			for (auto i = numPending; i < 3; ++i)
+				pending[i] = 0;
+			uint8_t output[4];
+			encodeblock (pending, output, numPending);
+			numPending = 0;
+			writeProc (output, 4);
+		}
+
+	private:
+		static constexpr size_t kOutputBlockSize = 4096;
+
+		uint8_t pending[3];
+		uint32_t numPending {0};
+	};
 
 private:
 	template<bool finalBlock = true>
@@ -13,6 +13,14 @@
 	#define ftello _ftelli64
 #endif
 
+#if MAC || LINUX
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#define VSTGUI_CFILESTREAM_USE_MMAP 1
+#else
+	#define VSTGUI_CFILESTREAM_USE_MMAP 0
+#endif
+
 namespace VSTGUI {
 
 //-----------------------------------------------------------------------------
@@ -60,19 +68,21 @@ bool CMemoryStream::resize (uint32_t inSize)
 	if (ownsBuffer == false)
 		return false;
 
-	uint32_t newSize = bufferSize + delta;
-	while (newSize < inSize)
-		newSize += delta;
+	// grow by at least half of the current size, so that writing large amounts of data does not
+	// copy the buffer over and over again
+	uint64_t newSize = bufferSize + std::max (delta, bufferSize / 2);
+	if (newSize < inSize)
+		newSize = inSize + delta;
+	newSize = std::min<uint64_t> (newSize, std::numeric_limits<uint32_t>::max ());
+	if (newSize < inSize)
+		return false;
 
-	int8_t* newBuffer = (int8_t*)std::malloc (newSize);
-	if (newBuffer && buffer)
-		memcpy (newBuffer, buffer, size);
-	if (buffer)
-		std::free (buffer);
+	auto newBuffer = static_cast<int8_t*> (std::realloc (buffer, static_cast<size_t> (newSize)));
+	if (!newBuffer)
+		return false;
 	buffer = newBuffer;
-	bufferSize = newSize;
-	
-	return buffer != nullptr;
+	bufferSize = static_cast<uint32_t> (newSize);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -185,6 +195,10 @@ CFileStream::CFileStream ()
 //-----------------------------------------------------------------------------
 CFileStream::~CFileStream () noexcept
 {
+#if VSTGUI_CFILESTREAM_USE_MMAP
+	if (mappedData)
+		munmap (const_cast<int8_t*> (mappedData), static_cast<size_t> (mappedSize));
+#endif
 	if (stream)
 	{
 		fclose (stream);
@@ -228,8 +242,34 @@ bool CFileStream::open (UTF8StringPtr path, int32_t mode, ByteOrder byteOrder)
 #endif
 	stream = fopen (path, fmode.str ().c_str ());
 	openMode = mode;
+	if (stream == nullptr)
+		return false;
 
-	return stream != nullptr;
+	if (mode & kWriteMode)
+		setvbuf (stream, nullptr, _IOFBF, 64 * 1024);
+	else
+		mapFile ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool CFileStream::mapFile ()
+{
+#if VSTGUI_CFILESTREAM_USE_MMAP
+	auto fd = fileno (stream);
+	struct stat st;
+	if (fstat (fd, &st) != 0 || st.st_size <= 0 || !S_ISREG (st.st_mode))
+		return false;
+	auto address = mmap (nullptr, static_cast<size_t> (st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (address == MAP_FAILED)
+		return false;
+	mappedData = static_cast<const int8_t*> (address);
+	mappedSize = static_cast<int64_t> (st.st_size);
+	mappedPos = 0;
+	return true;
+#else
+	return false;
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -246,6 +286,13 @@ uint32_t CFileStream::writeRaw (const void* buffer, uint32_t size)
 //-----------------------------------------------------------------------------
 uint32_t CFileStream::readRaw (void* buffer, uint32_t size)
 {
+	if (mappedData)
+	{
+		auto numBytes = static_cast<uint32_t> (std::min<int64_t> (size, mappedSize - mappedPos));
+		memcpy (buffer, mappedData + mappedPos, numBytes);
+		mappedPos += numBytes;
+		return numBytes;
+	}
 	if (stream)
 	{
 		return static_cast<uint32_t> (fread (buffer, 1, size, stream));
@@ -256,6 +303,20 @@ uint32_t CFileStream::readRaw (void* buffer, uint32_t size)
 //-----------------------------------------------------------------------------
 int64_t CFileStream::seek (int64_t pos, SeekMode mode)
 {
+	if (mappedData)
+	{
+		int64_t newPos = pos;
+		switch (mode)
+		{
+			case kSeekSet: break;
+			case kSeekCurrent: newPos += mappedPos; break;
+			case kSeekEnd: newPos += mappedSize; break;
+		}
+		if (newPos < 0 || newPos > mappedSize)
+			return kStreamSeekError;
+		mappedPos = newPos;
+		return mappedPos;
+	}
 	if (stream)
 	{
 		int fseekmode;
@@ -274,6 +335,8 @@ int64_t CFileStream::seek (int64_t pos, SeekMode mode)
 //-----------------------------------------------------------------------------
 int64_t CFileStream::tell () const
 {
+	if (mappedData)
+		return mappedPos;
 	if (stream)
 	{
 		return ftello (stream);
@@ -284,7 +347,9 @@ int64_t CFileStream::tell () const
 //-----------------------------------------------------------------------------
 void CFileStream::rewind ()
 {
-	if (stream)
+	if (mappedData)
+		mappedPos = 0;
+	else if (stream)
 	{
 		fseek (stream, 0, SEEK_SET);
 	}
@@ -293,8 +358,20 @@ void CFileStream::rewind ()
 //-----------------------------------------------------------------------------
 bool CFileStream::operator>> (std::string& string)
 {
-	int8_t character;
 	string.clear ();
+	if (mappedData)
+	{
+		auto start = mappedData + mappedPos;
+		auto length = static_cast<size_t> (mappedSize - mappedPos);
+		if (auto zero = memchr (start, 0, length))
+			length = static_cast<size_t> (static_cast<const int8_t*> (zero) - start);
+		string.assign (reinterpret_cast<const char*> (start), length);
+		mappedPos += static_cast<int64_t> (length);
+		if (mappedPos < mappedSize)
+			++mappedPos; // skip the terminating zero
+		return true;
+	}
+	int8_t character;
 	while (readRaw (&character, sizeof (character)) == sizeof (character))
 	{
 		if (character == 0)
@@ -382,24 +459,6 @@ void CResourceInputStream::rewind ()
 		platformStream->seek (0, VSTGUI::SeekMode::Set);
 }
 
-//-----------------------------------------------------------------------------
-template<typename T>
-void endianSwap (T& value)
-{
-	uint32_t size = sizeof (T);
-	auto low = reinterpret_cast<uint8_t*> (&value);
-	auto high = low + size - 1;
-	while (size >= 2)
-	{
-		auto tmp = *low;
-		*low = *high;
-		*high = tmp;
-		low += 2;
-		high -= 2;
-		size -= 2;
-	}
-}
-
 //-----------------------------------------------------------------------------
 template<typename T>
 bool writeEndianSwap (const T& value, OutputStream& s)
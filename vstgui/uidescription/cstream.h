@@ -8,13 +8,33 @@
 #include "../lib/vstguifwd.h"
 #include "../lib/optional.h"
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <limits>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace VSTGUI {
 
+//-----------------------------------------------------------------------------
+template<typename T>
+inline void endianSwap (T& value)
+{
+	uint32_t size = sizeof (T);
+	auto low = reinterpret_cast<uint8_t*> (&value);
+	auto high = low + size - 1;
+	while (size >= 2)
+	{
+		auto tmp = *low;
+		*low = *high;
+		*high = tmp;
+		++low;
+		--high;
+		size -= 2;
+	}
+}
+
 /**
 	ByteOrder aware output stream interface
  */
@@ -40,6 +60,10 @@ public:
 	virtual bool operator<< (const std::string& str) = 0;
 
 	virtual uint32_t writeRaw (const void* buffer, uint32_t size) = 0;
+
+	/** write an array of numbers at once, byte order aware */
+	template<typename T>
+	bool write (const T* values, size_t count);
 private:
 	ByteOrder byteOrder;
 };
@@ -69,6 +93,10 @@ public:
 	virtual bool operator>> (std::string& string) = 0;
 
 	virtual uint32_t readRaw (void* buffer, uint32_t size) = 0;
+
+	/** read an array of numbers at once, byte order aware */
+	template<typename T>
+	bool read (T* values, size_t count);
 private:
 	ByteOrder byteOrder;
 };
@@ -161,8 +189,14 @@ public:
 	using OutputStream::operator<<;
 	using InputStream::operator>>;
 protected:
+	bool mapFile ();
+
 	FILE* stream;
 	int32_t openMode;
+	// files opened for reading only are mapped into memory if possible
+	const int8_t* mappedData {nullptr};
+	int64_t mappedSize {0};
+	int64_t mappedPos {0};
 };
 
 static const int8_t unixPathSeparator = '/';
@@ -231,11 +265,15 @@ protected:
 };
 
 //------------------------------------------------------------------------
+/** Collects small writes and passes them in large blocks to another stream
+ *
+ *	Strings are written without any framing.
+ */
 class BufferedOutputStream : public OutputStream
 {
 public:
-	BufferedOutputStream (OutputStream& stream, size_t bufferSize = 8192)
-	: stream (stream), bufferSize (bufferSize)
+	BufferedOutputStream (OutputStream& stream, size_t bufferSize = 64 * 1024)
+	: OutputStream (stream.getByteOrder ()), stream (stream), bufferSize (bufferSize)
 	{
 		buffer.reserve (bufferSize);
 	}
@@ -246,21 +284,17 @@ public:
 	}
 	uint32_t writeRaw (const void* inBuffer, uint32_t size) override
 	{
-		auto written = size;
-		const uint8_t* ptr = reinterpret_cast<const uint8_t*> (inBuffer);
-		while (size)
+		if (buffer.size () + size > bufferSize)
 		{
-			auto toWrite = 1;
-			buffer.emplace_back (*ptr);
-			if (buffer.size () == bufferSize)
-			{
-				if (!flush ())
-					return kStreamIOError;
-			}
-			size -= toWrite;
-			ptr += toWrite;
+			if (!flush ())
+				return kStreamIOError;
+			// large blocks are passed through without copying
+			if (size >= bufferSize)
+				return stream.writeRaw (inBuffer, size);
 		}
-		return written;
+		auto ptr = reinterpret_cast<const uint8_t*> (inBuffer);
+		buffer.insert (buffer.end (), ptr, ptr + size);
+		return size;
 	}
 	bool flush ()
 	{
@@ -278,6 +312,75 @@ private:
 	size_t bufferSize;
 };
 
+//------------------------------------------------------------------------
+namespace StreamDetail {
+
+static constexpr size_t kMaxBlockSize = 1 << 30;
+static constexpr size_t kSwapBufferSize = 4096;
+
+} // StreamDetail
+
+//------------------------------------------------------------------------
+template<typename T>
+inline bool OutputStream::write (const T* values, size_t count)
+{
+	static_assert (std::is_arithmetic<T>::value, "only numbers can be written as arrays");
+	if (byteOrder == kNativeByteOrder || sizeof (T) == 1)
+	{
+		auto ptr = reinterpret_cast<const uint8_t*> (values);
+		auto size = count * sizeof (T);
+		while (size)
+		{
+			auto blockSize = static_cast<uint32_t> (std::min (size, StreamDetail::kMaxBlockSize));
+			if (writeRaw (ptr, blockSize) != blockSize)
+				return false;
+			ptr += blockSize;
+			size -= blockSize;
+		}
+		return true;
+	}
+	T swapped[StreamDetail::kSwapBufferSize / sizeof (T)];
+	constexpr auto swapCount = sizeof (swapped) / sizeof (T);
+	while (count)
+	{
+		auto blockCount = std::min (count, swapCount);
+		for (size_t i = 0; i < blockCount; ++i)
+		{
+			swapped[i] = values[i];
+			endianSwap (swapped[i]);
+		}
+		auto blockSize = static_cast<uint32_t> (blockCount * sizeof (T));
+		if (writeRaw (swapped, blockSize) != blockSize)
+			return false;
+		values += blockCount;
+		count -= blockCount;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+inline bool InputStream::read (T* values, size_t count)
+{
+	static_assert (std::is_arithmetic<T>::value, "only numbers can be read as arrays");
+	auto ptr = reinterpret_cast<uint8_t*> (values);
+	auto size = count * sizeof (T);
+	while (size)
+	{
+		auto blockSize = static_cast<uint32_t> (std::min (size, StreamDetail::kMaxBlockSize));
+		if (readRaw (ptr, blockSize) != blockSize)
+			return false;
+		ptr += blockSize;
+		size -= blockSize;
+	}
+	if (byteOrder != kNativeByteOrder && sizeof (T) > 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+			endianSwap (values[i]);
+	}
+	return true;
+}
+
 } // namespace
 
 #endif
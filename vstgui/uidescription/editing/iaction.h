@@ -23,6 +23,13 @@ public:
 	virtual UTF8StringPtr getName () = 0;
 	virtual void perform () = 0;
 	virtual void undo () = 0;
+
+	/** approximate heap memory in bytes held by this action, used to bound the undo history */
+	virtual size_t getMemoryUsage () const { return 0; }
+	/** merge the directly following action into this one. On success the undo manager performs and
+	 *	deletes nextAction, undoing this action must then restore the state from before both.
+	 */
+	virtual bool merge (IAction* /*nextAction*/) { return false; }
 };
 
 //----------------------------------------------------------------------------------------------------
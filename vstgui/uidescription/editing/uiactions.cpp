@@ -13,6 +13,8 @@
 #include "../../lib/cgraphicspath.h"
 #include "../../lib/cbitmap.h"
 #include "../detail/uiviewcreatorattributes.h"
+#include <algorithm>
+#include <unordered_map>
 
 namespace VSTGUI {
 
@@ -279,6 +281,14 @@ void ViewCopyOperation::undo ()
 	}
 }
 
+//-----------------------------------------------------------------------------
+size_t ViewCopyOperation::getMemoryUsage () const
+{
+	// the copied views are only owned by this operation while it is undone
+	return size () * (sizeof (CView) + 3 * sizeof (void*)) +
+		   oldSelectedViews.size () * 3 * sizeof (void*);
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -343,6 +353,20 @@ void ViewSizeChangeOperation::undo ()
 	}
 }
 
+//-----------------------------------------------------------------------------
+bool ViewSizeChangeOperation::merge (IAction* nextAction)
+{
+	auto next = dynamic_cast<ViewSizeChangeOperation*> (nextAction);
+	if (!next || next->sizing != sizing || next->autosizing != autosizing ||
+		next->size () != size ())
+		return false;
+	// same views in the same order, keep our sizes as they are the ones from before both changes
+	return std::equal (begin (), end (), next->begin (),
+					   [] (const value_type& e1, const value_type& e2) {
+						   return e1.first == e2.first;
+					   });
+}
+
 //-----------------------------------------------------------------------------
 bool ViewSizeChangeOperation::didChange ()
 {
@@ -418,6 +442,13 @@ void DeleteOperation::undo ()
 	}
 }
 
+//----------------------------------------------------------------------------------------------------
+size_t DeleteOperation::getMemoryUsage () const
+{
+	// the deleted views are only owned by this operation while it is performed
+	return size () * (sizeof (CView) + sizeof (value_type) + 4 * sizeof (void*));
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -560,12 +591,20 @@ AttributeChangeAction::AttributeChangeAction (UIDescription* desc, UISelection*
 , attrValue (attrValue)
 {
 	const UIViewFactory* viewFactory = dynamic_cast<const UIViewFactory*> (desc->getViewFactory ());
+	std::unordered_map<std::string, uint32_t> valueIndex;
 	std::string attrOldValue;
 	for (auto view : *selection)
 	{
 		viewFactory->getAttributeValue (view, attrName, attrOldValue, desc);
-		insert (std::make_pair (view, attrOldValue));
+		auto it = valueIndex.find (attrOldValue);
+		if (it == valueIndex.end ())
+		{
+			it = valueIndex.emplace (attrOldValue, static_cast<uint32_t> (oldValues.size ())).first;
+			oldValues.emplace_back (attrOldValue);
+		}
+		insert (std::make_pair (view, it->second));
 	}
+	oldValues.shrink_to_fit ();
 	name = "'" + attrName + "' change";
 }
 
@@ -616,7 +655,7 @@ void AttributeChangeAction::undo ()
 	for (auto& element : *this)
 	{
 		UIAttributes attr;
-		attr.setAttribute (attrName, element.second);
+		attr.setAttribute (attrName, oldValues[element.second]);
 		element.first->invalid ();	// we need to invalid before changing anything as the size may change
 		viewFactory->applyAttributeValues (element.first, attr, desc);
 		element.first->invalid ();	// and afterwards also
@@ -625,6 +664,32 @@ void AttributeChangeAction::undo ()
 	updateSelection ();
 }
 
+//-----------------------------------------------------------------------------
+size_t AttributeChangeAction::getMemoryUsage () const
+{
+	size_t result = size () * (sizeof (value_type) + 4 * sizeof (void*));
+	result += attrName.capacity () + attrValue.capacity () + name.capacity ();
+	for (auto& value : oldValues)
+		result += sizeof (value) + value.capacity ();
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+bool AttributeChangeAction::merge (IAction* nextAction)
+{
+	auto next = dynamic_cast<AttributeChangeAction*> (nextAction);
+	if (!next || next->desc != desc || next->attrName != attrName || next->size () != size ())
+		return false;
+	// the maps are ordered by view, so the same set of views means the same key sequence
+	if (!std::equal (begin (), end (), next->begin (),
+					 [] (const value_type& e1, const value_type& e2) {
+						 return e1.first == e2.first;
+					 }))
+		return false;
+	attrValue = next->attrValue;
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
@@ -704,6 +769,15 @@ void MultipleAttributeChangeAction::undo ()
 	setAttributeValue (oldValue.c_str ());
 }
 
+//----------------------------------------------------------------------------------------------------
+size_t MultipleAttributeChangeAction::getMemoryUsage () const
+{
+	size_t result = capacity () * sizeof (value_type) + oldValue.capacity () + newValue.capacity ();
+	for (auto& element : *this)
+		result += element.second.capacity ();
+	return result;
+}
+
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
@@ -32,6 +32,11 @@ class BaseSelectionOperation : public IAction, protected std::list<T>
 public:
 	BaseSelectionOperation (UISelection* selection) : selection (selection) {}
 
+	size_t getMemoryUsage () const override
+	{
+		return this->size () * (sizeof (T) + 2 * sizeof (void*));
+	}
+
 protected:
 	SharedPointer<UISelection> selection;	
 };
@@ -94,6 +99,7 @@ public:
 	UTF8StringPtr getName () override;
 	void perform () override;
 	void undo () override;
+	size_t getMemoryUsage () const override;
 protected:
 	SharedPointer<CViewContainer> parent;
 	SharedPointer<UISelection> copySelection;
@@ -111,6 +117,7 @@ public:
 	UTF8StringPtr getName () override;
 	void perform () override;
 	void undo () override;
+	bool merge (IAction* nextAction) override;
 	
 	bool didChange ();
 protected:
@@ -138,6 +145,7 @@ public:
 	UTF8StringPtr getName () override;
 	void perform () override;
 	void undo () override;
+	size_t getMemoryUsage () const override;
 protected:
 	SharedPointer<UISelection> selection;
 };
@@ -181,7 +189,7 @@ protected:
 };
 
 //-----------------------------------------------------------------------------
-class AttributeChangeAction : public IAction, protected std::map<SharedPointer<CView>, std::string>
+class AttributeChangeAction : public IAction, protected std::map<SharedPointer<CView>, uint32_t>
 {
 public:
 	AttributeChangeAction (UIDescription* desc, UISelection* selection, const std::string& attrName, const std::string& attrValue);
@@ -190,6 +198,8 @@ public:
 	UTF8StringPtr getName () override;
 	void perform () override;
 	void undo () override;
+	size_t getMemoryUsage () const override;
+	bool merge (IAction* nextAction) override;
 protected:
 	void updateSelection ();
 	
@@ -198,6 +208,8 @@ protected:
 	std::string attrName;
 	std::string attrValue;
 	std::string name;
+	/** distinct old values, the views map to an index into this list */
+	std::vector<std::string> oldValues;
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -208,6 +220,7 @@ public:
 	UTF8StringPtr getName () override { return "multiple view attribute changes"; }
 	void perform () override;
 	void undo () override;
+	size_t getMemoryUsage () const override;
 protected:
 	void setAttributeValue (UTF8StringPtr value);
 	static void collectAllSubViews (CView* view, std::list<CView*>& views);
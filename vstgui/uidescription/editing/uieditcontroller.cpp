@@ -1772,9 +1772,12 @@ void UIEditController::appendContextMenuItems (COptionMenu& contextMenu, CView*
 	if (view != editView)
 		return;
 	auto editMenu = getMenuController ()->getEditMenu ();
-	for (auto& entry : *editMenu->getItems ())
+	for (int32_t i = 0, numEntries = editMenu->getNbEntries (); i < numEntries; ++i)
 	{
-		if (auto item = entry.cast<CCommandMenuItem> ())
+		auto entry = editMenu->getEntry (i);
+		if (!entry)
+			continue;
+		if (auto item = dynamic_cast<CCommandMenuItem*> (entry))
 		{
 			item->validate ();
 		}
@@ -347,8 +347,11 @@ bool UIEditMenuController::validateMenuItem (CCommandMenuItem& item)
 //----------------------------------------------------------------------------------------------------
 CCommandMenuItem* UIEditMenuController::findKeyCommandItem (COptionMenu* menu, const VstKeyCode& key)
 {
-	for (auto& item : *menu->getItems ())
+	for (int32_t i = 0, numEntries = menu->getNbEntries (); i < numEntries; ++i)
 	{
+		auto item = menu->getEntry (i);
+		if (!item)
+			continue;
 		COptionMenu* subMenu = item->getSubmenu ();
 		if (subMenu)
 		{
@@ -356,7 +359,7 @@ CCommandMenuItem* UIEditMenuController::findKeyCommandItem (COptionMenu* menu, c
 			if (result)
 				return result;
 		}
-		CCommandMenuItem* result = item.cast<CCommandMenuItem>();
+		CCommandMenuItem* result = dynamic_cast<CCommandMenuItem*> (item);
 		if (result)
 		{
 			int32_t modifier = 0;
@@ -260,16 +260,15 @@ void UIFontsController::dbSelectionChanged (int32_t selectedRow, GenericStringLi
 		if (fontMenu && !font->getName ().empty ())
 		{
 			const auto& fontName = font->getName ();
-			CMenuItemList* items = fontMenu->getItems ();
-			int32_t index = 0;
-			for (auto& item : *items)
+			for (int32_t index = 0, numEntries = fontMenu->getNbEntries (); index < numEntries;
+				 ++index)
 			{
-				if (fontName == item->getTitle ())
+				auto item = fontMenu->getEntry (index);
+				if (item && fontName == item->getTitle ())
 				{
 					fontMenu->setValue ((float)index);
 					break;
 				}
-				index++;
 			}
 			fontMenu->setStyle (fontMenu->getStyle () & ~COptionMenu::kNoTextStyle);
 			fontMenu->setMouseEnabled (true);
@@ -7,6 +7,8 @@
 #if VSTGUI_LIVE_EDITING
 
 #include "iaction.h"
+#include <algorithm>
+#include <iterator>
 #include <string>
 
 namespace VSTGUI {
@@ -36,6 +38,14 @@ public:
 
 	UTF8StringPtr getName () override { return name.c_str (); }
 
+	size_t getMemoryUsage () const override
+	{
+		size_t result = name.capacity ();
+		for (auto action : *this)
+			result += action->getMemoryUsage ();
+		return result;
+	}
+
 	void perform () override
 	{
 		std::for_each (begin (), end (), doPerform);
@@ -77,6 +87,14 @@ void UIUndoManager::pushAndPerform (IAction* action)
 		groupQueue.back ()->emplace_back (action);
 		return;
 	}
+	if (mergeIntoLastAction (action))
+	{
+		action->perform ();
+		delete action;
+		trimHistory ();
+		changed (kMsgChanged);
+		return;
+	}
 	if (position != end ())
 	{
 		position++;
@@ -94,9 +112,68 @@ void UIUndoManager::pushAndPerform (IAction* action)
 	position = end ();
 	position--;
 	action->perform ();
+	trimHistory ();
 	changed (kMsgChanged);
 }
 
+//----------------------------------------------------------------------------------------------------
+bool UIUndoManager::mergeIntoLastAction (IAction* action)
+{
+	auto now = std::chrono::steady_clock::now ();
+	auto elapsed = now - lastPushTime;
+	lastPushTime = now;
+	if (mergeInterval == 0 || elapsed > std::chrono::milliseconds (mergeInterval))
+		return false;
+	// only merge into the action on top of the stack and never change the saved state
+	if (position == end () || position == begin () || std::next (position) != end () ||
+		position == savePosition)
+		return false;
+	return (*position)->merge (action);
+}
+
+//----------------------------------------------------------------------------------------------------
+void UIUndoManager::trimHistory ()
+{
+	auto numActions = getNumActions ();
+	auto bytes = maxBytes ? getMemoryUsage () : 0;
+	while (numActions && position != begin () &&
+		   ((maxActions && numActions > maxActions) || (maxBytes && bytes > maxBytes)))
+	{
+		auto oldest = std::next (begin ());
+		// the stack top now stands for the state after the oldest action
+		if (savePosition == begin ())
+			savePosition = end ();
+		else if (savePosition == oldest)
+			savePosition = begin ();
+		if (position == oldest)
+			position = begin ();
+		bytes -= std::min (bytes, (*oldest)->getMemoryUsage ());
+		delete *oldest;
+		erase (oldest);
+		--numActions;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void UIUndoManager::setHistoryLimits (size_t _maxActions, size_t _maxBytes)
+{
+	maxActions = _maxActions;
+	maxBytes = _maxBytes;
+	auto numActions = getNumActions ();
+	trimHistory ();
+	if (numActions != getNumActions ())
+		changed (kMsgChanged);
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t UIUndoManager::getMemoryUsage () const
+{
+	size_t result = 0;
+	for (auto action : *this)
+		result += action->getMemoryUsage ();
+	return result;
+}
+
 //----------------------------------------------------------------------------------------------------
 void UIUndoManager::performUndo ()
 {
@@ -10,6 +10,7 @@
 #if VSTGUI_LIVE_EDITING
 
 #include "../../lib/idependency.h"
+#include <chrono>
 #include <list>
 #include <deque>
 
@@ -42,13 +43,37 @@ public:
 
 	void markSavePosition ();
 	bool isSavePosition () const;
-	
+
+	/** limit the history to a number of actions and to the memory they hold (zero means no limit).
+	 *	The oldest actions are dropped first, actions which can still be redone are kept.
+	 */
+	void setHistoryLimits (size_t maxActions, size_t maxBytes);
+	size_t getMaxActions () const { return maxActions; }
+	size_t getMaxBytes () const { return maxBytes; }
+
+	/** actions pushed within this interval are merged into the previous action if it supports
+	 *	merging (zero disables merging)
+	 */
+	void setMergeInterval (uint32_t milliseconds) { mergeInterval = milliseconds; }
+	uint32_t getMergeInterval () const { return mergeInterval; }
+
+	size_t getNumActions () const { return size () - 1; }
+	size_t getMemoryUsage () const;
+
 	static IdStringPtr kMsgChanged;
 protected:
+	bool mergeIntoLastAction (IAction* action);
+	void trimHistory ();
+
 	iterator position;
 	iterator savePosition;
 	using GroupActionDeque = std::deque<UIGroupAction*>;
 	GroupActionDeque groupQueue;
+
+	size_t maxActions {500};
+	size_t maxBytes {32 * 1024 * 1024};
+	uint32_t mergeInterval {1000};
+	std::chrono::steady_clock::time_point lastPushTime;
 };
 
 } // namespace
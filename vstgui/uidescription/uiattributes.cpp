@@ -7,10 +7,159 @@
 #include "../lib/cpoint.h"
 #include "../lib/crect.h"
 #include "../lib/cstring.h"
+#include "../lib/ccolor.h"
 #include <sstream>
 #include <algorithm>
+#include <clocale>
+#include <cstdlib>
 
 namespace VSTGUI {
+namespace {
+
+//-----------------------------------------------------------------------------
+inline bool isSpace (char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+//-----------------------------------------------------------------------------
+inline bool isDigit (char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+//-----------------------------------------------------------------------------
+/** parses a decimal number at the start of [first, last) in the classic locale
+ *
+ *	Like reading from a stream leading white space is skipped and trailing characters are
+ *	ignored. On failure value is set to zero.
+ */
+bool parseDouble (const char* first, const char* last, double& value)
+{
+	value = 0.;
+	while (first != last && isSpace (*first))
+		++first;
+	auto start = first;
+
+	// copy the number to a buffer, strtod needs a terminated string in the current locale
+	char buffer[128];
+	size_t length = 0;
+	auto append = [&] (char c) {
+		if (length + 1 >= sizeof (buffer))
+			return false;
+		buffer[length++] = c;
+		return true;
+	};
+	auto appendDigits = [&] () {
+		size_t numDigits = 0;
+		while (first != last && isDigit (*first))
+		{
+			if (!append (*first++))
+				return std::string::npos;
+			++numDigits;
+		}
+		return numDigits;
+	};
+
+	if (first != last && (*first == '-' || *first == '+'))
+		append (*first++);
+	auto numDigits = appendDigits ();
+	if (first != last && *first == '.')
+	{
+		++first;
+		append (*localeconv ()->decimal_point);
+		auto numFractionDigits = appendDigits ();
+		if (numFractionDigits == std::string::npos || numDigits == std::string::npos)
+			numDigits = std::string::npos;
+		else
+			numDigits += numFractionDigits;
+	}
+	if (numDigits == 0)
+		return false;
+	if (numDigits != std::string::npos && first != last && (*first == 'e' || *first == 'E'))
+	{
+		auto exponent = first + 1;
+		if (exponent != last && (*exponent == '-' || *exponent == '+'))
+			++exponent;
+		if (exponent != last && isDigit (*exponent))
+		{
+			append (*first++);
+			if (*first == '-' || *first == '+')
+				append (*first++);
+			numDigits = appendDigits () == std::string::npos ? std::string::npos : numDigits;
+		}
+	}
+	if (numDigits == std::string::npos)
+	{
+		// too long for the buffer, rare enough to take the slow path
+		std::istringstream sstream (std::string (start, last));
+		sstream.imbue (std::locale::classic ());
+		sstream >> value;
+		if (sstream.fail ())
+			value = 0.;
+		return !sstream.fail ();
+	}
+	buffer[length] = 0;
+	value = strtod (buffer, nullptr);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/** parses numValues comma separated decimal numbers */
+template<size_t numValues>
+bool parseDoubleList (const std::string& str, double (&values)[4])
+{
+	static_assert (numValues <= 4, "");
+	auto first = str.data ();
+	auto last = first + str.size ();
+	for (size_t i = 0; i < numValues; ++i)
+	{
+		auto separator = std::find (first, last, ',');
+		if ((separator == last) != (i == numValues - 1))
+			return false;
+		parseDouble (first, separator, values[i]);
+		first = separator + 1;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool parseHexByte (const char* str, double& value)
+{
+	uint32_t result = 0;
+	for (auto i = 0; i < 2; ++i)
+	{
+		auto c = str[i];
+		result <<= 4;
+		if (isDigit (c))
+			result |= static_cast<uint32_t> (c - '0');
+		else if (c >= 'a' && c <= 'f')
+			result |= static_cast<uint32_t> (c - 'a' + 10);
+		else if (c >= 'A' && c <= 'F')
+			result |= static_cast<uint32_t> (c - 'A' + 10);
+		else
+			return false;
+	}
+	value = result;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool parseColorLiteral (const std::string& str, double (&values)[4])
+{
+	if ((str.size () != 7 && str.size () != 9) || str[0] != '#')
+		return false;
+	values[3] = 255.;
+	for (size_t i = 0; i < (str.size () - 1) / 2; ++i)
+	{
+		if (!parseHexByte (str.data () + 1 + i * 2, values[i]))
+			return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+} // anonymous
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -75,6 +224,16 @@ void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 		emplace (std::move (name), std::move (value));
 }
 
+//-----------------------------------------------------------------------------
+void UIAttributes::setAttributeValue (const std::string& name, const UIAttributeValue& value)
+{
+	iterator iter = find (name);
+	if (iter != end ())
+		iter->second = value;
+	else
+		emplace (name, value);
+}
+
 //-----------------------------------------------------------------------------
 void UIAttributes::removeAttribute (const std::string& name)
 {
@@ -83,6 +242,45 @@ void UIAttributes::removeAttribute (const std::string& name)
 		erase (iter);
 }
 
+//-----------------------------------------------------------------------------
+template<typename ParseProc>
+bool UIAttributes::getTypedValue (const std::string& name, TypedType type, ParseProc proc,
+								  double (&values)[4]) const
+{
+	const_iterator iter = find (name);
+	if (iter == end ())
+		return false;
+	const UIAttributeValue& value = iter->second;
+	auto state = value.typedState.load (std::memory_order_acquire);
+	if (state == UIAttributeValue::kNone &&
+		value.typedState.compare_exchange_strong (state, UIAttributeValue::kParsing,
+												  std::memory_order_acquire))
+	{
+		value.typedValid = proc (value, value.typedValues);
+		value.typedState.store (type, std::memory_order_release);
+		state = type;
+	}
+	if (state != type)
+	{
+		// cached as another type or being parsed by another thread
+		return proc (value, values);
+	}
+	std::copy (std::begin (value.typedValues), std::end (value.typedValues), values);
+	return value.typedValid;
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setTypedValue (const std::string& name, TypedType type, double value)
+{
+	iterator iter = find (name);
+	if (iter != end ())
+	{
+		iter->second.typedValues[0] = value;
+		iter->second.typedValid = true;
+		iter->second.typedState.store (type, std::memory_order_release);
+	}
+}
+
 //-----------------------------------------------------------------------------
 void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 {
@@ -91,18 +289,20 @@ void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 	str.precision (40);
 	str << value;
 	setAttribute (name, str.str ());
+	setTypedValue (name, TypedType::kDouble, value);
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	auto parse = [] (const std::string& str, double (&values)[4]) {
+		parseDouble (str.data (), str.data () + str.size (), values[0]);
+		return true;
+	};
+	double typedValue[4];
+	if (getTypedValue (name, TypedType::kDouble, parse, typedValue))
 	{
-		std::istringstream sstream (*str);
-		sstream.imbue (std::locale::classic ());
-		sstream.precision (40);
-		sstream >> value;
+		value = typedValue[0];
 		return true;
 	}
 	return false;
@@ -112,24 +312,26 @@ bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) c
 void UIAttributes::setBooleanAttribute (const std::string& name, bool value)
 {
 	setAttribute (name, value ? "true" : "false");
+	setTypedValue (name, TypedType::kBoolean, value ? 1. : 0.);
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getBooleanAttribute (const std::string& name, bool& value) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	auto parse = [] (const std::string& str, double (&values)[4]) {
+		if (str == "true")
+			values[0] = 1.;
+		else if (str == "false")
+			values[0] = 0.;
+		else
+			return false;
+		return true;
+	};
+	double typedValue[4];
+	if (getTypedValue (name, TypedType::kBoolean, parse, typedValue))
 	{
-		if (*str == "true")
-		{
-			value = true;
-			return true;
-		}
-		else if (*str == "false")
-		{
-			value = false;
-			return true;
-		}
+		value = typedValue[0] != 0.;
+		return true;
 	}
 	return false;
 }
@@ -140,15 +342,20 @@ void UIAttributes::setIntegerAttribute (const std::string& name, int32_t value)
 	std::stringstream str;
 	str << value;
 	setAttribute (name, str.str ());
+	setTypedValue (name, TypedType::kInteger, value);
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	auto parse = [] (const std::string& str, double (&values)[4]) {
+		values[0] = static_cast<int32_t> (strtol (str.data (), nullptr, 10));
+		return true;
+	};
+	double typedValue[4];
+	if (getTypedValue (name, TypedType::kInteger, parse, typedValue))
 	{
-		value = (int32_t)strtol (str->c_str (), nullptr, 10);
+		value = static_cast<int32_t> (typedValue[0]);
 		return true;
 	}
 	return false;
@@ -167,28 +374,12 @@ void UIAttributes::setPointAttribute (const std::string& name, const CPoint& p)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	double typedValue[4];
+	if (getTypedValue (name, TypedType::kPoint, parseDoubleList<2>, typedValue))
 	{
-		size_t start = 0;
-		size_t pos = str->find (",", start, 1);
-		if (pos != std::string::npos)
-		{
-			StringArray subStrings;
-			while (pos != std::string::npos)
-			{
-				subStrings.emplace_back (*str, start, pos - start);
-				start = pos+1;
-				pos = str->find (",", start, 1);
-			}
-			subStrings.emplace_back (*str, start, std::string::npos);
-			if (subStrings.size () == 2)
-			{
-				p.x = UTF8StringView (subStrings[0].c_str ()).toDouble ();
-				p.y = UTF8StringView (subStrings[1].c_str ()).toDouble ();
-				return true;
-			}
-		}
+		p.x = typedValue[0];
+		p.y = typedValue[1];
+		return true;
 	}
 	return false;
 }
@@ -210,30 +401,29 @@ void UIAttributes::setRectAttribute (const std::string& name, const CRect& r)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getRectAttribute (const std::string& name, CRect& r) const
 {
-	const std::string* str = getAttributeValue (name);
-	if (str)
+	double typedValue[4];
+	if (getTypedValue (name, TypedType::kRect, parseDoubleList<4>, typedValue))
 	{
-		size_t start = 0;
-		size_t pos = str->find (",", start, 1);
-		if (pos != std::string::npos)
-		{
-			StringArray subStrings;
-			while (pos != std::string::npos)
-			{
-				subStrings.emplace_back (*str, start, pos - start);
-				start = pos+1;
-				pos = str->find (",", start, 1);
-			}
-			subStrings.emplace_back (*str, start, std::string::npos);
-			if (subStrings.size () == 4)
-			{
-				r.left = UTF8StringView (subStrings[0].c_str ()).toDouble ();
-				r.top = UTF8StringView (subStrings[1].c_str ()).toDouble ();
-				r.right = UTF8StringView (subStrings[2].c_str ()).toDouble ();
-				r.bottom = UTF8StringView (subStrings[3].c_str ()).toDouble ();
-				return true;
-			}
-		}
+		r.left = typedValue[0];
+		r.top = typedValue[1];
+		r.right = typedValue[2];
+		r.bottom = typedValue[3];
+		return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getColorAttribute (const std::string& name, CColor& c) const
+{
+	double typedValue[4];
+	if (getTypedValue (name, TypedType::kColor, parseColorLiteral, typedValue))
+	{
+		c.red = static_cast<uint8_t> (typedValue[0]);
+		c.green = static_cast<uint8_t> (typedValue[1]);
+		c.blue = static_cast<uint8_t> (typedValue[2]);
+		c.alpha = static_cast<uint8_t> (typedValue[3]);
+		return true;
 	}
 	return false;
 }
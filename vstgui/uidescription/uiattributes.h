@@ -8,6 +8,9 @@
 #include "../lib/vstguifwd.h"
 #include "../lib/cstring.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <vector>
 #include "../lib/platform/std_unorderedmap.h"
 
@@ -15,7 +18,83 @@ namespace VSTGUI {
 class OutputStream;
 class InputStream;
 
-using UIAttributesMap = std::unordered_map<std::string,std::string>;
+//-----------------------------------------------------------------------------
+/** Value of an UIAttributes entry
+ *
+ *	Besides the string it remembers the typed form it was first parsed to, so that repeated typed
+ *	queries of the same attribute do not parse the string again. The typed form is published once
+ *	with an atomic state, const queries from several threads do not race. Assigning a new string
+ *	resets the typed form.
+ */
+class UIAttributeValue : public std::string
+{
+public:
+	UIAttributeValue () = default;
+	UIAttributeValue (const char* str) : std::string (str) {}
+	UIAttributeValue (const std::string& str) : std::string (str) {}
+	UIAttributeValue (std::string&& str) : std::string (std::move (str)) {}
+	UIAttributeValue (const UIAttributeValue& o) : std::string (o) { copyTypedValue (o); }
+	UIAttributeValue (UIAttributeValue&& o) : std::string (std::move (o)) { copyTypedValue (o); }
+
+	UIAttributeValue& operator= (const UIAttributeValue& o)
+	{
+		std::string::operator= (o);
+		copyTypedValue (o);
+		return *this;
+	}
+	UIAttributeValue& operator= (UIAttributeValue&& o)
+	{
+		std::string::operator= (std::move (o));
+		copyTypedValue (o);
+		return *this;
+	}
+	UIAttributeValue& operator= (const std::string& str)
+	{
+		std::string::operator= (str);
+		typedState.store (kNone, std::memory_order_relaxed);
+		return *this;
+	}
+	UIAttributeValue& operator= (std::string&& str)
+	{
+		std::string::operator= (std::move (str));
+		typedState.store (kNone, std::memory_order_relaxed);
+		return *this;
+	}
+
+private:
+	friend class UIAttributes;
+
+	enum TypedType : uint8_t
+	{
+		kNone,
+		kParsing,
+		kBoolean,
+		kInteger,
+		kDouble,
+		kPoint,
+		kRect,
+		kColor
+	};
+
+	void copyTypedValue (const UIAttributeValue& o)
+	{
+		auto state = o.typedState.load (std::memory_order_acquire);
+		if (state == kNone || state == kParsing)
+		{
+			typedState.store (kNone, std::memory_order_relaxed);
+			return;
+		}
+		std::copy (std::begin (o.typedValues), std::end (o.typedValues), typedValues);
+		typedValid = o.typedValid;
+		typedState.store (state, std::memory_order_relaxed);
+	}
+
+	mutable double typedValues[4];
+	mutable bool typedValid {false};
+	mutable std::atomic<uint8_t> typedState {kNone};
+};
+
+using UIAttributesMap = std::unordered_map<std::string, UIAttributeValue>;
 
 //-----------------------------------------------------------------------------
 class UIAttributes : public NonAtomicReferenceCounted, private UIAttributesMap
@@ -36,6 +115,8 @@ public:
 	void setAttribute (const std::string& name, const std::string& value);
 	void setAttribute (const std::string& name, std::string&& value);
 	void setAttribute (std::string&& name, std::string&& value);
+	/** set the value of another attribute including its already parsed typed form */
+	void setAttributeValue (const std::string& name, const UIAttributeValue& value);
 	void removeAttribute (const std::string& name);
 
 	void setBooleanAttribute (const std::string& name, bool value);
@@ -53,6 +134,9 @@ public:
 	void setRectAttribute (const std::string& name, const CRect& r);
 	bool getRectAttribute (const std::string& name, CRect& r) const;
 
+	/** only literal colors in the form #RRGGBB or #RRGGBBAA, named colors need the description */
+	bool getColorAttribute (const std::string& name, CColor& c) const;
+
 	void setStringArrayAttribute (const std::string& name, const StringArray& values);
 	bool getStringArrayAttribute (const std::string& name, StringArray& values) const;
 	
@@ -62,6 +146,14 @@ public:
 
 	bool store (OutputStream& stream) const;
 	bool restore (InputStream& stream);
+
+private:
+	using TypedType = UIAttributeValue::TypedType;
+
+	template<typename ParseProc>
+	bool getTypedValue (const std::string& name, TypedType type, ParseProc proc,
+						double (&values)[4]) const;
+	void setTypedValue (const std::string& name, TypedType type, double value);
 };
 
 }
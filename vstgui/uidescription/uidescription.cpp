@@ -28,6 +28,10 @@
 #include <algorithm>
 #include <cassert>
 #include <deque>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <mutex>
 
 namespace VSTGUI {
 
@@ -133,7 +137,12 @@ public:
 	void sortChildren ();
 	virtual void freePlatformResources () {}
 
+	/** copy of this node and all its children, the created platform resources are shared */
+	UINode* deepCopy () const;
+
 protected:
+	virtual UINode* copy () const { return new UINode (*this); }
+
 	std::string name;
 	DataStorage data;
 	SharedPointer<UIAttributes> attributes;
@@ -146,6 +155,8 @@ class UICommentNode : public UINode
 {
 public:
 	explicit UICommentNode (const std::string& comment);
+protected:
+	UINode* copy () const override { return new UICommentNode (*this); }
 };
 
 //-----------------------------------------------------------------------------
@@ -165,6 +176,8 @@ public:
 	const std::string& getString () const;
 
 protected:
+	UINode* copy () const override { return new UIVariableNode (*this); }
+
 	Type type;
 	double number;
 };
@@ -181,6 +194,8 @@ public:
 	void setTagString (const std::string& str);
 	
 protected:
+	UINode* copy () const override { return new UIControlTagNode (*this); }
+
 	int32_t tag;
 };
 
@@ -189,6 +204,7 @@ class UIBitmapNode : public UINode
 {
 public:
 	UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
+	UIBitmapNode (const UIBitmapNode& n);
 	CBitmap* getBitmap (const std::string& pathHint);
 	void setBitmap (UTF8StringPtr bitmapName);
 	void setNinePartTiledOffset (const CRect* offsets);
@@ -204,6 +220,7 @@ public:
 	void freePlatformResources () override;
 protected:
 	~UIBitmapNode () noexcept override;
+	UINode* copy () const override { return new UIBitmapNode (*this); }
 	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc) const;
 	SharedPointer<IPlatformBitmap> createBitmapFromDataNode () const;
 	static bool imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2);
@@ -211,6 +228,7 @@ protected:
 	CBitmap* bitmap;
 	bool filterProcessed;
 	bool scaledBitmapsAdded;
+	bool bitmapShared;
 };
 
 //-----------------------------------------------------------------------------
@@ -218,6 +236,7 @@ class UIFontNode : public UINode
 {
 public:
 	UIFontNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
+	UIFontNode (const UIFontNode& n);
 	CFontRef getFont ();
 	void setFont (CFontRef newFont);
 	void setAlternativeFontNames (UTF8StringPtr fontNames);
@@ -226,6 +245,7 @@ public:
 	void freePlatformResources () override;
 protected:
 	~UIFontNode () noexcept override;
+	UINode* copy () const override { return new UIFontNode (*this); }
 	CFontRef font;
 };
 
@@ -237,6 +257,7 @@ public:
 	const CColor& getColor () const { return color; }
 	void setColor (const CColor& newColor);
 protected:
+	UINode* copy () const override { return new UIColorNode (*this); }
 	CColor color;
 };
 
@@ -250,6 +271,7 @@ public:
 
 	void freePlatformResources () override;
 protected:
+	UINode* copy () const override { return new UIGradientNode (*this); }
 	SharedPointer<CGradient> gradient;
 	
 };
@@ -406,7 +428,9 @@ public:
 	bool write (OutputStream& stream, UINode* rootNode);
 protected:
 	static void encodeAttributeString (std::string& str);
+	static void writeString (const char* str, OutputStream& stream);
 
+	void writeIndentation (OutputStream& stream) const;
 	bool writeNode (UINode* node, OutputStream& stream);
 	bool writeComment (UICommentNode* node, OutputStream& stream);
 	bool writeNodeData (UINode::DataStorage& str, OutputStream& stream);
@@ -418,10 +442,25 @@ protected:
 bool UIDescWriter::write (OutputStream& stream, UINode* rootNode)
 {
 	intendLevel = 0;
-	stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	writeString ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n", stream);
 	return writeNode (rootNode, stream);
 }
 
+//-----------------------------------------------------------------------------
+void UIDescWriter::writeString (const char* str, OutputStream& stream)
+{
+	stream.writeRaw (str, static_cast<uint32_t> (strlen (str)));
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::writeIndentation (OutputStream& stream) const
+{
+	static const char tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+	constexpr int32_t numTabs = sizeof (tabs) - 1;
+	for (int32_t remaining = intendLevel; remaining > 0; remaining -= numTabs)
+		stream.writeRaw (tabs, static_cast<uint32_t> (std::min (remaining, numTabs)));
+}
+
 //-----------------------------------------------------------------------------
 void UIDescWriter::encodeAttributeString (std::string& str)
 {
@@ -444,19 +483,25 @@ void UIDescWriter::encodeAttributeString (std::string& str)
 bool UIDescWriter::writeAttributes (UIAttributes* attr, OutputStream& stream)
 {
 	bool result = true;
-	using SortedAttributes = std::map<std::string,std::string>;
-	SortedAttributes sortedAttributes (attr->begin (), attr->end ());
+	using SortedAttributes = std::vector<UIAttributes::const_iterator>;
+	SortedAttributes sortedAttributes;
+	for (auto it = attr->begin (); it != attr->end (); ++it)
+		sortedAttributes.emplace_back (it);
+	std::sort (sortedAttributes.begin (), sortedAttributes.end (),
+			   [] (const UIAttributes::const_iterator& lhs,
+				   const UIAttributes::const_iterator& rhs) { return lhs->first < rhs->first; });
+	std::string value;
 	for (auto& sa : sortedAttributes)
 	{
-		if (sa.second.length () > 0)
+		if (sa->second.length () > 0)
 		{
-			stream << " ";
-			stream << sa.first;
-			stream << "=\"";
-			std::string value (sa.second);
+			writeString (" ", stream);
+			stream << sa->first;
+			writeString ("=\"", stream);
+			value = sa->second;
 			encodeAttributeString (value);
 			stream << value;
-			stream << "\"";
+			writeString ("\"", stream);
 		}
 	}
 	return result;
@@ -465,28 +510,28 @@ bool UIDescWriter::writeAttributes (UIAttributes* attr, OutputStream& stream)
 //-----------------------------------------------------------------------------
 bool UIDescWriter::writeNodeData (UINode::DataStorage& str, OutputStream& stream)
 {
-	for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-	uint32_t i = 0;
-	for (auto c : str)
+	static constexpr size_t kLineLength = 82;
+	writeIndentation (stream);
+	for (size_t pos = 0; pos < str.size (); pos += kLineLength)
 	{
-		stream << static_cast<int8_t> (c);
-		if (i++ > 80)
+		auto lineLength = std::min (kLineLength, str.size () - pos);
+		stream.writeRaw (str.data () + pos, static_cast<uint32_t> (lineLength));
+		if (lineLength == kLineLength)
 		{
-			stream << "\n";
-			i = 0;
-			for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
+			writeString ("\n", stream);
+			writeIndentation (stream);
 		}
 	}
-	stream << "\n";
+	writeString ("\n", stream);
 	return true;
 }
 
 //-----------------------------------------------------------------------------
 bool UIDescWriter::writeComment (UICommentNode* node, OutputStream& stream)
 {
-	stream << "<!--";
+	writeString ("<!--", stream);
 	stream << node->getData ();
-	stream << "-->\n";
+	writeString ("-->\n", stream);
 	return true;
 }
 
@@ -496,12 +541,12 @@ bool UIDescWriter::writeNode (UINode* node, OutputStream& stream)
 	bool result = true;
 	if (node->noExport ())
 		return result;
-	for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
+	writeIndentation (stream);
 	if (UICommentNode* commentNode = dynamic_cast<UICommentNode*> (node))
 	{
 		return writeComment (commentNode, stream);
 	}
-	stream << "<";
+	writeString ("<", stream);
 	stream << node->getName ();
 	result = writeAttributes (node->getAttributes (), stream);
 	if (result)
@@ -509,7 +554,7 @@ bool UIDescWriter::writeNode (UINode* node, OutputStream& stream)
 		UIDescList& children = node->getChildren ();
 		if (!children.empty ())
 		{
-			stream << ">\n";
+			writeString (">\n", stream);
 			intendLevel++;
 			if (!node->getData ().empty ())
 				result = writeNodeData (node->getData (), stream);
@@ -519,24 +564,24 @@ bool UIDescWriter::writeNode (UINode* node, OutputStream& stream)
 					return false;
 			}
 			intendLevel--;
-			for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-			stream << "</";
+			writeIndentation (stream);
+			writeString ("</", stream);
 			stream << node->getName ();
-			stream << ">\n";
+			writeString (">\n", stream);
 		}
 		else if (!node->getData ().empty ())
 		{
-			stream << ">\n";
+			writeString (">\n", stream);
 			intendLevel++;
 			result = writeNodeData (node->getData (), stream);
 			intendLevel--;
-			for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-			stream << "</";
+			writeIndentation (stream);
+			writeString ("</", stream);
 			stream << node->getName ();
-			stream << ">\n";
+			writeString (">\n", stream);
 		}
 		else
-			stream << "/>\n";
+			writeString ("/>\n", stream);
 	}
 	return result;
 }
@@ -658,6 +703,207 @@ static std::string removeScaleFactorFromName (const std::string& name)
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+/** calls proc (index) for all indices in [0, count) on the calling thread and on worker threads
+ *
+ *	Worker threads are only used when every thread gets at least minCountPerThread indices.
+ *	Returns after all indices were processed.
+ */
+template<typename Proc>
+void parallelFor (size_t count, size_t minCountPerThread, Proc proc)
+{
+	auto numThreads = std::min<size_t> (std::thread::hardware_concurrency (), count / minCountPerThread);
+	std::atomic<size_t> nextIndex {0};
+	auto work = [&] () {
+		size_t index;
+		while ((index = nextIndex++) < count)
+			proc (index);
+	};
+	std::vector<std::thread> workers;
+	if (numThreads > 1)
+	{
+		workers.reserve (numThreads - 1);
+		try
+		{
+			while (workers.size () < numThreads - 1)
+				workers.emplace_back (work);
+		}
+		catch (...)
+		{
+			// fewer threads than wanted, the remaining work is done by the running ones
+		}
+	}
+	work ();
+	for (auto& worker : workers)
+		worker.join ();
+}
+
+//-----------------------------------------------------------------------------
+/** parses the attribute into its typed form so that the view creators don't need to parse it */
+static void parseTypedAttribute (const UIAttributes& attributes, const std::string& name,
+                                 IViewCreator::AttrType type)
+{
+	switch (type)
+	{
+		case IViewCreator::kBooleanType:
+		{
+			bool value;
+			attributes.getBooleanAttribute (name, value);
+			break;
+		}
+		case IViewCreator::kIntegerType:
+		{
+			int32_t value;
+			attributes.getIntegerAttribute (name, value);
+			break;
+		}
+		case IViewCreator::kFloatType:
+		{
+			double value;
+			attributes.getDoubleAttribute (name, value);
+			break;
+		}
+		case IViewCreator::kPointType:
+		{
+			CPoint value;
+			attributes.getPointAttribute (name, value);
+			break;
+		}
+		case IViewCreator::kRectType:
+		{
+			CRect value;
+			attributes.getRectAttribute (name, value);
+			break;
+		}
+		case IViewCreator::kColorType:
+		{
+			CColor value;
+			attributes.getColorAttribute (name, value);
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+struct ViewNodePreparation
+{
+	const UIAttributes* attributes;
+	const std::string* viewClass;
+	std::vector<const std::string*> bitmapNames;
+	std::vector<const std::string*> fontNames;
+};
+
+//-----------------------------------------------------------------------------
+/** process wide registry of parsed description trees
+ *
+ *	Descriptions which parse the same content share one tree and with it all bitmaps, fonts and
+ *	gradients created from it. An entry is removed when its last user releases it. A description
+ *	which gets modified releases its entry and continues with its own copy of the tree.
+ *
+ *	The registry is thread-safe, the shared trees are not, so all descriptions sharing a tree must
+ *	be used from the same thread.
+ */
+class SharedNodesRegistry
+{
+public:
+	static SharedNodesRegistry& instance ()
+	{
+		static SharedNodesRegistry gInstance;
+		return gInstance;
+	}
+
+	static std::string makeKey (const std::string& path, const std::vector<int8_t>& content,
+	                            bool usesSharedResources)
+	{
+		// FNV-1a
+		uint64_t hash = 14695981039346656037ull;
+		for (auto c : content)
+		{
+			hash ^= static_cast<uint8_t> (c);
+			hash *= 1099511628211ull;
+		}
+		std::ostringstream key;
+		key << path << '\n' << content.size () << ':' << std::hex << hash;
+		if (usesSharedResources)
+			key << ":shared-resources";
+		return key.str ();
+	}
+
+	/** returns the tree for key and counts the caller as user, nullptr if there is none */
+	SharedPointer<UINode> acquire (const std::string& key)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		auto it = entries.find (key);
+		if (it == entries.end ())
+			return nullptr;
+		++it->second.useCount;
+		return it->second.nodes;
+	}
+
+	/** adds the tree for key, if another caller added one in the meantime that one is returned */
+	SharedPointer<UINode> add (const std::string& key, const SharedPointer<UINode>& nodes)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		auto& entry = entries[key];
+		if (!entry.nodes)
+			entry.nodes = nodes;
+		++entry.useCount;
+		return entry.nodes;
+	}
+
+	/** returns true if the caller was the last user of the tree */
+	bool release (const std::string& key)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		auto it = entries.find (key);
+		if (it == entries.end ())
+			return true;
+		if (--it->second.useCount > 0)
+			return false;
+		entries.erase (it);
+		return true;
+	}
+
+	uint32_t getUseCount (const std::string& key) const
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		auto it = entries.find (key);
+		return it == entries.end () ? 0 : it->second.useCount;
+	}
+
+private:
+	struct Entry
+	{
+		SharedPointer<UINode> nodes;
+		uint32_t useCount {0};
+	};
+
+	mutable std::mutex mutex;
+	std::unordered_map<std::string, Entry> entries;
+};
+
+//-----------------------------------------------------------------------------
+static bool readContent (Xml::IContentProvider& provider, std::vector<int8_t>& content)
+{
+	static const uint32_t kBufferSize = 0x8000;
+
+	provider.rewind ();
+	uint32_t bytesRead;
+	do
+	{
+		auto size = content.size ();
+		content.resize (size + kBufferSize);
+		bytesRead = provider.readRawXmlData (content.data () + size, kBufferSize);
+		if (bytesRead == kStreamIOError)
+			bytesRead = 0;
+		content.resize (size + bytesRead);
+	} while (bytesRead > 0);
+	provider.rewind ();
+	return !content.empty ();
+}
+
 } // UIDescriptionPrivate
 
 IdStringPtr IUIDescription::kCustomViewName = "custom-view-name";
@@ -680,6 +926,10 @@ struct UIDescription::Impl
 	std::deque<UINode*> nodeStack;
 	
 	bool restoreViewsMode {false};
+	mutable uint32_t viewCreationDepth {0};
+
+	/** key of the shared tree in the SharedNodesRegistry, empty if the tree is not shared */
+	std::string sharedNodesKey;
 
 	Optional<UINode*> variableBaseNode;
 
@@ -693,6 +943,31 @@ struct UIDescription::Impl
 		return *variableBaseNode;
 	}
 
+	/** must be called before the tree is modified */
+	void makeNodesUnique ()
+	{
+		if (sharedNodesKey.empty ())
+			return;
+		if (!UIDescriptionPrivate::SharedNodesRegistry::instance ().release (sharedNodesKey))
+		{
+			nodes = owned (nodes->deepCopy ());
+			variableBaseNode.reset ();
+		}
+		sharedNodesKey.clear ();
+	}
+
+	bool nodesSharedWithOthers () const
+	{
+		return !sharedNodesKey.empty () &&
+		       UIDescriptionPrivate::SharedNodesRegistry::instance ().getUseCount (sharedNodesKey) > 1;
+	}
+
+	~Impl () noexcept
+	{
+		if (!sharedNodesKey.empty ())
+			UIDescriptionPrivate::SharedNodesRegistry::instance ().release (sharedNodesKey);
+	}
+
 	DispatchList<UIDescriptionListener*> listeners;
 };
 
@@ -726,6 +1001,7 @@ UIDescription::~UIDescription () noexcept
 //------------------------------------------------------------------------
 void UIDescription::setFilePath (UTF8StringPtr path)
 {
+	impl->makeNodesUnique ();
 	impl->filePath = path;
 	impl->xmlFile.u.name = impl->filePath.data (); // make sure that xmlFile.u.name points to valid memory
 }
@@ -833,14 +1109,10 @@ bool UIDescription::parse ()
 {
 	if (parsed ())
 		return true;
-	Xml::Parser parser;
+	std::vector<int8_t> content;
 	if (impl->xmlContentProvider)
 	{
-		if (parser.parse (impl->xmlContentProvider, this))
-		{
-			addDefaultNodes ();
-			return true;
-		}
+		UIDescriptionPrivate::readContent (*impl->xmlContentProvider, content);
 	}
 	else
 	{
@@ -848,11 +1120,7 @@ bool UIDescription::parse ()
 		if (resInputStream.open (impl->xmlFile))
 		{
 			Xml::InputStreamContentProvider contentProvider (resInputStream);
-			if (parser.parse (&contentProvider, this))
-			{
-				addDefaultNodes ();
-				return true;
-			}
+			UIDescriptionPrivate::readContent (contentProvider, content);
 		}
 		else if (impl->xmlFile.type == CResourceDescription::kStringType)
 		{
@@ -860,14 +1128,35 @@ bool UIDescription::parse ()
 			if (fileStream.open (impl->xmlFile.u.name, CFileStream::kReadMode))
 			{
 				Xml::InputStreamContentProvider contentProvider (fileStream);
-				if (parser.parse (&contentProvider, this))
-				{
-					addDefaultNodes ();
-					return true;
-				}
+				UIDescriptionPrivate::readContent (contentProvider, content);
 			}
 		}
 	}
+	if (!content.empty ())
+	{
+		// the file path is part of the key as bitmaps are searched relative to it
+		std::string path = impl->filePath;
+		if (path.empty () && impl->xmlFile.type == CResourceDescription::kIntegerType)
+			path = "#" + std::to_string (impl->xmlFile.u.id);
+		auto& registry = UIDescriptionPrivate::SharedNodesRegistry::instance ();
+		auto key = registry.makeKey (path, content, impl->sharedResources != nullptr);
+		if (auto nodes = registry.acquire (key))
+		{
+			impl->nodes = nodes;
+			impl->sharedNodesKey = key;
+			return true;
+		}
+		Xml::MemoryContentProvider contentProvider (content.data (),
+		                                            static_cast<uint32_t> (content.size ()));
+		Xml::Parser parser;
+		if (parser.parse (&contentProvider, this))
+		{
+			addDefaultNodes ();
+			impl->nodes = registry.add (key, impl->nodes);
+			impl->sharedNodesKey = key;
+			return true;
+		}
+	}
 	if (!impl->nodes)
 	{
 		impl->nodes = makeOwned<UINode> ("vstgui-ui-description");
@@ -897,6 +1186,7 @@ const IViewFactory* UIDescription::getViewFactory () const
 //-----------------------------------------------------------------------------
 void UIDescription::registerListener (UIDescriptionListener* listener)
 {
+	impl->makeNodesUnique ();
 	impl->listeners.add (listener);
 }
 
@@ -909,6 +1199,7 @@ void UIDescription::unregisterListener (UIDescriptionListener* listener)
 //-----------------------------------------------------------------------------
 void UIDescription::setBitmapCreator (IBitmapCreator* creator)
 {
+	impl->makeNodesUnique ();
 	impl->bitmapCreator = creator;
 }
 
@@ -925,7 +1216,8 @@ static void FreeNodePlatformResources (UINode* node)
 //-----------------------------------------------------------------------------
 void UIDescription::freePlatformResources ()
 {
-	if (impl->nodes)
+	// the resources are still in use by the other descriptions sharing the tree
+	if (impl->nodes && !impl->nodesSharedWithOthers ())
 		FreeNodePlatformResources (impl->nodes);
 }
 
@@ -1007,6 +1299,7 @@ bool UIDescription::save (UTF8StringPtr filename, int32_t flags)
 //-----------------------------------------------------------------------------
 bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
 {
+	impl->makeNodesUnique ();
 	impl->listeners.forEach ([this] (UIDescriptionListener* l) {
 		l->beforeUIDescSave (this);
 	});
@@ -1032,12 +1325,13 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
 	
 	BufferedOutputStream bufferedStream (stream);
 	UIDescWriter writer;
-	return writer.write (bufferedStream, impl->nodes);
+	return writer.write (bufferedStream, impl->nodes) && bufferedStream.flush ();
 }
 
 //-----------------------------------------------------------------------------
 void UIDescription::setSharedResources (const SharedPointer<UIDescription>& resources)
 {
+	impl->makeNodesUnique ();
 	impl->sharedResources = resources;
 }
 
@@ -1151,8 +1445,9 @@ bool UIDescription::storeViews (const std::list<CView*>& views, OutputStream& st
 			customData->remember ();
 		}
 		UINode baseNode ("vstgui-ui-description-view-list", nodeList);
+		BufferedOutputStream bufferedStream (stream);
 		UIDescWriter writer;
-		return writer.write (stream, &baseNode);
+		return writer.write (bufferedStream, &baseNode) && bufferedStream.flush ();
 	}
 	return false;
 }
@@ -1304,6 +1599,124 @@ CView* UIDescription::createViewFromNode (UINode* node) const
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+/** prepares the data the view creation of a template needs
+ *
+ *	The view tree of a template is created in two phases. This is the first phase, it parses the
+ *	typed attributes of all view nodes of the template and the templates it references and
+ *	decodes the bitmaps they use. This is pure data work and is done on worker threads. Every
+ *	worker only touches the attributes of the nodes it got, so no locking is needed.
+ *	The second phase is createViewFromNode which creates the views and calls the controller on
+ *	the calling thread in the same order as before, it now finds the parsed values and bitmaps.
+ */
+void UIDescription::prepareViewCreation (UINode* templateNode) const
+{
+	using UIDescriptionPrivate::ViewNodePreparation;
+	using UIDescriptionPrivate::parallelFor;
+
+	// view nodes per worker thread, parsing the attributes of fewer nodes is not worth a thread
+	static constexpr size_t kMinViewNodesPerThread = 32;
+
+	auto viewFactory = dynamic_cast<UIViewFactory*> (impl->viewFactory);
+	if (viewFactory == nullptr)
+		return;
+
+	static const std::string kDefaultViewClass ("CViewContainer");
+	auto findTemplate = [this] (const std::string& name) -> UINode* {
+		for (const auto& node : impl->nodes->getChildren ())
+		{
+			if (node->getName () != MainNodeNames::kTemplate)
+				continue;
+			const std::string* nodeName = node->getAttributes ()->getAttributeValue ("name");
+			if (nodeName && *nodeName == name)
+				return node;
+		}
+		return nullptr;
+	};
+	auto viewClassOf = [] (UINode* node) {
+		auto viewClass = node->getAttributes ()->getAttributeValue (UIViewCreator::kAttrClass);
+		return viewClass ? viewClass : &kDefaultViewClass;
+	};
+
+	// collect the unique view nodes, following template references
+	std::vector<ViewNodePreparation> viewNodes;
+	std::unordered_set<UINode*> visited;
+	std::vector<UINode*> stack {templateNode};
+	visited.insert (templateNode);
+	while (!stack.empty ())
+	{
+		auto node = stack.back ();
+		stack.pop_back ();
+		auto viewClass = viewClassOf (node);
+		if (auto templateName = node->getAttributes ()->getAttributeValue (MainNodeNames::kTemplate))
+		{
+			if (auto referencedNode = findTemplate (*templateName))
+			{
+				viewClass = viewClassOf (referencedNode);
+				if (visited.insert (referencedNode).second)
+					stack.emplace_back (referencedNode);
+			}
+		}
+		else
+		{
+			for (const auto& child : node->getChildren ())
+			{
+				if (child->getName () == "view" && visited.insert (child).second)
+					stack.emplace_back (child);
+			}
+		}
+		viewNodes.push_back ({node->getAttributes (), viewClass, {}, {}});
+	}
+
+	// phase 1a: parse the typed attributes and find the used resources
+	parallelFor (viewNodes.size (), kMinViewNodesPerThread, [&] (size_t index) {
+		auto& viewNode = viewNodes[index];
+		for (const auto& attr : *viewNode.attributes)
+		{
+			auto type = viewFactory->getAttributeType (*viewNode.viewClass, attr.first);
+			if (type == IViewCreator::kBitmapType)
+				viewNode.bitmapNames.emplace_back (&attr.second);
+			else if (type == IViewCreator::kFontType)
+				viewNode.fontNames.emplace_back (&attr.second);
+			else
+				UIDescriptionPrivate::parseTypedAttribute (*viewNode.attributes, attr.first, type);
+		}
+	});
+
+	// the resource nodes are looked up here, getBaseNode may add nodes
+	std::unordered_set<std::string> bitmapNames;
+	for (auto& viewNode : viewNodes)
+	{
+		for (auto bitmapName : viewNode.bitmapNames)
+			bitmapNames.insert (*bitmapName);
+		for (auto fontName : viewNode.fontNames)
+			getFont (fontName->c_str ());
+	}
+	if (bitmapNames.empty ())
+		return;
+	std::vector<UIBitmapNode*> bitmapNodes;
+	for (auto& node : getBaseNode (MainNodeNames::kBitmap)->getChildren ())
+	{
+		auto bitmapNode = dynamic_cast<UIBitmapNode*> (node);
+		auto name = node->getAttributes ()->getAttributeValue ("name");
+		if (bitmapNode == nullptr || name == nullptr)
+			continue;
+		// the scaled versions of a bitmap are added to it when it is first used
+		if (bitmapNames.count (*name) ||
+		    bitmapNames.count (UIDescriptionPrivate::removeScaleFactorFromName (*name)))
+			bitmapNodes.emplace_back (bitmapNode);
+	}
+
+	// phase 1b: decode the bitmaps, filters and the bitmap creator are applied by getBitmap later
+#if WINDOWS
+	// WIC needs COM to be initialized on the decoding thread, so the bitmaps are decoded on demand
+#else
+	parallelFor (bitmapNodes.size (), 1, [&] (size_t index) {
+		bitmapNodes[index]->getBitmap (impl->filePath);
+	});
+#endif
+}
+
 //-----------------------------------------------------------------------------
 CViewAttributeID UIDescription::kTemplateNameAttributeID = 'uitl';
 
@@ -1320,7 +1733,10 @@ CView* UIDescription::createView (UTF8StringPtr name, IController* _controller)
 				const std::string* nodeName = itNode->getAttributes ()->getAttributeValue ("name");
 				if (nodeName && *nodeName == name)
 				{
+					if (impl->viewCreationDepth++ == 0)
+						prepareViewCreation (itNode);
 					CView* view = createViewFromNode (itNode);
+					--impl->viewCreationDepth;
 					if (view)
 						view->setAttribute (kTemplateNameAttributeID, static_cast<uint32_t> (strlen (name) + 1), name);
 					return view;
@@ -1710,6 +2126,7 @@ UTF8StringPtr UIDescription::lookupControlTagName (const int32_t tag) const
 template<typename NodeType>
 void UIDescription::changeNodeName (UTF8StringPtr oldName, UTF8StringPtr newName, IdStringPtr mainNodeName)
 {
+	impl->makeNodesUnique ();
 	UINode* mainNode = getBaseNode (mainNodeName);
 	NodeType* node = dynamic_cast<NodeType*> (findChildNodeByNameAttribute(mainNode, oldName));
 	if (node)
@@ -1768,6 +2185,7 @@ void UIDescription::changeGradientName (UTF8StringPtr oldName, UTF8StringPtr new
 //-----------------------------------------------------------------------------
 void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 {
+	impl->makeNodesUnique ();
 	UINode* colorsNode = getBaseNode (MainNodeNames::kColor);
 	UIColorNode* node = dynamic_cast<UIColorNode*> (findChildNodeByNameAttribute (colorsNode, name));
 	if (node)
@@ -1802,6 +2220,7 @@ void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 //-----------------------------------------------------------------------------
 void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 {
+	impl->makeNodesUnique ();
 	UINode* fontsNode = getBaseNode (MainNodeNames::kFont);
 	UIFontNode* node = dynamic_cast<UIFontNode*> (findChildNodeByNameAttribute (fontsNode, name));
 	if (node)
@@ -1834,6 +2253,7 @@ void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 //-----------------------------------------------------------------------------
 void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 {
+	impl->makeNodesUnique ();
 	UINode* gradientsNode = getBaseNode (MainNodeNames::kGradient);
 	UIGradientNode* node = dynamic_cast<UIGradientNode*> (findChildNodeByNameAttribute (gradientsNode, name));
 	if (node)
@@ -1866,6 +2286,7 @@ void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, const CRect* nineparttiledOffset)
 {
+	impl->makeNodesUnique ();
 	UINode* bitmapsNode = getBaseNode (MainNodeNames::kBitmap);
 	UIBitmapNode* node = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, name));
 	if (node)
@@ -1901,6 +2322,7 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::list<SharedPointer<UIAttributes> >& filters)
 {
+	impl->makeNodesUnique ();
 	UIBitmapNode* bitmapNode = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kBitmap), bitmapName));
 	if (bitmapNode)
 	{
@@ -1982,6 +2404,7 @@ static void removeChildNode (UINode* baseNode, UTF8StringPtr nodeName)
 //-----------------------------------------------------------------------------
 void UIDescription::removeNode (UTF8StringPtr name, IdStringPtr mainNodeName)
 {
+	impl->makeNodesUnique ();
 	UINode* node = getBaseNode (mainNodeName);
 	if (node)
 	{
@@ -2037,6 +2460,7 @@ void UIDescription::removeGradient (UTF8StringPtr name)
 //-----------------------------------------------------------------------------
 void UIDescription::changeAlternativeFontNames (UTF8StringPtr name, UTF8StringPtr alternativeFonts)
 {
+	impl->makeNodesUnique ();
 	UIFontNode* node = dynamic_cast<UIFontNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kFont), name));
 	if (node)
 	{
@@ -2200,6 +2624,7 @@ bool UIDescription::updateAttributesForView (UINode* node, CView* view, bool dee
 //-----------------------------------------------------------------------------
 void UIDescription::updateViewDescription (UTF8StringPtr name, CView* view)
 {
+	impl->makeNodesUnique ();
 #if VSTGUI_LIVE_EDITING
 	bool doIt = true;
 	impl->listeners.forEach ([&] (UIDescriptionListener* l) {
@@ -2238,6 +2663,7 @@ void UIDescription::updateViewDescription (UTF8StringPtr name, CView* view)
 //-----------------------------------------------------------------------------
 bool UIDescription::addNewTemplate (UTF8StringPtr name, const SharedPointer<UIAttributes>& attr)
 {
+	impl->makeNodesUnique ();
 #if VSTGUI_LIVE_EDITING
 	vstgui_assert (impl->nodes);
 	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
@@ -2258,6 +2684,7 @@ bool UIDescription::addNewTemplate (UTF8StringPtr name, const SharedPointer<UIAt
 //-----------------------------------------------------------------------------
 bool UIDescription::removeTemplate (UTF8StringPtr name)
 {
+	impl->makeNodesUnique ();
 #if VSTGUI_LIVE_EDITING
 	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
 	if (templateNode)
@@ -2275,6 +2702,7 @@ bool UIDescription::removeTemplate (UTF8StringPtr name)
 //-----------------------------------------------------------------------------
 bool UIDescription::changeTemplateName (UTF8StringPtr name, UTF8StringPtr newName)
 {
+	impl->makeNodesUnique ();
 #if VSTGUI_LIVE_EDITING
 	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
 	if (templateNode)
@@ -2292,6 +2720,7 @@ bool UIDescription::changeTemplateName (UTF8StringPtr name, UTF8StringPtr newNam
 //-----------------------------------------------------------------------------
 bool UIDescription::duplicateTemplate (UTF8StringPtr name, UTF8StringPtr duplicateName)
 {
+	impl->makeNodesUnique ();
 #if VSTGUI_LIVE_EDITING
 	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
 	if (templateNode)
@@ -2315,6 +2744,7 @@ bool UIDescription::duplicateTemplate (UTF8StringPtr name, UTF8StringPtr duplica
 //-----------------------------------------------------------------------------
 bool UIDescription::setCustomAttributes (UTF8StringPtr name, const SharedPointer<UIAttributes>& attr)
 {
+	impl->makeNodesUnique ();
 	UINode* customNode = findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kCustom), name);
 	if (customNode)
 		return false;
@@ -2336,6 +2766,8 @@ SharedPointer<UIAttributes> UIDescription::getCustomAttributes (UTF8StringPtr na
 //-----------------------------------------------------------------------------
 SharedPointer<UIAttributes> UIDescription::getCustomAttributes (UTF8StringPtr name, bool create)
 {
+	// callers modify the returned attributes
+	impl->makeNodesUnique ();
 	auto attributes = getCustomAttributes (name);
 	if (attributes)
 		return attributes;
@@ -2366,6 +2798,7 @@ UIDescription::FocusDrawing UIDescription::getFocusDrawingSettings () const
 //-----------------------------------------------------------------------------
 void UIDescription::setFocusDrawingSettings (const FocusDrawing& fd)
 {
+	impl->makeNodesUnique ();
 	auto attributes = getCustomAttributes ("FocusDrawing", true);
 	if (!attributes)
 		return;
@@ -2393,6 +2826,7 @@ bool UIDescription::getControlTagString (UTF8StringPtr tagName, std::string& tag
 //-----------------------------------------------------------------------------
 bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::string& newTagString, bool create)
 {
+	impl->makeNodesUnique ();
 	UINode* tagsNode = getBaseNode (MainNodeNames::kControlTag);
 	UIControlTagNode* controlTagNode = dynamic_cast<UIControlTagNode*> (findChildNodeByNameAttribute (tagsNode, tagName));
 	if (controlTagNode)
@@ -3007,6 +3441,19 @@ void UINode::sortChildren ()
 	children->sort ();
 }
 
+//-----------------------------------------------------------------------------
+UINode* UINode::deepCopy () const
+{
+	auto result = copy ();
+	if (dynamic_cast<UIDescListWithFastFindAttributeNameChild*> (children.get ()))
+		result->children = makeOwned<UIDescListWithFastFindAttributeNameChild> ();
+	else
+		result->children = makeOwned<UIDescList> ();
+	for (auto& child : *children)
+		result->children->add (child->deepCopy ());
+	return result;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -3143,7 +3590,28 @@ UIBitmapNode::UIBitmapNode (const std::string& name, const SharedPointer<UIAttri
 , bitmap (nullptr)
 , filterProcessed (false)
 , scaledBitmapsAdded (false)
+, bitmapShared (false)
+{
+}
+
+//-----------------------------------------------------------------------------
+UIBitmapNode::UIBitmapNode (const UIBitmapNode& n)
+: UINode (n)
+, bitmap (nullptr)
+, filterProcessed (false)
+, scaledBitmapsAdded (false)
+, bitmapShared (false)
 {
+	// only a finished bitmap is shared, otherwise both nodes would add filters, scaled bitmaps or
+	// platform bitmaps to it
+	if (n.bitmap && n.bitmap->getPlatformBitmap () && n.filterProcessed && n.scaledBitmapsAdded)
+	{
+		bitmap = n.bitmap;
+		bitmap->remember ();
+		filterProcessed = true;
+		scaledBitmapsAdded = true;
+		bitmapShared = true;
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -3159,6 +3627,7 @@ void UIBitmapNode::freePlatformResources ()
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
+	bitmapShared = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -3229,10 +3698,16 @@ void UIBitmapNode::createXMLData (const std::string& pathHint)
 				auto buffer = IPlatformBitmap::createMemoryPNGRepresentation (platformBitmap);
 				if (!buffer.empty ())
 				{
-					auto result = Base64Codec::encode (buffer.data(), static_cast<uint32_t> (buffer.size ()));
 					UINode* dataNode = new UINode ("data");
 					dataNode->getAttributes ()->setAttribute ("encoding", "base64");
-					dataNode->getData ().append (reinterpret_cast<const char*> (result.data.get ()), static_cast<std::streamsize> (result.dataSize));
+					auto& data = dataNode->getData ();
+					data.reserve (data.size () + Base64Codec::encodedSize (buffer.size ()));
+					auto writeProc = [&] (const uint8_t* encoded, size_t size) {
+						data.append (reinterpret_cast<const char*> (encoded), size);
+					};
+					Base64Codec::Encoder encoder;
+					encoder.add (buffer.data (), buffer.size (), writeProc);
+					encoder.finish (writeProc);
 					getChildren ().add (dataNode);
 				}
 			}
@@ -3337,6 +3812,7 @@ void UIBitmapNode::setBitmap (UTF8StringPtr bitmapName)
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
+	bitmapShared = false;
 	double scaleFactor = 1.;
 	if (UIDescriptionPrivate::decodeScaleFactorFromName (bitmapName, scaleFactor))
 		attributes->setDoubleAttribute ("scale-factor", scaleFactor);
@@ -3349,10 +3825,15 @@ void UIBitmapNode::setNinePartTiledOffset (const CRect* offsets)
 	if (bitmap)
 	{
 		CNinePartTiledBitmap* tiledBitmap = dynamic_cast<CNinePartTiledBitmap*> (bitmap);
-		if (offsets && tiledBitmap)
+		if (offsets && tiledBitmap && !bitmapShared)
 		{
 			tiledBitmap->setPartOffsets (CNinePartTiledDescription (offsets->left, offsets->top, offsets->right, offsets->bottom));
 		}
+		else if (bitmapShared)
+		{
+			invalidBitmap ();
+			scaledBitmapsAdded = false;
+		}
 		else
 		{
 			bitmap->forget ();
@@ -3372,6 +3853,7 @@ void UIBitmapNode::invalidBitmap ()
 		bitmap->forget ();
 	bitmap = nullptr;
 	filterProcessed = false;
+	bitmapShared = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -3383,6 +3865,15 @@ UIFontNode::UIFontNode (const std::string& name, const SharedPointer<UIAttribute
 {
 }
 
+//-----------------------------------------------------------------------------
+UIFontNode::UIFontNode (const UIFontNode& n)
+: UINode (n)
+, font (n.font)
+{
+	if (font)
+		font->remember ();
+}
+
 //-----------------------------------------------------------------------------
 UIFontNode::~UIFontNode () noexcept
 {
@@ -153,6 +153,7 @@ private:
 	void xmlComment (Xml::Parser* parser, IdStringPtr comment) override;
 	
 	CView* createViewFromNode (UINode* node) const;
+	void prepareViewCreation (UINode* templateNode) const;
 	UINode* getBaseNode (UTF8StringPtr name) const;
 	UINode* findChildNodeByNameAttribute (UINode* node, UTF8StringPtr nameAttribute) const;
 	UINode* findNodeForView (CView* view) const;
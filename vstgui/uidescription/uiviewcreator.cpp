@@ -446,6 +446,24 @@ bool stringToColor (const std::string* value, CColor& color, const IUIDescriptio
 	return value ? desc->getColor (value->c_str (), color) : false;
 }
 
+//-----------------------------------------------------------------------------
+bool getColorAttribute (const UIAttributes& attributes, const std::string& name, CColor& color, const IUIDescription* desc)
+{
+	const auto* value = attributes.getAttributeValue (name);
+	if (!value)
+		return false;
+	// literals come from the typed cache, but named colors take precedence over literals like in
+	// UIDescription::getColor, so a color named like the literal still wins
+	if (auto uiDesc = dynamic_cast<const UIDescription*> (desc))
+	{
+		if (attributes.getColorAttribute (name, color) && !uiDesc->hasColorName (value->data ()))
+			return true;
+	}
+	if (stringToColor (value, color, desc))
+		return true;
+	return attributes.getColorAttribute (name, color);
+}
+
 //-----------------------------------------------------------------------------
 bool stringToBitmap (const std::string* value, CBitmap*& bitmap, const IUIDescription* desc)
 {
@@ -793,7 +811,7 @@ public:
 		if (viewContainer == nullptr)
 			return false;
 		CColor backColor;
-		if (stringToColor (attributes.getAttributeValue (kAttrBackgroundColor), backColor, description))
+		if (getColorAttribute (attributes, kAttrBackgroundColor, backColor, description))
 			viewContainer->setBackgroundColor (backColor);
 		const std::string* attr = attributes.getAttributeValue (kAttrBackgroundColorDrawStyle);
 		if (attr)
@@ -927,12 +945,9 @@ public:
 		const std::string* attr = attributes.getAttributeValue (kAttrRowStyle);
 		if (attr)
 			rcv->setStyle (*attr == strTrue ? CRowColumnView::kRowStyle : CRowColumnView::kColumnStyle);
-		attr = attributes.getAttributeValue (kAttrSpacing);
-		if (attr)
-		{
-			CCoord spacing = UTF8StringView (attr->c_str ()).toDouble ();
+		CCoord spacing;
+		if (attributes.getDoubleAttribute (kAttrSpacing, spacing))
 			rcv->setSpacing (spacing);
-		}
 		CRect margin;
 		if (attributes.getRectAttribute (kAttrMargin, margin))
 			rcv->setMargin (margin);
@@ -954,12 +969,9 @@ public:
 			else
 				rcv->setLayoutStyle (CRowColumnView::kLeftTopEqualy);
 		}
-		attr = attributes.getAttributeValue (kAttrViewResizeAnimationTime);
-		if (attr)
-		{
-			uint32_t time = (uint32_t)strtol (attr->c_str(), nullptr, 10);
-			rcv->setViewResizeAnimationTime (time);
-		}
+		int32_t time;
+		if (attributes.getIntegerAttribute (kAttrViewResizeAnimationTime, time))
+			rcv->setViewResizeAnimationTime ((uint32_t)time);
 		return true;
 	}
 	bool getAttributeNames (std::list<std::string>& attributeNames) const override
@@ -1096,17 +1108,17 @@ public:
 		CColor color;
 		CScrollbar* vscrollbar = scrollView->getVerticalScrollbar ();
 		CScrollbar* hscrollbar = scrollView->getHorizontalScrollbar ();
-		if (stringToColor (attributes.getAttributeValue (kAttrScrollbarBackgroundColor), color, description))
+		if (getColorAttribute (attributes, kAttrScrollbarBackgroundColor, color, description))
 		{
 			if (vscrollbar) vscrollbar->setBackgroundColor (color);
 			if (hscrollbar) hscrollbar->setBackgroundColor (color);
 		}
-		if (stringToColor (attributes.getAttributeValue (kAttrScrollbarFrameColor), color, description))
+		if (getColorAttribute (attributes, kAttrScrollbarFrameColor, color, description))
 		{
 			if (vscrollbar) vscrollbar->setFrameColor (color);
 			if (hscrollbar) hscrollbar->setFrameColor (color);
 		}
-		if (stringToColor (attributes.getAttributeValue (kAttrScrollbarScrollerColor), color, description))
+		if (getColorAttribute (attributes, kAttrScrollbarScrollerColor, color, description))
 		{
 			if (vscrollbar) vscrollbar->setScrollerColor (color);
 			if (hscrollbar) hscrollbar->setScrollerColor (color);
@@ -1393,16 +1405,16 @@ public:
 		}
 
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (kAttrFontColor), color, description))
+		if (getColorAttribute (attributes, kAttrFontColor, color, description))
 			checkbox->setFontColor (color);
 
-		if (stringToColor (attributes.getAttributeValue (kAttrBoxframeColor), color, description))
+		if (getColorAttribute (attributes, kAttrBoxframeColor, color, description))
 			checkbox->setBoxFrameColor (color);
 
-		if (stringToColor (attributes.getAttributeValue (kAttrBoxfillColor), color, description))
+		if (getColorAttribute (attributes, kAttrBoxfillColor, color, description))
 			checkbox->setBoxFillColor (color);
 
-		if (stringToColor (attributes.getAttributeValue (kAttrCheckmarkColor), color, description))
+		if (getColorAttribute (attributes, kAttrCheckmarkColor, color, description))
 			checkbox->setCheckMarkColor (color);
 
 		int32_t style = checkbox->getStyle ();
@@ -1555,13 +1567,13 @@ public:
 		}
 
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (kAttrFontColor), color, description))
+		if (getColorAttribute (attributes, kAttrFontColor, color, description))
 			display->setFontColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrBackColor), color, description))
+		if (getColorAttribute (attributes, kAttrBackColor, color, description))
 			display->setBackColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrFrameColor), color, description))
+		if (getColorAttribute (attributes, kAttrFrameColor, color, description))
 			display->setFrameColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrShadowColor), color, description))
+		if (getColorAttribute (attributes, kAttrShadowColor, color, description))
 			display->setShadowColor (color);
 
 		CPoint p;
@@ -1603,12 +1615,9 @@ public:
 		applyStyleMask (attributes.getAttributeValue (kAttrStyleRoundRect), CParamDisplay::kRoundRectStyle, style);
 		display->setStyle (style);
 
-		const std::string* precisionAttr = attributes.getAttributeValue (kAttrValuePrecision);
-		if (precisionAttr)
-		{
-			uint8_t precision = (uint8_t)strtol (precisionAttr->c_str (), nullptr, 10);
-			display->setPrecision (precision);
-		}
+		int32_t precision;
+		if (attributes.getIntegerAttribute (kAttrValuePrecision, precision))
+			display->setPrecision ((uint8_t)precision);
 
 		return true;
 	}
@@ -2203,13 +2212,13 @@ public:
 		}
 
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (kAttrTextColor), color, description))
+		if (getColorAttribute (attributes, kAttrTextColor, color, description))
 			button->setTextColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrTextColorHighlighted), color, description))
+		if (getColorAttribute (attributes, kAttrTextColorHighlighted, color, description))
 			button->setTextColorHighlighted (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrFrameColor), color, description))
+		if (getColorAttribute (attributes, kAttrFrameColor, color, description))
 			button->setFrameColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrFrameColorHighlighted), color, description))
+		if (getColorAttribute (attributes, kAttrFrameColorHighlighted, color, description))
 			button->setFrameColorHighlighted (color);
 
 		double d;
@@ -2263,13 +2272,13 @@ public:
 		{
 			bool hasOldGradient = true;
 			CColor startColor, highlightedStartColor, endColor, highlightedEndColor;
-			if (!stringToColor (attributes.getAttributeValue (kAttrGradientStartColor), startColor, description))
+			if (!getColorAttribute (attributes, kAttrGradientStartColor, startColor, description))
 				hasOldGradient = false;
-			if (hasOldGradient && !stringToColor (attributes.getAttributeValue (kAttrGradientStartColorHighlighted), highlightedStartColor, description))
+			if (hasOldGradient && !getColorAttribute (attributes, kAttrGradientStartColorHighlighted, highlightedStartColor, description))
 				hasOldGradient = false;
-			if (hasOldGradient && !stringToColor (attributes.getAttributeValue (kAttrGradientEndColor), endColor, description))
+			if (hasOldGradient && !getColorAttribute (attributes, kAttrGradientEndColor, endColor, description))
 				hasOldGradient = false;
-			if (hasOldGradient && !stringToColor (attributes.getAttributeValue (kAttrGradientEndColorHighlighted), highlightedEndColor, description))
+			if (hasOldGradient && !getColorAttribute (attributes, kAttrGradientEndColorHighlighted, highlightedEndColor, description))
 				hasOldGradient = false;
 			if (hasOldGradient)
 			{
@@ -2512,11 +2521,11 @@ public:
 			button->setStyle (*attr == strHorizontal ? CSegmentButton::Style::kHorizontal : CSegmentButton::Style::kVertical);
 
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (kAttrTextColor), color, description))
+		if (getColorAttribute (attributes, kAttrTextColor, color, description))
 			button->setTextColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrTextColorHighlighted), color, description))
+		if (getColorAttribute (attributes, kAttrTextColorHighlighted, color, description))
 			button->setTextColorHighlighted (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrFrameColor), color, description))
+		if (getColorAttribute (attributes, kAttrFrameColor, color, description))
 			button->setFrameColor (color);
 
 		double d;
@@ -2786,11 +2795,11 @@ public:
 			knob->setCoronaOutlineWidthAdd (d);
 
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (kAttrCoronaColor), color, description))
+		if (getColorAttribute (attributes, kAttrCoronaColor, color, description))
 			knob->setCoronaColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrHandleShadowColor), color, description))
+		if (getColorAttribute (attributes, kAttrHandleShadowColor, color, description))
 			knob->setColorShadowHandle (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrHandleColor), color, description))
+		if (getColorAttribute (attributes, kAttrHandleColor, color, description))
 			knob->setColorHandle (color);
 
 		CBitmap* bitmap;
@@ -3325,11 +3334,11 @@ public:
 			slider->setFrameWidth (lineWidth);
 
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (kAttrDrawFrameColor), color, description))
+		if (getColorAttribute (attributes, kAttrDrawFrameColor, color, description))
 			slider->setFrameColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrDrawBackColor), color, description))
+		if (getColorAttribute (attributes, kAttrDrawBackColor, color, description))
 			slider->setBackColor (color);
-		if (stringToColor (attributes.getAttributeValue (kAttrDrawValueColor), color, description))
+		if (getColorAttribute (attributes, kAttrDrawValueColor, color, description))
 			slider->setValueColor (color);
 		return true;
 	}
@@ -4177,7 +4186,7 @@ public:
 		if (gv == nullptr)
 			return false;
 		CColor color;
-		if (stringToColor (attributes.getAttributeValue (kAttrFrameColor), color, description))
+		if (getColorAttribute (attributes, kAttrFrameColor, color, description))
 			gv->setFrameColor (color);
 
 		double d;
@@ -4216,9 +4225,9 @@ public:
 		{ // support old version
 			bool hasOldGradient = true;
 			CColor startColor, endColor;
-			if (!stringToColor (attributes.getAttributeValue (kAttrGradientStartColor), startColor, description))
+			if (!getColorAttribute (attributes, kAttrGradientStartColor, startColor, description))
 				hasOldGradient = false;
-			if (hasOldGradient && !stringToColor (attributes.getAttributeValue (kAttrGradientEndColor), endColor, description))
+			if (hasOldGradient && !getColorAttribute (attributes, kAttrGradientEndColor, endColor, description))
 				hasOldGradient = false;
 			double startOffset = 0.0, endOffset = 1.0;
 			if (hasOldGradient && !attributes.getDoubleAttribute (kAttrGradientStartColorOffset, startOffset))
@@ -12,6 +12,7 @@
 
 namespace VSTGUI {
 class IUIDescription;
+class UIAttributes;
 
 namespace UIViewCreator {
 
@@ -21,6 +22,7 @@ extern bool bitmapToString (CBitmap* bitmap, std::string& string, const IUIDescr
 extern bool colorToString (const CColor& color, std::string& string, const IUIDescription* desc);
 extern bool stringToColor (const std::string* value, CColor& color, const IUIDescription* desc);
 extern bool stringToBitmap (const std::string* value, CBitmap*& bitmap, const IUIDescription* desc);
+extern bool getColorAttribute (const UIAttributes& attributes, const std::string& name, CColor& color, const IUIDescription* desc);
 
 } } // namespaces
 
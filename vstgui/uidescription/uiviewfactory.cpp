@@ -229,6 +229,20 @@ IdStringPtr UIViewFactory::getViewName (CView* view) const
 	return viewName;
 }
 
+//-----------------------------------------------------------------------------
+IViewCreator::AttrType UIViewFactory::getAttributeType (const std::string& viewClassName,
+                                                        const std::string& attributeName) const
+{
+	auto& registry = getCreatorRegistry ();
+	auto type = IViewCreator::kUnknownType;
+	auto iter = registry.find (viewClassName.c_str ());
+	while (iter != registry.end () && (type = (*iter).second->getAttributeType (attributeName)) == IViewCreator::kUnknownType && (*iter).second->getBaseViewName ())
+	{
+		iter = registry.find ((*iter).second->getBaseViewName ());
+	}
+	return type;
+}
+
 //-----------------------------------------------------------------------------
 void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
 {
@@ -259,7 +273,7 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 					break;
 			}
 		#endif
-			evaluatedAttributes.setAttribute (attr.first, value);
+			evaluatedAttributes.setAttributeValue (attr.first, attr.second);
 		}
 	}
 }
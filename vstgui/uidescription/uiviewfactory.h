@@ -28,6 +28,10 @@ public:
 	bool applyCustomViewAttributeValues (CView* customView, IdStringPtr baseViewName, const UIAttributes& attributes, const IUIDescription* desc) const override;
 	
 	IdStringPtr getViewName (CView* view) const;
+	/** type of an attribute of the registered view class, does not need a view and can be called
+	 *	from worker threads as long as no view creators are (un)registered at the same time */
+	IViewCreator::AttrType getAttributeType (const std::string& viewClassName,
+	                                         const std::string& attributeName) const;
 
 	static void registerViewCreator (const IViewCreator& viewCreator);
 	static void unregisterViewCreator (const IViewCreator& viewCreator);
@@ -2,6 +2,7 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "lib/casyncbitmapview.cpp"
 #include "lib/cbitmap.cpp"
 #include "lib/cbitmapfilter.cpp"
 #include "lib/ccolor.cpp"
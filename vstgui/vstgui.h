@@ -6,6 +6,7 @@
 #define __vstgui__
 
 #include "lib/vstguibase.h"
+#include "lib/casyncbitmapview.h"
 #include "lib/cbitmap.h"
 #include "lib/cbitmapfilter.h"
 #include "lib/cbuttonstate.h"
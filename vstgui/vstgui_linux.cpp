@@ -7,7 +7,10 @@
 #include "lib/platform/linux/x11timer.cpp"
 
 #include "lib/platform/linux/cairobitmap.cpp"
+#include "lib/platform/linux/cairobitmapcache.cpp"
 #include "lib/platform/linux/cairocontext.cpp"
 #include "lib/platform/linux/cairofont.cpp"
 #include "lib/platform/linux/cairogradient.cpp"
+#include "lib/platform/linux/cairopngcodec.cpp"
 #include "lib/platform/linux/cairopath.cpp"
+#include "lib/platform/linux/cairopixelbufferpool.cpp"